@@ -1,6 +1,14 @@
 #pragma once
 
 namespace SynthConstants {
+    // ESP32-S3 task placement: MIDI I/O and the clock on core 0, LVGL and
+    // the UI (the Arduino loop task) on core 1, so a long redraw can never
+    // hold up a clock pulse
+    namespace Core {
+        inline constexpr int MIDI = 0;
+        inline constexpr int UI = 1;
+    }
+
     // Screen
     inline constexpr int ESP32_SCREEN_WIDTH = 480;
     inline constexpr int ESP32_SCREEN_HEIGHT = 320;
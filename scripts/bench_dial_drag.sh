@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# UI frame time while a dial is dragged, from the headless display and the
+# frame profiler
+# Usage: ./scripts/bench_dial_drag.sh [PROGRAM]
+#
+# Builds env:desktop (unless PROGRAM is given), runs it headless with
+# scripts/headless/dial_drag.txt and summarises the profiled frames. The
+# first full-screen frames are left out, so the figures cover the drag.
+#
+# Before/after a logging change, run it on both builds, e.g. with every
+# hot-path trace compiled in:
+#   PLATFORMIO_BUILD_FLAGS="-DLOG_LEVEL=5" pio run -e desktop
+#   ./scripts/bench_dial_drag.sh .pio/build/desktop/program
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_DIR="$(dirname "$SCRIPT_DIR")"
+PROGRAM="${1:-}"
+CSV="$(mktemp --suffix=.csv)"
+trap 'rm -f "$CSV"' EXIT
+
+cd "$PROJECT_DIR"
+if [ -z "$PROGRAM" ]; then
+    pio run -e desktop
+    PROGRAM=".pio/build/desktop/program"
+fi
+
+"$PROGRAM" --headless --script scripts/headless/dial_drag.txt --profile-csv "$CSV" > /dev/null
+
+# time_ms,tab,frame_us,render_us,flush_us,dirty_px,flush_count,object_count
+awk -F, 'NR > 1 && $6 < 480 * 320 { print $3, $4, $5, $6 }' "$CSV" | sort -n | awk '
+    { n++; frame[n] = $1; sum += $1; render += $2; flush += $3; dirty += $4 }
+    END {
+        if (n == 0) { print "No drag frames profiled - is the dial where the script expects it?"; exit 1 }
+        p95 = int(n * 0.95 + 0.5); if (p95 < 1) p95 = 1
+        printf "=== Dial drag: %d frames ===\n", n
+        printf "  frame us:  mean %.0f  p50 %d  p95 %d  max %d\n", sum / n, frame[int((n + 1) / 2)], frame[p95], frame[n]
+        printf "  render us mean %.0f   flush us mean %.0f   dirty px mean %.0f\n", render / n, flush / n, dirty / n
+    }'
@@ -0,0 +1,168 @@
+"""
+Compile the synth definitions in src/config/*.json into data/synthdefs.bin.
+
+The ESP32 build embeds the result in flash (board_build.embed_files) and
+SynthDefinitionBlob reads it in place, so nothing is parsed at boot. The
+format is documented in src/components/parameter/SynthDefinitionBlob.h;
+keep this script, SynthDefinitionBlob::Builder and VERSION in step.
+
+Field defaults, clamping and skipped parameters (no "cc" or "nrpn") follow
+SynthDefinitionReader, so the blob loads the same parameters as the JSON
+file does on desktop.
+
+Runs as a PlatformIO pre-script, or standalone:
+    python3 scripts/build_synth_definitions.py [output]
+"""
+import json
+import os
+import struct
+import sys
+from pathlib import Path
+
+# Try to import PlatformIO environment, but don't fail if not available
+try:
+    Import("env")
+    PLATFORMIO_ENV = True
+except:
+    PLATFORMIO_ENV = False
+
+MAGIC = 0x444E5953  # "SYND"
+VERSION = 1
+FLAG_BIPOLAR = 0x01
+FLAG_HIGH_RESOLUTION = 0x02
+NO_CC = 0xFF
+NO_NRPN = 0xFFFF
+MAX_VALUE_14BIT = 16383
+
+HEADER = struct.Struct("<IHHII")            # 16 bytes
+SYNTH_RECORD = struct.Struct("<IIIIIIB3x")  # 28 bytes
+PARAMETER_RECORD = struct.Struct("<IIIHHHHBBBB")  # 24 bytes
+
+# ParameterCategory values (Parameter.h), as ParameterUtils::stringToCategory maps them
+CATEGORIES = {
+    "System": 0, "Voice": 1, "Oscillators": 2, "Mixer": 3, "Filters": 4,
+    "Envelopes": 5, "LFOs": 6, "Mutators": 7, "Macros": 8, "Arpeggiator": 9,
+    "Effects": 10, "Amplitude": 11, "Amp": 11,
+}
+CATEGORY_UNKNOWN = 12
+
+PROJECT_DIR = Path(os.getcwd())
+CONFIG_DIR = PROJECT_DIR / "src" / "config"
+OUTPUT_PATH = PROJECT_DIR / "data" / "synthdefs.bin"
+
+
+class StringTable:
+    """Each distinct string once, NUL-terminated; "" is reference 0"""
+
+    def __init__(self):
+        self.data = bytearray()
+        self.ids = {}
+        self.add("")
+
+    def add(self, text):
+        if text not in self.ids:
+            self.ids[text] = len(self.data)
+            self.data += text.encode("utf-8") + b"\0"
+        return self.ids[text]
+
+
+def number(obj, key, default, maximum):
+    """obj[key] clamped to 0..maximum; default if missing or not a number"""
+    value = obj.get(key)
+    if isinstance(value, bool) or not isinstance(value, (int, float)):
+        return default
+    if not value > 0:
+        return 0
+    return maximum if value >= maximum else int(value)
+
+
+def to_string(value):
+    return value if isinstance(value, str) else ""
+
+
+def compile_parameter(key, param, category, strings):
+    """Packed record, or None (with a warning) for a parameter with no MIDI address"""
+    name = param.get("name")
+    name = name if isinstance(name, str) else key.replace("_", " ")
+    short_name = param.get("short_name")
+    short_name = short_name if isinstance(short_name, str) else name
+
+    cc = number(param, "cc", NO_CC, 127)
+    minimum = number(param, "min", 0, MAX_VALUE_14BIT)
+    maximum = number(param, "max", 127, MAX_VALUE_14BIT)
+    if minimum > maximum:
+        minimum, maximum = maximum, minimum
+    default = min(max(number(param, "default", 64, MAX_VALUE_14BIT), minimum), maximum)
+    nrpn = number(param, "nrpn", NO_NRPN, MAX_VALUE_14BIT)
+    channel = number(param, "channel", 0, 16)
+    if cc == NO_CC and nrpn == NO_NRPN:
+        print(f"⚠️  Skipping '{key}': no \"cc\" or \"nrpn\"")
+        return None
+
+    flags = 0
+    if param.get("bipolar") is True:
+        flags |= FLAG_BIPOLAR
+    if param.get("high_resolution") is True:
+        flags |= FLAG_HIGH_RESOLUTION
+
+    return PARAMETER_RECORD.pack(
+        strings.add(name), strings.add(short_name), strings.add(to_string(param.get("description"))),
+        minimum, maximum, default, nrpn, cc, category, channel, flags)
+
+
+def compile_definitions(paths):
+    strings = StringTable()
+    synths = []
+    parameters = []
+
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            definition = json.load(f)
+        if not isinstance(definition, dict):
+            raise ValueError(f"{path}: not a synth definition (expected an object)")
+
+        first_parameter = len(parameters)
+        categories = definition.get("categories")
+        for category_name, category in (categories.items() if isinstance(categories, dict) else []):
+            if not isinstance(category, dict) or not isinstance(category.get("parameters"), dict):
+                continue
+            category_id = CATEGORIES.get(category_name, CATEGORY_UNKNOWN)
+            for key, param in category["parameters"].items():
+                record = compile_parameter(key, param, category_id, strings) if isinstance(param, dict) else None
+                if record:
+                    parameters.append(record)
+
+        synths.append(SYNTH_RECORD.pack(
+            strings.add(path.stem),
+            strings.add(to_string(definition.get("name"))),
+            strings.add(to_string(definition.get("manufacturer"))),
+            strings.add(to_string(definition.get("description"))),
+            first_parameter,
+            len(parameters) - first_parameter,
+            number(definition, "midi_channel", 0, 16)))
+
+    strings_offset = HEADER.size + len(synths) * SYNTH_RECORD.size + len(parameters) * PARAMETER_RECORD.size
+    header = HEADER.pack(MAGIC, VERSION, len(synths), len(parameters), strings_offset)
+    return header + b"".join(synths) + b"".join(parameters) + bytes(strings.data)
+
+
+def main(output_path=OUTPUT_PATH):
+    paths = sorted(CONFIG_DIR.glob("*.json"))  # Skips *.json.backup
+    blob = compile_definitions(paths)
+
+    output_path = Path(output_path)
+    if output_path.exists() and output_path.read_bytes() == blob:
+        print(f"✅ Synth definitions up to date ({output_path}, {len(blob)} bytes)")
+        return
+
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    output_path.write_bytes(blob)
+    print(f"✅ Compiled {len(paths)} synth definition(s) into {output_path} ({len(blob)} bytes)")
+
+
+if __name__ == "__main__":
+    main(sys.argv[1] if len(sys.argv) > 1 else OUTPUT_PATH)
+elif PLATFORMIO_ENV:
+    # Called from PlatformIO - the blob must exist before embed_files is resolved
+    print("🔧 PlatformIO pre-build: Compiling synth definitions...")
+    main()
@@ -5,6 +5,7 @@
 
 
 #include "../../include/FontConfig.h"
+#include "components/log/Log.h"
 
 // Static map to link LVGL objects back to C++ instances
 static std::unordered_map<lv_obj_t*, MidiDial*> dial_widget_map;
@@ -103,7 +104,7 @@ void MidiDial::setValue(int value) {
             value_callback_(value);
         }
         
-        std::cout << "MIDI Dial value changed to: " << value << std::endl;
+        LOG_TRACE("MidiDial", "Value changed to: %d", value);
     }
 }
 
@@ -161,7 +162,7 @@ void MidiDial::click_event_cb(lv_event_t* e) {
         }
         dial->setValue(new_value);
         
-        std::cout << "MIDI Dial clicked! New value: " << new_value << std::endl;
+        LOG_DEBUG("MidiDial", "Clicked, new value: %d", new_value);
     }
 }
 
@@ -186,6 +187,6 @@ void MidiDial::arc_event_cb(lv_event_t* e) {
             dial->value_callback_(new_value);
         }
         
-        std::cout << "MIDI Dial dragged! New value: " << new_value << std::endl;
+        LOG_TRACE("MidiDial", "Dragged, new value: %d", new_value);
     }
 }
@@ -0,0 +1,152 @@
+#include "LoopScheduler.h"
+#include "components/midi/MidiTime.h"
+#include "components/log/Log.h"
+#include <algorithm>
+
+#if !defined(ESP32_BUILD)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr uint64_t WINDOW_US = 1000000;
+    constexpr uint64_t LOG_INTERVAL_US = 10000000;
+
+    const char* const SOURCE_NAMES[] = {"timer", "midi", "clock", "touch", "other"};
+}
+
+LoopScheduler& LoopScheduler::getInstance() {
+    static LoopScheduler instance;
+    return instance;
+}
+
+LoopScheduler::LoopScheduler() {
+#if !defined(ESP32_BUILD)
+    event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (event_fd_ < 0) {
+        LOG_WARN("LoopScheduler", "eventfd unavailable, loop will only wake on timers");
+    }
+#endif
+    start_us_ = MidiTime::nowUs();
+    window_start_us_ = start_us_;
+    last_log_us_ = start_us_;
+}
+
+LoopScheduler::~LoopScheduler() {
+#if !defined(ESP32_BUILD)
+    if (event_fd_ >= 0) {
+        close(event_fd_);
+    }
+#endif
+}
+
+void LoopScheduler::wake(Source source) {
+    if (pending_.fetch_or(bit(source), std::memory_order_acq_rel) != 0) return;
+
+#if defined(ESP32_BUILD)
+    TaskHandle_t task = ui_task_.load(std::memory_order_acquire);
+    if (task) {
+        xTaskNotifyGive(task);
+    }
+#else
+    if (event_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(event_fd_, &one, sizeof(one));
+        (void)written;
+    }
+#endif
+}
+
+#if defined(ESP32_BUILD)
+void LoopScheduler::wakeFromIsr(Source source) {
+    if (pending_.fetch_or(bit(source), std::memory_order_acq_rel) != 0) return;
+
+    TaskHandle_t task = ui_task_.load(std::memory_order_acquire);
+    if (task) {
+        BaseType_t higher_priority_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &higher_priority_woken);
+        portYIELD_FROM_ISR(higher_priority_woken);
+    }
+}
+#endif
+
+void LoopScheduler::clearSignal() {
+#if defined(ESP32_BUILD)
+    ulTaskNotifyTake(pdTRUE, 0);
+#else
+    if (event_fd_ >= 0) {
+        uint64_t count;
+        ssize_t got = read(event_fd_, &count, sizeof(count));
+        (void)got;
+    }
+#endif
+}
+
+uint32_t LoopScheduler::sleep(uint32_t timeout_ms) {
+    uint64_t before = MidiTime::nowUs();
+    timeout_ms = std::min(timeout_ms, MAX_SLEEP_MS);
+
+#if defined(ESP32_BUILD)
+    if (!ui_task_.load(std::memory_order_relaxed)) {
+        ui_task_.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    }
+#endif
+
+    if (pending_.load(std::memory_order_acquire) == 0 && timeout_ms > 0) {
+#if defined(ESP32_BUILD)
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+#else
+        if (event_fd_ >= 0) {
+            pollfd pfd{event_fd_, POLLIN, 0};
+            poll(&pfd, 1, static_cast<int>(timeout_ms));
+        } else {
+            usleep(timeout_ms * 1000);
+        }
+#endif
+    }
+    // Consume the signal of any wake that raced with the check above
+    clearSignal();
+
+    uint32_t woken_by = pending_.exchange(0, std::memory_order_acq_rel);
+
+    uint64_t now = MidiTime::nowUs();
+    uint64_t idle = now - before;
+    stats_.sleeps++;
+    stats_.idle_us += idle;
+    stats_.total_us = now - start_us_;
+    window_idle_us_ += idle;
+
+    if (woken_by == 0) {
+        stats_.wakeups[static_cast<int>(Source::TIMER)]++;
+    }
+    for (int i = 0; i < SOURCE_COUNT; ++i) {
+        if (woken_by & (1u << i)) stats_.wakeups[i]++;
+    }
+
+    if (now - window_start_us_ >= WINDOW_US) {
+        stats_.recent_idle_percent = 100.0f * window_idle_us_ / (now - window_start_us_);
+        window_start_us_ = now;
+        window_idle_us_ = 0;
+    }
+    if (now - last_log_us_ >= LOG_INTERVAL_US) {
+        last_log_us_ = now;
+        logStats();
+    }
+    return woken_by;
+}
+
+LoopScheduler::Stats LoopScheduler::getStats() const {
+    Stats stats = stats_;
+    stats.idle_percent = stats.total_us ? 100.0f * stats.idle_us / stats.total_us : 0.0f;
+    return stats;
+}
+
+void LoopScheduler::logStats() const {
+    Stats stats = getStats();
+    LOG_INFO("LoopScheduler", "idle %.1f%% (last second %.1f%%), %u sleeps; woken by %s %u, %s %u, %s %u, %s %u, %s %u",
+             stats.idle_percent, stats.recent_idle_percent, stats.sleeps,
+             SOURCE_NAMES[0], stats.wakeups[0], SOURCE_NAMES[1], stats.wakeups[1],
+             SOURCE_NAMES[2], stats.wakeups[2], SOURCE_NAMES[3], stats.wakeups[3],
+             SOURCE_NAMES[4], stats.wakeups[4]);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(ESP32_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+/**
+ * @brief Lets the UI loop sleep until it actually has work
+ *
+ * The loop asks LVGL how long until its next timer and sleeps at most that
+ * long; other threads cut the sleep short with wake() when they hand the UI
+ * something to do (MIDI input queued, clock ticks to display, a touch).
+ *
+ * Desktop: poll() on an eventfd. ESP32: FreeRTOS task notification to the
+ * loop task (wakeFromIsr() for interrupt handlers).
+ *
+ * A wake only costs a syscall / notify when the flag for that source was not
+ * already pending, so a burst of MIDI input wakes the loop once.
+ */
+class LoopScheduler {
+public:
+    enum class Source : uint8_t {
+        TIMER,        // Sleep ran to its deadline
+        MIDI_INPUT,
+        CLOCK,
+        TOUCH,
+        OTHER,
+        COUNT
+    };
+    static constexpr int SOURCE_COUNT = static_cast<int>(Source::COUNT);
+
+    // Upper bound for one sleep (LVGL returns LV_NO_TIMER_READY when idle)
+    static constexpr uint32_t MAX_SLEEP_MS = 50;
+
+    static constexpr uint32_t bit(Source source) { return 1u << static_cast<uint32_t>(source); }
+
+    struct Stats {
+        uint32_t sleeps = 0;
+        uint32_t wakeups[SOURCE_COUNT] = {};
+        uint64_t idle_us = 0;
+        uint64_t total_us = 0;
+        float idle_percent = 0.0f;         // Whole run
+        float recent_idle_percent = 0.0f;  // Last complete second
+    };
+
+    static LoopScheduler& getInstance();
+
+    // Any thread / task
+    void wake(Source source);
+#if defined(ESP32_BUILD)
+    void wakeFromIsr(Source source);
+#endif
+
+    // UI thread: sleep up to timeout_ms (at most MAX_SLEEP_MS) unless woken. Returns the bits of the
+    // sources that woke it (0 = timed out).
+    uint32_t sleep(uint32_t timeout_ms);
+
+    // UI thread
+    Stats getStats() const;
+    void logStats() const;
+
+private:
+    LoopScheduler();
+    ~LoopScheduler();
+    LoopScheduler(const LoopScheduler&) = delete;
+    LoopScheduler& operator=(const LoopScheduler&) = delete;
+
+    void clearSignal();
+
+    std::atomic<uint32_t> pending_{0};   // Source bits set since the last sleep()
+
+#if defined(ESP32_BUILD)
+    std::atomic<TaskHandle_t> ui_task_{nullptr};
+#else
+    int event_fd_ = -1;
+#endif
+
+    // UI thread only
+    Stats stats_;
+    uint64_t start_us_ = 0;
+    uint64_t window_start_us_ = 0;
+    uint64_t window_idle_us_ = 0;
+    uint64_t last_log_us_ = 0;
+};
@@ -2,6 +2,7 @@
 #include "components/layout/LayoutManager.h"
 #include "components/parameter/ParameterBinder.h"
 #include "components/parameter/CommandManager.h"
+#include "components/parameter/ParameterStore.h"
 #include "components/ui/MainControlTab.h"
 #include "components/ui/HelloTab.h"
 #include "components/ui/WorldTab.h"
@@ -9,12 +10,12 @@
 #include "components/ui/ClockTab.h"
 #include "components/midi/MidiClockManager.h"
 #include "components/midi/UnifiedMidiManager.h"
+#include "components/profiling/FrameProfiler.h"
+#include "LoopScheduler.h"
+#include "UiThread.h"
 #include "FontConfig.h"
 #include "Constants.h"
 #include <iostream>
-#if !defined(ESP32_BUILD)
-#include <unistd.h>  // For usleep on desktop
-#endif
 
 #if defined(ESP32_BUILD)
 #include "hardware/LGFX_ST7796S.h"
@@ -57,9 +58,13 @@ SynthApp::~SynthApp() {
     std::cout << "SynthApp destructor called" << std::endl;
 }
 
-void SynthApp::setup() {
+bool SynthApp::setup() {
     std::cout << "=== LVGL Synth GUI Starting ===" << std::endl;
     
+    // Everything touching LVGL or parameters stays on this thread; the MIDI
+    // and clock threads started below talk to it through queues
+    UiThread::bind();
+    
     // Initialize parameter system
     parameter_binder_ = std::make_unique<ParameterBinder>();
     command_manager_ = std::make_unique<CommandManager>();
@@ -83,14 +88,19 @@ void SynthApp::setup() {
         // MainControlTab handles UI updates
     });
     
-    initHardware();
+    if (!initHardware()) {
+        std::cout << "Hardware initialization failed!" << std::endl;
+        return false;
+    }
+    FrameProfiler::getInstance().attach(lv_display_get_default());
     initWindowManager();
     
     initialized_ = true;
     std::cout << "Synth GUI initialized successfully!" << std::endl;
+    return true;
 }
 
-void SynthApp::initHardware() {
+bool SynthApp::initHardware() {
     #if defined(ESP32_BUILD)
         // Initialize LVGL
         lv_init();
@@ -116,7 +126,9 @@ void SynthApp::initHardware() {
         
     #else
         // Desktop initialization
-        initDesktop();
+        if (!initDesktop()) {
+            return false;
+        }
         
         // Initialize unified MIDI system for desktop with shared MidiHandler
         std::cout << "[SynthApp] Desktop - About to share MidiHandler at " << midi_handler_.get() << std::endl;
@@ -128,32 +140,51 @@ void SynthApp::initHardware() {
         UnifiedMidiManager::getInstance().initialize();
     #endif
     
+    UnifiedMidiManager::getInstance().setMidiMessageCallback(
+        [this](uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestamp_us) {
+            onMidiInput(status, data1, data2, timestamp_us);
+        });
+    
     std::cout << "Hardware initialization complete" << std::endl;
+    return true;
 }
 
 #if !defined(ESP32_BUILD)
-void SynthApp::initDesktop() {
+bool SynthApp::initDesktop() {
     std::cout << "[Desktop] Initializing LVGL for desktop..." << std::endl;
     
     // LVGL initialization
     lv_init();
     
-    // Display setup using ESP32 screen dimensions to match hardware
-    display_ = lv_sdl_window_create(SynthConstants::ESP32_SCREEN_WIDTH, SynthConstants::ESP32_SCREEN_HEIGHT);
-    lv_sdl_window_set_title(display_, SynthConstants::Text::TITLE);
-    
-    std::cout << "[Desktop] SDL window created: " << SynthConstants::ESP32_SCREEN_WIDTH 
-              << "x" << SynthConstants::ESP32_SCREEN_HEIGHT << std::endl;
-    
-    // Input setup
-    mouse_ = lv_sdl_mouse_create();
-    keyboard_ = lv_sdl_keyboard_create();
-    mousewheel_ = lv_sdl_mousewheel_create();
+    if (headless_) {
+        // In-memory framebuffer and scripted pointer, no SDL
+        headless_display_ = std::make_unique<HeadlessDisplay>(
+            SynthConstants::ESP32_SCREEN_WIDTH, SynthConstants::ESP32_SCREEN_HEIGHT, headless_options_);
+        if (!headless_display_->initialize()) {
+            std::cout << "[Desktop] Headless display failed to initialize" << std::endl;
+            return false;
+        }
+        display_ = headless_display_->getDisplay();
+        mouse_ = headless_display_->getPointer();
+    } else {
+        // Display setup using ESP32 screen dimensions to match hardware
+        display_ = lv_sdl_window_create(SynthConstants::ESP32_SCREEN_WIDTH, SynthConstants::ESP32_SCREEN_HEIGHT);
+        lv_sdl_window_set_title(display_, SynthConstants::Text::TITLE);
+        
+        std::cout << "[Desktop] SDL window created: " << SynthConstants::ESP32_SCREEN_WIDTH 
+                  << "x" << SynthConstants::ESP32_SCREEN_HEIGHT << std::endl;
+        
+        // Input setup
+        mouse_ = lv_sdl_mouse_create();
+        keyboard_ = lv_sdl_keyboard_create();
+        mousewheel_ = lv_sdl_mousewheel_create();
+    }
     
     // Initialize layout manager for desktop environment
     LayoutManager::initialize();
     
     std::cout << "[Desktop] LVGL initialized successfully (480x320 to match ESP32)" << std::endl;
+    return true;
 }
 #endif // !defined(ESP32_BUILD)
 
@@ -218,14 +249,6 @@ void SynthApp::createTabs() {
 void SynthApp::loop() {
     if (!initialized_) return;
     
-    #if defined(ESP32_BUILD)
-        lv_timer_handler();
-        delay(5);
-    #else
-        lv_timer_handler();
-        usleep(5000);  // 5ms delay
-    #endif
-    
     // Update window manager
     if (window_manager_) {
         window_manager_->update();
@@ -236,11 +259,62 @@ void SynthApp::loop() {
     
     // Update unified MIDI manager
     UnifiedMidiManager::getInstance().update();
+    
+    // One observer notification per changed parameter, with its final value
+    ParameterStore::getInstance().flushNotifications();
+    
+    // Run LVGL after the updates so anything they invalidated is drawn this
+    // pass, then sleep until its next timer is due or another thread has
+    // work for us (MIDI input, clock ticks, touch)
+    uint32_t next_timer_ms = lv_timer_handler();
+    uint32_t woken_by = LoopScheduler::getInstance().sleep(next_timer_ms);
+    
+    #if defined(ESP32_BUILD)
+        if (woken_by & LoopScheduler::bit(LoopScheduler::Source::TOUCH)) {
+            display_driver_->onTouchWake();
+        }
+    #else
+        (void)woken_by;
+    #endif
+}
+
+void SynthApp::onMidiInput(uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestamp_us) {
+    auto& clock_manager = MidiClockManager::getInstance();
+    
+    switch (status) {
+        case 0xF8: clock_manager.handleMidiClockMessage(timestamp_us); return;
+        case 0xFA: clock_manager.handleMidiStartMessage(); return;
+        case 0xFB: clock_manager.handleMidiContinueMessage(); return;
+        case 0xFC: clock_manager.handleMidiStopMessage(); return;
+        default: break;
+    }
+    
+    if ((status & 0xF0) == 0xB0) {
+        onMidiControlChange(status & 0x0F, data1, data2);
+    }
+}
+
+void SynthApp::onMidiControlChange(uint8_t channel, uint8_t cc, uint8_t value) {
+    if (!parameter_binder_) return;
+    
+    // NRPN selection and 14-bit MSB/LSB pairs are tracked by the decoder
+    uint16_t param_value = 0;
+    Parameter* param = midi_decoder_.decode(*parameter_binder_, channel, cc, value, param_value);
+    if (!param) return;
+    
+    // The synth's front panel is the source of truth: update the model and
+    // the bound controls through setValueDirect(), which skips the undo
+    // history and notifies observers without the dial firing its
+    // value-changed event, so nothing is echoed back out.
+    param->setValueDirect(param_value);
 }
 
 // WindowObserver implementation
 void SynthApp::onTabChanged(const std::string& /* old_tab */, const std::string& new_tab) {
     std::cout << "Tab changed to: " << new_tab << std::endl;
+    
+    Tab* tab = window_manager_ ? window_manager_->getTab(new_tab) : nullptr;
+    FrameProfiler::getInstance().setActiveTab(new_tab, tab ? tab->getContainer() : nullptr);
 }
 
 // Utility methods that might be useful for debugging
@@ -294,6 +368,33 @@ bool SynthApp::isInitialized() const {
     return initialized_;
 }
 
+bool SynthApp::isFinished() const {
+    #if defined(ESP32_BUILD)
+        return false;
+    #else
+        return headless_display_ && headless_display_->isFinished();
+    #endif
+}
+
+void SynthApp::shutdown() {
+    // Stop recording/replay and the MIDI threads before the process exits
+    UnifiedMidiManager::getInstance().cleanup();
+    LoopScheduler::getInstance().logStats();
+    
+    #if !defined(ESP32_BUILD)
+        if (headless_display_) {
+            headless_display_->printReport();
+        }
+    #endif
+}
+
+#if !defined(ESP32_BUILD)
+void SynthApp::setHeadless(const HeadlessDisplay::Options& options) {
+    headless_ = true;
+    headless_options_ = options;
+}
+#endif
+
 std::shared_ptr<MidiHandler> SynthApp::getMidiHandler() const {
     return midi_handler_;
 }
@@ -5,6 +5,7 @@
 
 #include "components/parameter/ParameterBinder.h"
 #include "components/parameter/CommandManager.h"
+#include "components/parameter/ParameterMidiCodec.h"
 #include "components/ui/WindowManager.h"
 #include "components/ui/MainControlTab.h"
 #include "components/ui/HelloTab.h"
@@ -15,6 +16,8 @@
 
 #if defined(ESP32_BUILD)
 #include "hardware/ESP32Display.h"
+#else
+#include "hardware/HeadlessDisplay.h"
 #endif
 
 class SynthApp : public WindowObserver {
@@ -30,6 +33,11 @@ private:
         lv_indev_t* mouse_;
         lv_indev_t* keyboard_;
         lv_indev_t* mousewheel_;
+        
+        // Replaces the SDL window when running headless
+        bool headless_ = false;
+        HeadlessDisplay::Options headless_options_;
+        std::unique_ptr<HeadlessDisplay> headless_display_;
     #endif
     
     // Core components
@@ -49,13 +57,26 @@ private:
     std::unique_ptr<SettingsTab> settings_tab_;
     std::unique_ptr<ClockTab> clock_tab_;
     
+    // Reassembles NRPN and 14-bit CC input into parameter values
+    ParameterMidiDecoder midi_decoder_;
+    
 public:
     SynthApp();
     ~SynthApp();
     
-    void setup();
+    // False if the display could not be set up (e.g. a bad headless script)
+    bool setup();
     void loop();
     
+    // Headless runs end when their script / frame limit is done
+    bool isFinished() const;
+    void shutdown();
+    
+    #if !defined(ESP32_BUILD)
+    // Render into memory instead of an SDL window; call before setup()
+    void setHeadless(const HeadlessDisplay::Options& options);
+    #endif
+    
     // WindowObserver interface
     void onTabChanged(const std::string& old_tab, const std::string& new_tab) override;
     
@@ -69,10 +90,14 @@ public:
     
 private:
     // Initialization methods
-    void initHardware();
+    bool initHardware();
     #if !defined(ESP32_BUILD)
-    void initDesktop();
+    bool initDesktop();
     #endif
     void initWindowManager();
     void createTabs();
+    
+    // Incoming MIDI (dispatched by UnifiedMidiManager::update on the UI thread)
+    void onMidiInput(uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestamp_us);
+    void onMidiControlChange(uint8_t channel, uint8_t cc, uint8_t value);
 };
@@ -0,0 +1,56 @@
+#include "UiThread.h"
+#include "components/log/Log.h"
+#include "Constants.h"
+#include <atomic>
+
+#if defined(ESP32_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#endif
+
+namespace {
+    std::atomic<bool> bound{false};
+#if defined(ESP32_BUILD)
+    TaskHandle_t ui_task = nullptr;
+#else
+    std::thread::id ui_thread;
+#endif
+}
+
+namespace UiThread {
+
+void bind() {
+#if defined(ESP32_BUILD)
+    ui_task = xTaskGetCurrentTaskHandle();
+    LOG_INFO("UiThread", "UI task '%s' on core %d", pcTaskGetName(nullptr), xPortGetCoreID());
+    if (xPortGetCoreID() != SynthConstants::Core::UI) {
+        LOG_WARN("UiThread", "UI expected on core %d; it shares a core with the MIDI tasks",
+                 SynthConstants::Core::UI);
+    }
+#else
+    ui_thread = std::this_thread::get_id();
+#endif
+    bound.store(true, std::memory_order_release);
+}
+
+bool isCurrent() {
+    if (!bound.load(std::memory_order_acquire)) return true;
+#if defined(ESP32_BUILD)
+    return xTaskGetCurrentTaskHandle() == ui_task;
+#else
+    return std::this_thread::get_id() == ui_thread;
+#endif
+}
+
+void reportViolation(const char* function) {
+#if defined(ESP32_BUILD)
+    LOG_ERROR("UiThread", "%s called from task '%s' (core %d), not the UI task",
+              function, pcTaskGetName(nullptr), xPortGetCoreID());
+#else
+    LOG_ERROR("UiThread", "%s called off the UI thread", function);
+#endif
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+
+/**
+ * @brief The thread that owns LVGL and the parameter model
+ *
+ * LVGL, Parameter (values and observers), CommandManager and the settings
+ * observers are not thread-safe and are only used from the UI thread: the
+ * Arduino loop task on ESP32 (core 1), the main thread on desktop. Other
+ * threads exchange data with it through the SPSC queues (MIDI output via
+ * the sender threads, MIDI input via the backends' input rings) and wake it
+ * through LoopScheduler.
+ *
+ * ASSERT_UI_THREAD() at the entry points reports (once per call site) when
+ * something reaches them from another thread instead of crashing later in
+ * a data race.
+ */
+namespace UiThread {
+    // Call once from the UI thread before other threads start
+    void bind();
+
+    // True on the UI thread, and everywhere before bind()
+    bool isCurrent();
+
+    void reportViolation(const char* function);
+}
+
+#define ASSERT_UI_THREAD()                                          \
+    do {                                                            \
+        static std::atomic<bool> reported_{false};                  \
+        if (!UiThread::isCurrent() && !reported_.exchange(true)) {  \
+            UiThread::reportViolation(__func__);                    \
+        }                                                           \
+    } while (0)
@@ -75,7 +75,7 @@ void ButtonControl::bindParameter(std::shared_ptr<Parameter> parameter) {
 void ButtonControl::updateFromParameter() {
     if (!bound_parameter_) return;
     
-    uint8_t value = bound_parameter_->getCurrentValue();
+    uint16_t value = bound_parameter_->getCurrentValue();
     
     switch (mode_) {
         case ButtonMode::TOGGLE:
@@ -130,7 +130,7 @@ void ButtonControl::updateDisplayFromParameter() {
     updateFromParameter();
 }
 
-void ButtonControl::updateParameterFromControl(uint8_t value) {
+void ButtonControl::updateParameterFromControl(uint16_t value) {
     sendParameterValue(value);
 }
 
@@ -260,7 +260,7 @@ void ButtonControl::updateVisualState() {
     lv_obj_set_style_bg_color(button_, bg_color, LV_STATE_DEFAULT);
 }
 
-void ButtonControl::sendParameterValue(uint8_t value) {
+void ButtonControl::sendParameterValue(uint16_t value) {
     if (bound_parameter_) {
         // Use command system for undo/redo support
         if (mode_ == ButtonMode::TOGGLE) {
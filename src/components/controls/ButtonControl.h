@@ -56,7 +56,7 @@ public:
     
 protected:
     void updateDisplayFromParameter() override;
-    void updateParameterFromControl(uint8_t value) override;
+    void updateParameterFromControl(uint16_t value) override;
     void onParameterChanged(const Parameter& parameter) override;
     
     // Button-specific configuration
@@ -80,7 +80,7 @@ protected:
     
     void createButton(lv_obj_t* parent, int x, int y, int width, int height);
     void updateVisualState();
-    void sendParameterValue(uint8_t value);
+    void sendParameterValue(uint16_t value);
     
     // Event handlers
     static void button_event_cb(lv_event_t* e);
@@ -1,9 +1,12 @@
 #include <unordered_map>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 #include "DialControl.h"
 #include "ParameterControl.h"
 #include "FontConfig.h"
+#include "components/log/Log.h"
 #include <lvgl.h>
 
 // Static map for dial control callbacks
@@ -23,6 +26,8 @@ DialControl::DialControl(lv_obj_t* parent, int x, int y)
     , dial_diameter_(50)
     , use_custom_label_(false)
     , display_value_(0)
+    , drag_value_(0.0f)
+    , drag_moved_(false)
 {
     createWidgets(parent, x, y);
     setupStyling();
@@ -75,6 +80,8 @@ void DialControl::createWidgets(lv_obj_t* parent, int x, int y) {
     // Set up event handlers
     lv_obj_add_event_cb(container_, container_click_cb, LV_EVENT_CLICKED, this);
     lv_obj_add_event_cb(arc_display_, arc_event_cb, LV_EVENT_VALUE_CHANGED, this);
+    lv_obj_add_event_cb(container_, container_drag_cb, LV_EVENT_PRESSED, this);
+    lv_obj_add_event_cb(container_, container_drag_cb, LV_EVENT_PRESSING, this);
 }
 
 void DialControl::setupStyling() {
@@ -121,8 +128,11 @@ void DialControl::setSize(int width, int height) {
         int arc_size = std::min(width - 20, height - 30);
         lv_obj_set_size(arc_display_, arc_size, arc_size);
         lv_obj_align(arc_display_, LV_ALIGN_CENTER, 0, 8);  // Move arc down for better label spacing
-        std::cout << "[DIAL] setSize: container_=" << container_ << " size=" << width << "x" << height << ", arc_display_=" << arc_display_ << " arc_size=" << arc_size << std::endl;
-        std::cout << "[DIAL] actual container size: " << lv_obj_get_width(container_) << "x" << lv_obj_get_height(container_) << ", arc actual size: " << lv_obj_get_width(arc_display_) << "x" << lv_obj_get_height(arc_display_) << std::endl;
+        LOG_DEBUG("DIAL", "setSize: container_=%p size=%dx%d, arc_display_=%p arc_size=%d",
+                  static_cast<void*>(container_), width, height, static_cast<void*>(arc_display_), arc_size);
+        LOG_TRACE("DIAL", "actual container size: %dx%d, arc actual size: %dx%d",
+                  (int)lv_obj_get_width(container_), (int)lv_obj_get_height(container_),
+                  (int)lv_obj_get_width(arc_display_), (int)lv_obj_get_height(arc_display_));
     }
 }
 
@@ -190,25 +200,20 @@ void DialControl::updateDisplayFromParameter() {
     updateArcDisplay();
 }
 
-void DialControl::updateParameterFromControl(uint8_t value) {
-    std::cout << "updateParameterFromControl called with value: " << (int)value << std::endl;
-    std::cout << "isParameterBound: " << isParameterBound() << std::endl;
-    std::cout << "isUpdatingFromParameter: " << isUpdatingFromParameter() << std::endl;
+void DialControl::updateParameterFromControl(uint16_t value) {
+    LOG_TRACE("DIAL", "updateParameterFromControl: value=%d bound=%d updating_from_parameter=%d",
+              (int)value, (int)isParameterBound(), (int)isUpdatingFromParameter());
     
     if (!isParameterBound() || isUpdatingFromParameter()) {
-        std::cout << "Early return from updateParameterFromControl" << std::endl;
         return;
     }
     
     auto param = getBoundParameter();
-    std::cout << "Got parameter: " << param.get() << std::endl;
     param->setValue(value);
     display_value_ = value;
     
     updateLabels();
-    std::cout << "About to call notifyValueChanged..." << std::endl;
     notifyValueChanged(value);
-    std::cout << "notifyValueChanged completed" << std::endl;
 }
 
 void DialControl::onParameterBound() {
@@ -219,6 +224,18 @@ void DialControl::onParameterBound() {
         // Set arc range based on parameter
         lv_arc_set_range(arc_display_, param->getMinValue(), param->getMaxValue());
         display_value_ = param->getCurrentValue();
+        
+        // High resolution: the arc only displays, the container takes the
+        // drag and keeps it from scrolling the page
+        if (param->isHighResolution()) {
+            lv_obj_clear_flag(arc_display_, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_clear_flag(container_, LV_OBJ_FLAG_SCROLLABLE);
+            lv_obj_clear_flag(container_, LV_OBJ_FLAG_SCROLL_CHAIN);
+        } else {
+            lv_obj_add_flag(arc_display_, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_add_flag(container_, LV_OBJ_FLAG_SCROLLABLE);
+            lv_obj_add_flag(container_, LV_OBJ_FLAG_SCROLL_CHAIN);
+        }
     }
     
     updateLabels();
@@ -228,6 +245,9 @@ void DialControl::onParameterBound() {
 void DialControl::onParameterUnbound() {
     // Reset to default state
     lv_arc_set_range(arc_display_, 0, 127);
+    lv_obj_add_flag(arc_display_, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(container_, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(container_, LV_OBJ_FLAG_SCROLL_CHAIN);
     display_value_ = 0;
     updateLabels();
     updateArcDisplay();
@@ -284,22 +304,18 @@ void DialControl::updateArcDisplay() {
 
 // Static event handlers
 void DialControl::arc_event_cb(lv_event_t* e) {
-    std::cout << "*** ARC_EVENT_CB CALLED! ***" << std::endl;
     lv_obj_t* arc = static_cast<lv_obj_t*>(lv_event_get_target(e));
     
     auto it = dial_control_map_.find(arc);
-    std::cout << "Arc object: " << arc << ", found in map: " << (it != dial_control_map_.end()) << std::endl;
-    
     if (it != dial_control_map_.end()) {
         DialControl* control = it->second;
         
-        uint8_t new_value = static_cast<uint8_t>(lv_arc_get_value(arc));
-        std::cout << "About to call updateParameterFromControl with value: " << (int)new_value << std::endl;
+        uint16_t new_value = static_cast<uint16_t>(lv_arc_get_value(arc));
         control->updateParameterFromControl(new_value);
         
-        std::cout << "Dial arc changed: " << static_cast<int>(new_value) << std::endl;
+        LOG_TRACE("DIAL", "Dial arc changed: %d", static_cast<int>(new_value));
     } else {
-        std::cout << "ERROR: Arc object not found in dial_control_map_!" << std::endl;
+        LOG_ERROR("DIAL", "Arc object %p not found in dial_control_map_", static_cast<void*>(arc));
     }
 }
 
@@ -310,11 +326,59 @@ void DialControl::container_click_cb(lv_event_t* e) {
     if (it != dial_control_map_.end()) {
         DialControl* control = it->second;
         
-        // Reset to default on click
-        if (control->isParameterBound()) {
+        // Reset to default on click (not at the end of a drag)
+        if (control->isParameterBound() && !control->drag_moved_) {
             auto param = control->getBoundParameter();
             param->resetToDefault();
-            std::cout << "Dial reset to default: " << param->getName() << std::endl;
+            LOG_DEBUG("DIAL", "Dial reset to default: %s", param->getName().c_str());
         }
     }
 }
+
+void DialControl::container_drag_cb(lv_event_t* e) {
+    DialControl* control = static_cast<DialControl*>(lv_event_get_user_data(e));
+    if (control) {
+        control->onDrag(lv_event_get_code(e));
+    }
+}
+
+void DialControl::onDrag(lv_event_code_t code) {
+    if (code == LV_EVENT_PRESSED) {
+        drag_moved_ = false;
+        drag_value_ = display_value_;
+        return;
+    }
+    
+    if (!isParameterBound() || !getBoundParameter()->isHighResolution()) return;
+    
+    lv_indev_t* indev = lv_indev_active();
+    if (!indev) return;
+    
+    lv_point_t vect;
+    lv_indev_get_vect(indev, &vect);
+    if (vect.y == 0) return;
+    drag_moved_ = true;
+    
+    auto param = getBoundParameter();
+    float range = static_cast<float>(param->getMaxValue() - param->getMinValue());
+    float per_pixel = range / DRAG_PIXELS_PER_RANGE;
+    
+    // Fine adjustment once the pointer has left the dial sideways
+    lv_point_t point;
+    lv_indev_get_point(indev, &point);
+    lv_area_t area;
+    lv_obj_get_coords(container_, &area);
+    if (point.x < area.x1 || point.x > area.x2) {
+        per_pixel /= FINE_DRAG_FACTOR;
+    }
+    
+    // Up increases; the float keeps sub-step movement between events
+    drag_value_ -= vect.y * per_pixel;
+    drag_value_ = std::max<float>(param->getMinValue(), std::min<float>(param->getMaxValue(), drag_value_));
+    
+    uint16_t value = static_cast<uint16_t>(std::lround(drag_value_));
+    if (value != display_value_) {
+        updateParameterFromControl(value);
+        updateArcDisplay();
+    }
+}
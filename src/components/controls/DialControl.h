@@ -13,6 +13,12 @@
  * This class wraps the existing MidiDial functionality with parameter awareness.
  * It automatically displays parameter names, handles value scaling, and integrates
  * with the observer pattern for synchronized updates.
+ *
+ * A 7-bit parameter is set by dragging the arc. The arc maps whole degrees
+ * to values, which can't reach every step of a high-resolution (14-bit)
+ * parameter, so for those the arc only displays and the dial is dragged
+ * vertically instead; moving the pointer sideways off the dial while
+ * dragging switches to fine adjustment.
  */
 class DialControl : public ParameterControl {
 public:
@@ -39,7 +45,7 @@ public:
 protected:
     // ParameterControl implementation
     void updateDisplayFromParameter() override;
-    void updateParameterFromControl(uint8_t value) override;
+    void updateParameterFromControl(uint16_t value) override;
     void onParameterBound() override;
     void onParameterUnbound() override;
     void onEnabledChanged(bool enabled) override;
@@ -59,17 +65,25 @@ private:
     bool use_custom_label_;
     
     // Internal state
-    uint8_t display_value_;
+    uint16_t display_value_;
+    
+    // Vertical drag (high-resolution parameters)
+    static constexpr float DRAG_PIXELS_PER_RANGE = 200.0f;
+    static constexpr float FINE_DRAG_FACTOR = 64.0f;
+    float drag_value_;
+    bool drag_moved_;
     
     // Setup and styling
     void createWidgets(lv_obj_t* parent, int x, int y);
     void setupStyling();
     void updateLabels();
     void updateArcDisplay();
+    void onDrag(lv_event_code_t code);
     
     // Event handlers
     static void arc_event_cb(lv_event_t* e);
     static void container_click_cb(lv_event_t* e);
+    static void container_drag_cb(lv_event_t* e);
     
     // Static mapping for event callbacks
     static std::unordered_map<lv_obj_t*, DialControl*> dial_control_map_;
@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include <iostream>
 #include "FontConfig.h"
+#include "components/log/Log.h"
 
 // ============================================================================
 // ParameterControl Base Class Implementation
@@ -29,7 +30,7 @@ void ParameterControl::bindParameter(std::shared_ptr<Parameter> parameter) {
     // Bind new parameter
     bound_parameter_ = parameter;
     if (bound_parameter_) {
-        bound_parameter_->addObserver(shared_from_this());
+        bound_parameter_->addObserver(this);
         updateDisplayFromParameter();
         onParameterBound();
     }
@@ -37,7 +38,7 @@ void ParameterControl::bindParameter(std::shared_ptr<Parameter> parameter) {
 
 void ParameterControl::unbindParameter() {
     if (bound_parameter_) {
-        bound_parameter_->removeObserver(shared_from_this());
+        bound_parameter_->removeObserver(this);
         bound_parameter_.reset();
         onParameterUnbound();
     }
@@ -51,7 +52,7 @@ bool ParameterControl::isParameterBound() const {
     return bound_parameter_ != nullptr;
 }
 
-void ParameterControl::setControlValue(uint8_t value) {
+void ParameterControl::setControlValue(uint16_t value) {
     if (bound_parameter_) {
         // Update parameter, which will trigger observer notification
         updating_from_parameter_ = false;
@@ -59,7 +60,7 @@ void ParameterControl::setControlValue(uint8_t value) {
     }
 }
 
-uint8_t ParameterControl::getControlValue() const {
+uint16_t ParameterControl::getControlValue() const {
     if (bound_parameter_) {
         return bound_parameter_->getCurrentValue();
     }
@@ -99,16 +100,11 @@ void ParameterControl::onParameterChanged(const Parameter& /* parameter */) {
     updating_from_parameter_ = false;
 }
 
-void ParameterControl::notifyValueChanged(uint8_t value) {
-    std::cout << "ParameterControl::notifyValueChanged called with value: " << (int)value << std::endl;
-    std::cout << "value_changed_callback_ is " << (value_changed_callback_ ? "NOT NULL" : "NULL") << std::endl;
-    std::cout << "bound_parameter_ is " << (bound_parameter_ ? "NOT NULL" : "NULL") << std::endl;
-    
+void ParameterControl::notifyValueChanged(uint16_t value) {
     if (value_changed_callback_ && bound_parameter_) {
-        std::cout << "Calling value_changed_callback_..." << std::endl;
         value_changed_callback_(value, bound_parameter_.get());
-        std::cout << "value_changed_callback_ completed" << std::endl;
     } else {
-        std::cout << "NOT calling value_changed_callback_ - conditions not met" << std::endl;
+        LOG_TRACE("ParameterControl", "notifyValueChanged(%d) not forwarded: callback=%d parameter=%d",
+                  (int)value, value_changed_callback_ != nullptr, bound_parameter_ != nullptr);
     }
 }
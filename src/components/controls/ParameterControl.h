@@ -13,7 +13,7 @@
  * This class provides the interface between the Parameter model and UI controls.
  * It handles parameter binding, value synchronization, and observer pattern integration.
  */
-class ParameterControl : public ParameterObserver, public std::enable_shared_from_this<ParameterControl> {
+class ParameterControl : public ParameterObserver {
 public:
     ParameterControl();
     virtual ~ParameterControl();
@@ -25,8 +25,8 @@ public:
     bool isParameterBound() const;
     
     // Value management
-    virtual void setControlValue(uint8_t value);
-    virtual uint8_t getControlValue() const;
+    virtual void setControlValue(uint16_t value);
+    virtual uint16_t getControlValue() const;
     
     // UI state management
     virtual void setEnabled(bool enabled);
@@ -44,7 +44,7 @@ public:
     virtual lv_obj_t* getObject() = 0;
     
     // Callbacks
-    using ValueChangedCallback = std::function<void(uint8_t value, const Parameter* parameter)>;
+    using ValueChangedCallback = std::function<void(uint16_t value, const Parameter* parameter)>;
     void setValueChangedCallback(ValueChangedCallback callback);
     
     // ParameterObserver implementation
@@ -53,14 +53,14 @@ public:
 protected:
     // Pure virtual methods for subclasses to implement
     virtual void updateDisplayFromParameter() = 0;
-    virtual void updateParameterFromControl(uint8_t value) = 0;
+    virtual void updateParameterFromControl(uint16_t value) = 0;
     virtual void onParameterBound() {}
     virtual void onParameterUnbound() {}
     virtual void onEnabledChanged(bool /* enabled */) {}
     virtual void onVisibilityChanged(bool /* visible */) {}
     
     // Helper methods for subclasses
-    void notifyValueChanged(uint8_t value);
+    void notifyValueChanged(uint16_t value);
     bool isUpdatingFromParameter() const { return updating_from_parameter_; }
     
     // Protected members for subclasses
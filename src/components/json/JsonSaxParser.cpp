@@ -0,0 +1,360 @@
+#include "JsonSaxParser.h"
+#include <cstdlib>
+
+namespace {
+    constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    bool isWhitespace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool isValidNumber(const std::string& text, bool& is_integer) {
+        size_t i = 0;
+        size_t n = text.size();
+        is_integer = true;
+
+        if (i < n && text[i] == '-') i++;
+        if (i >= n || !isDigit(text[i])) return false;
+        if (text[i] == '0') {
+            i++;
+        } else {
+            while (i < n && isDigit(text[i])) i++;
+        }
+
+        if (i < n && text[i] == '.') {
+            is_integer = false;
+            i++;
+            if (i >= n || !isDigit(text[i])) return false;
+            while (i < n && isDigit(text[i])) i++;
+        }
+
+        if (i < n && (text[i] == 'e' || text[i] == 'E')) {
+            is_integer = false;
+            i++;
+            if (i < n && (text[i] == '+' || text[i] == '-')) i++;
+            if (i >= n || !isDigit(text[i])) return false;
+            while (i < n && isDigit(text[i])) i++;
+        }
+        return i == n;
+    }
+}
+
+JsonSaxParser::JsonSaxParser(JsonSaxHandler& handler)
+    : handler_(handler) {
+}
+
+void JsonSaxParser::reset() {
+    state_ = State::VALUE;
+    depth_ = 0;
+    token_.clear();
+    string_is_key_ = false;
+    unicode_value_ = 0;
+    unicode_digits_ = 0;
+    high_surrogate_ = 0;
+    error_ = nullptr;
+    line_ = 1;
+    column_ = 0;
+}
+
+bool JsonSaxParser::feed(const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        if (c == '\n') {
+            line_++;
+            column_ = 0;
+        } else {
+            column_++;
+        }
+        if (!step(c)) return false;
+    }
+    return true;
+}
+
+bool JsonSaxParser::finish() {
+    if (state_ == State::NUMBER && !finishNumber()) return false;
+    if (state_ == State::LITERAL && !finishLiteral()) return false;
+    if (state_ == State::FAILED) return false;
+    if (state_ != State::DONE) return fail("Unexpected end of input");
+    return true;
+}
+
+bool JsonSaxParser::fail(const char* message) {
+    error_ = message;
+    state_ = State::FAILED;
+    return false;
+}
+
+bool JsonSaxParser::step(char c) {
+    switch (state_) {
+        case State::STRING:
+            if (c == '"') {
+                if (high_surrogate_) {
+                    appendUtf8(REPLACEMENT_CHARACTER);
+                    high_surrogate_ = 0;
+                }
+                if (string_is_key_) {
+                    handler_.onKey(token_);
+                    state_ = State::COLON;
+                    return true;
+                }
+                handler_.onString(token_);
+                return endValue();
+            }
+            if (c == '\\') {
+                state_ = State::STRING_ESCAPE;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) return fail("Control character in string");
+            if (high_surrogate_) {
+                appendUtf8(REPLACEMENT_CHARACTER);
+                high_surrogate_ = 0;
+            }
+            token_ += c;
+            return true;
+
+        case State::STRING_ESCAPE: {
+            char decoded;
+            switch (c) {
+                case '"':  decoded = '"'; break;
+                case '\\': decoded = '\\'; break;
+                case '/':  decoded = '/'; break;
+                case 'b':  decoded = '\b'; break;
+                case 'f':  decoded = '\f'; break;
+                case 'n':  decoded = '\n'; break;
+                case 'r':  decoded = '\r'; break;
+                case 't':  decoded = '\t'; break;
+                case 'u':
+                    unicode_value_ = 0;
+                    unicode_digits_ = 0;
+                    state_ = State::STRING_UNICODE;
+                    return true;
+                default:
+                    return fail("Invalid escape in string");
+            }
+            if (high_surrogate_) {
+                appendUtf8(REPLACEMENT_CHARACTER);
+                high_surrogate_ = 0;
+            }
+            token_ += decoded;
+            state_ = State::STRING;
+            return true;
+        }
+
+        case State::STRING_UNICODE: {
+            int digit = hexValue(c);
+            if (digit < 0) return fail("Invalid \\u escape");
+            unicode_value_ = (unicode_value_ << 4) | static_cast<uint32_t>(digit);
+            if (++unicode_digits_ < 4) return true;
+            state_ = State::STRING;
+            return finishUnicodeEscape();
+        }
+
+        case State::NUMBER:
+            if (isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                token_ += c;
+                return true;
+            }
+            // The character that ended the number still needs handling
+            return finishNumber() && step(c);
+
+        case State::LITERAL:
+            if (c >= 'a' && c <= 'z') {
+                token_ += c;
+                return true;
+            }
+            return finishLiteral() && step(c);
+
+        case State::FAILED:
+            return false;
+
+        default:
+            break;
+    }
+
+    if (isWhitespace(c)) return true;
+
+    switch (state_) {
+        case State::VALUE:
+            return beginValue(c);
+
+        case State::FIRST_VALUE:
+            if (c == ']') {
+                depth_--;
+                handler_.onArrayEnd();
+                return endValue();
+            }
+            return beginValue(c);
+
+        case State::FIRST_KEY:
+            if (c == '}') {
+                depth_--;
+                handler_.onObjectEnd();
+                return endValue();
+            }
+            [[fallthrough]];
+        case State::KEY:
+            if (c != '"') return fail("Expected a key");
+            token_.clear();
+            string_is_key_ = true;
+            high_surrogate_ = 0;
+            state_ = State::STRING;
+            return true;
+
+        case State::COLON:
+            if (c != ':') return fail("Expected ':'");
+            state_ = State::VALUE;
+            return true;
+
+        case State::NEXT: {
+            char open = stack_[depth_ - 1];
+            if (c == ',') {
+                state_ = open == '{' ? State::KEY : State::VALUE;
+                return true;
+            }
+            if ((c == '}' && open == '{') || (c == ']' && open == '[')) {
+                depth_--;
+                if (c == '}') {
+                    handler_.onObjectEnd();
+                } else {
+                    handler_.onArrayEnd();
+                }
+                return endValue();
+            }
+            return fail("Expected ',' or a closing bracket");
+        }
+
+        case State::DONE:
+            return fail("Unexpected data after the document");
+
+        default:
+            return fail("Internal parser error");
+    }
+}
+
+bool JsonSaxParser::beginValue(char c) {
+    switch (c) {
+        case '{':
+        case '[':
+            if (depth_ >= MAX_DEPTH) return fail("Nesting too deep");
+            stack_[depth_++] = c;
+            if (c == '{') {
+                handler_.onObjectStart();
+                state_ = State::FIRST_KEY;
+            } else {
+                handler_.onArrayStart();
+                state_ = State::FIRST_VALUE;
+            }
+            return true;
+        case '"':
+            token_.clear();
+            string_is_key_ = false;
+            high_surrogate_ = 0;
+            state_ = State::STRING;
+            return true;
+        case 't':
+        case 'f':
+        case 'n':
+            token_.assign(1, c);
+            state_ = State::LITERAL;
+            return true;
+        default:
+            if (c == '-' || isDigit(c)) {
+                token_.assign(1, c);
+                state_ = State::NUMBER;
+                return true;
+            }
+            return fail("Unexpected character");
+    }
+}
+
+bool JsonSaxParser::endValue() {
+    state_ = depth_ == 0 ? State::DONE : State::NEXT;
+    return true;
+}
+
+bool JsonSaxParser::finishNumber() {
+    bool is_integer;
+    if (!isValidNumber(token_, is_integer)) return fail("Invalid number");
+
+    double value;
+    if (is_integer && token_.size() <= 16) {
+        // Exact in a double; no strtod (slow on soft-float targets)
+        bool negative = token_[0] == '-';
+        int64_t magnitude = 0;
+        for (size_t i = negative ? 1 : 0; i < token_.size(); ++i) {
+            magnitude = magnitude * 10 + (token_[i] - '0');
+        }
+        value = static_cast<double>(negative ? -magnitude : magnitude);
+    } else {
+        value = std::strtod(token_.c_str(), nullptr);
+    }
+
+    handler_.onNumber(value);
+    return endValue();
+}
+
+bool JsonSaxParser::finishLiteral() {
+    if (token_ == "true") {
+        handler_.onBool(true);
+    } else if (token_ == "false") {
+        handler_.onBool(false);
+    } else if (token_ == "null") {
+        handler_.onNull();
+    } else {
+        return fail("Invalid literal");
+    }
+    return endValue();
+}
+
+bool JsonSaxParser::finishUnicodeEscape() {
+    uint32_t value = unicode_value_;
+
+    if (high_surrogate_) {
+        uint32_t high = high_surrogate_;
+        high_surrogate_ = 0;
+        if (value >= 0xDC00 && value <= 0xDFFF) {
+            appendUtf8(0x10000 + ((high - 0xD800) << 10) + (value - 0xDC00));
+            return true;
+        }
+        appendUtf8(REPLACEMENT_CHARACTER);
+    }
+
+    if (value >= 0xD800 && value <= 0xDBFF) {
+        high_surrogate_ = value;   // Completed by the next escape, if any
+    } else if (value >= 0xDC00 && value <= 0xDFFF) {
+        appendUtf8(REPLACEMENT_CHARACTER);
+    } else {
+        appendUtf8(value);
+    }
+    return true;
+}
+
+void JsonSaxParser::appendUtf8(uint32_t code_point) {
+    if (code_point < 0x80) {
+        token_ += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        token_ += static_cast<char>(0xC0 | (code_point >> 6));
+        token_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        token_ += static_cast<char>(0xE0 | (code_point >> 12));
+        token_ += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        token_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        token_ += static_cast<char>(0xF0 | (code_point >> 18));
+        token_ += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        token_ += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        token_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Receives the events of a JsonSaxParser
+ *
+ * Views passed to onKey() / onString() are only valid during the call.
+ */
+class JsonSaxHandler {
+public:
+    virtual ~JsonSaxHandler() = default;
+
+    virtual void onObjectStart() {}
+    virtual void onObjectEnd() {}
+    virtual void onArrayStart() {}
+    virtual void onArrayEnd() {}
+    virtual void onKey(std::string_view key) { (void)key; }
+    virtual void onString(std::string_view value) { (void)value; }
+    virtual void onNumber(double value) { (void)value; }
+    virtual void onBool(bool value) { (void)value; }
+    virtual void onNull() {}
+};
+
+/**
+ * @brief Streaming (SAX) JSON parser
+ *
+ * Reports each value to a handler as it is read instead of building a
+ * document tree, so memory use is the nesting stack plus the longest
+ * string or number, whatever the input size. Input can be fed in chunks of
+ * any size (e.g. straight from a file read buffer); tokens split across
+ * chunks are handled.
+ *
+ * Accepts RFC 8259 JSON, including \uXXXX escapes (surrogate pairs are
+ * combined, strings are reported as UTF-8). Integers are read without
+ * strtod(); only numbers with a fraction or exponent go through it.
+ */
+class JsonSaxParser {
+public:
+    static constexpr size_t MAX_DEPTH = 32;
+
+    explicit JsonSaxParser(JsonSaxHandler& handler);
+
+    // Returns false on a syntax error; see getError()
+    bool feed(const char* data, size_t size);
+    // End of input; false if the document is incomplete
+    bool finish();
+    // Whole document in one call
+    bool parse(std::string_view text) { return feed(text.data(), text.size()) && finish(); }
+
+    void reset();
+
+    const char* getError() const { return error_; }
+    size_t getLine() const { return line_; }
+    size_t getColumn() const { return column_; }
+
+private:
+    enum class State : uint8_t {
+        VALUE,              // Expecting a value
+        FIRST_KEY,          // After '{': key or '}'
+        KEY,                // After ',' in an object
+        COLON,
+        NEXT,               // After a value: ',' or the closing bracket
+        FIRST_VALUE,        // After '[': value or ']'
+        STRING,
+        STRING_ESCAPE,
+        STRING_UNICODE,
+        NUMBER,
+        LITERAL,
+        DONE,
+        FAILED
+    };
+
+    bool step(char c);
+    bool beginValue(char c);
+    bool endValue();
+    bool finishNumber();
+    bool finishLiteral();
+    bool finishUnicodeEscape();
+    bool fail(const char* message);
+    void appendUtf8(uint32_t code_point);
+
+    JsonSaxHandler& handler_;
+    State state_ = State::VALUE;
+
+    // Open containers: '{' or '['
+    char stack_[MAX_DEPTH];
+    size_t depth_ = 0;
+
+    // Current string / number / literal
+    std::string token_;
+    bool string_is_key_ = false;
+    uint32_t unicode_value_ = 0;
+    uint8_t unicode_digits_ = 0;
+    uint32_t high_surrogate_ = 0;
+
+    const char* error_ = nullptr;
+    size_t line_ = 1;
+    size_t column_ = 0;
+};
@@ -0,0 +1,219 @@
+#include "Log.h"
+#include "components/midi/MidiTime.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+
+#if defined(ESP32_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    constexpr size_t TEXT_SIZE = 112;
+#if defined(ESP32_BUILD)
+    constexpr size_t RING_CAPACITY = 128;    // ~16 KB of internal RAM
+    constexpr TickType_t DRAIN_INTERVAL_TICKS = pdMS_TO_TICKS(20) > 0 ? pdMS_TO_TICKS(20) : 1;
+    constexpr uint32_t TASK_STACK_SIZE = 3072;
+    constexpr UBaseType_t TASK_PRIORITY = 1;  // Same as the Arduino loop; below MIDI
+#else
+    constexpr size_t RING_CAPACITY = 512;
+    constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(20);
+#endif
+
+    struct Record {
+        uint64_t timestamp_us;
+        const char* tag;
+        int level;
+        char text[TEXT_SIZE];
+    };
+
+    // Bounded multi-producer queue (Vyukov): each cell carries a sequence
+    // number that tells producers and the consumer whose turn it is, so
+    // pushes from any thread are lock-free and never block each other.
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Record record;
+    };
+
+    Cell ring[RING_CAPACITY];
+    std::atomic<size_t> enqueue_pos{0};
+    size_t dequeue_pos = 0;                 // Writer thread only
+    std::atomic<bool> ring_ready{false};
+    std::atomic<bool> running{false};
+    std::atomic<uint32_t> dropped{0};
+    uint32_t dropped_reported = 0;
+
+#if defined(ESP32_BUILD)
+    TaskHandle_t task_handle = nullptr;
+    std::atomic<bool> task_exited{true};
+#else
+    std::thread writer_thread;
+#endif
+
+    void initRing() {
+        if (ring_ready.load(std::memory_order_acquire)) return;
+        for (size_t i = 0; i < RING_CAPACITY; ++i) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueue_pos.store(0, std::memory_order_relaxed);
+        dequeue_pos = 0;
+        ring_ready.store(true, std::memory_order_release);
+    }
+
+    bool push(const Record& record) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = ring[pos % RING_CAPACITY];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.record = record;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(Record& record) {
+        Cell& cell = ring[dequeue_pos % RING_CAPACITY];
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos + 1) < 0) {
+            return false;  // Empty (or the producer hasn't finished writing)
+        }
+        record = cell.record;
+        cell.sequence.store(dequeue_pos + RING_CAPACITY, std::memory_order_release);
+        dequeue_pos++;
+        return true;
+    }
+
+    void output(const Record& record) {
+        static const char LEVEL_CHARS[] = {'-', 'E', 'W', 'I', 'D', 'T'};
+        char level_char = (record.level >= 0 && record.level <= LOG_LEVEL_TRACE) ? LEVEL_CHARS[record.level] : '?';
+        std::printf("%c %6lu.%03lu [%s] %s\n", level_char,
+                    static_cast<unsigned long>(record.timestamp_us / 1000000),
+                    static_cast<unsigned long>((record.timestamp_us / 1000) % 1000),
+                    record.tag, record.text);
+    }
+
+    // Writer thread: everything queued so far, one flush per pass
+    void drain() {
+        Record record;
+        bool wrote = false;
+        while (pop(record)) {
+            output(record);
+            wrote = true;
+        }
+
+        uint32_t dropped_now = dropped.load(std::memory_order_relaxed);
+        if (dropped_now != dropped_reported) {
+            std::printf("W [Log] %lu messages dropped (ring full)\n",
+                        static_cast<unsigned long>(dropped_now - dropped_reported));
+            dropped_reported = dropped_now;
+            wrote = true;
+        }
+
+        if (wrote) {
+            std::fflush(stdout);
+        }
+    }
+
+#if defined(ESP32_BUILD)
+    void writerTask(void*) {
+        while (running.load(std::memory_order_acquire)) {
+            drain();
+            vTaskDelay(DRAIN_INTERVAL_TICKS);
+        }
+        drain();
+        task_exited.store(true, std::memory_order_release);
+        vTaskDelete(nullptr);
+    }
+#else
+    void writerThread() {
+        // Lowest normal priority: logging must never compete with UI or MIDI
+        sched_param param{};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+
+        while (running.load(std::memory_order_acquire)) {
+            drain();
+            std::this_thread::sleep_for(DRAIN_INTERVAL);
+        }
+        drain();
+    }
+#endif
+}
+
+namespace Log {
+
+void start() {
+    initRing();
+    if (running.exchange(true, std::memory_order_acq_rel)) return;
+
+#if defined(ESP32_BUILD)
+    task_exited.store(false, std::memory_order_release);
+    if (xTaskCreate(writerTask, "log_writer", TASK_STACK_SIZE, nullptr, TASK_PRIORITY, &task_handle) != pdPASS) {
+        running.store(false, std::memory_order_release);
+        task_exited.store(true, std::memory_order_release);
+        task_handle = nullptr;
+        std::printf("E [Log] Failed to create writer task, logging synchronously\n");
+    }
+#else
+    writer_thread = std::thread(writerThread);
+#endif
+}
+
+void stop() {
+    if (!running.exchange(false, std::memory_order_acq_rel)) return;
+
+#if defined(ESP32_BUILD)
+    while (!task_exited.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    task_handle = nullptr;
+#else
+    if (writer_thread.joinable()) {
+        writer_thread.join();
+    }
+#endif
+}
+
+uint32_t getDroppedCount() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void write(int level, const char* tag, const char* format, ...) {
+    Record record;
+    record.timestamp_us = MidiTime::nowUs();
+    record.tag = tag;
+    record.level = level;
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(record.text, sizeof(record.text), format, args);
+    va_end(args);
+
+    if (!running.load(std::memory_order_acquire)) {
+        output(record);
+        std::fflush(stdout);
+        return;
+    }
+
+    if (!push(record)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace Log
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Compile-time filtered, asynchronous logging
+ *
+ *   LOG_INFO("MidiClock", "Transport PLAY (BPM: %.1f)", bpm);
+ *
+ * Levels above LOG_LEVEL (build flag, default LOG_LEVEL_INFO) are discarded
+ * at compile time: the call and its arguments generate no code, but are
+ * still type-checked. Enabled levels format into a fixed-size record on the
+ * caller's stack and push it into a lock-free ring; a low-priority thread
+ * (FreeRTOS task on ESP32) writes the records out, so a UI or MIDI thread
+ * never waits on stdout or the UART. If the ring is full the record is
+ * dropped and counted rather than blocking.
+ *
+ * Until Log::start() is called (and after Log::stop()) records are written
+ * synchronously, so early startup messages are never lost.
+ *
+ * Tags must be string literals (records keep the pointer, not a copy).
+ */
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_AT(level, tag, ...)                                  \
+    do {                                                         \
+        if constexpr ((level) <= LOG_LEVEL) {                    \
+            ::Log::write((level), (tag), __VA_ARGS__);           \
+        }                                                        \
+    } while (0)
+
+#define LOG_ERROR(tag, ...) LOG_AT(LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  LOG_AT(LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define LOG_DEBUG(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+#define LOG_TRACE(tag, ...) LOG_AT(LOG_LEVEL_TRACE, tag, __VA_ARGS__)
+
+namespace Log {
+    // Start/stop the background writer. stop() flushes what is queued.
+    void start();
+    void stop();
+
+    // Records dropped because the ring was full
+    uint32_t getDroppedCount();
+
+    // Use the LOG_* macros instead of calling this directly
+    void write(int level, const char* tag, const char* format, ...)
+#if defined(__GNUC__)
+        __attribute__((format(printf, 3, 4)))
+#endif
+        ;
+}
@@ -0,0 +1,156 @@
+#include "ClockFollower.h"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+namespace {
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double ERROR_SMOOTHING = 0.1;
+}
+
+ClockFollower::ClockFollower(int ppqn)
+    : ppqn_(std::max(1, ppqn)) {
+}
+
+void ClockFollower::reset() {
+    origin_us_ = 0;
+    next_tick_ = 0.0;
+    period_us_ = 0.0;
+    last_error_us_ = 0.0;
+    smoothed_error_ = 0.0;
+    locked_ = false;
+    lock_counter_ = 0;
+    outlier_history_ = 0;
+    tick_count_ = 0;
+    outlier_count_ = 0;
+    relock_count_ = 0;
+}
+
+void ClockFollower::restartAcquisition(uint64_t timestamp_us) {
+    origin_us_ = timestamp_us;
+    next_tick_ = 0.0;
+    period_us_ = 0.0;
+    last_error_us_ = 0.0;
+    smoothed_error_ = 0.0;
+    locked_ = false;
+    lock_counter_ = 0;
+    outlier_history_ = 0;
+    tick_count_ = 1;
+}
+
+void ClockFollower::setBandwidth(float bandwidth_hz) {
+    bandwidth_hz_ = std::clamp(bandwidth_hz, 0.05f, 10.0f);
+    updateCoefficients();
+}
+
+void ClockFollower::setPPQN(int ppqn) {
+    ppqn = std::max(1, ppqn);
+    if (ppqn != ppqn_) {
+        ppqn_ = ppqn;
+        reset();
+    }
+}
+
+float ClockFollower::getBPM() const {
+    if (period_us_ <= 0.0) return 0.0f;
+    float bpm = static_cast<float>(60000000.0 / (period_us_ * ppqn_));
+    return std::clamp(bpm, MIN_BPM, MAX_BPM);
+}
+
+uint64_t ClockFollower::getPredictedNextTickUs() const {
+    if (!hasEstimate()) return 0;
+    return origin_us_ + static_cast<uint64_t>(std::max(0.0, next_tick_));
+}
+
+void ClockFollower::updateCoefficients() {
+    if (period_us_ <= 0.0) return;
+
+    // Standard second-order DLL: omega = 2*pi*B*T, b = sqrt(2)*omega, c = omega^2
+    float bandwidth = locked_ ? bandwidth_hz_ : bandwidth_hz_ * ACQUIRE_BANDWIDTH_SCALE;
+    double omega = 2.0 * PI * bandwidth * (period_us_ / 1000000.0);
+    omega = std::min(omega, 0.5);  // Keep the loop stable at very low tick rates
+    b_ = std::sqrt(2.0) * omega;
+    c_ = omega * omega;
+}
+
+void ClockFollower::acquire(double t) {
+    // Second pulse: the raw interval is the best period guess we have
+    double previous = next_tick_;
+    double period = t - previous;
+
+    double min_period = 60000000.0 / (MAX_BPM * ppqn_);
+    double max_period = 60000000.0 / (MIN_BPM * ppqn_);
+    if (period < min_period || period > max_period) {
+        // Implausible - restart acquisition from this pulse
+        next_tick_ = t;
+        tick_count_ = 1;
+        return;
+    }
+
+    period_us_ = period;
+    next_tick_ = t + period_us_;
+    updateCoefficients();
+}
+
+void ClockFollower::onTick(uint64_t timestamp_us) {
+    if (tick_count_ == 0) {
+        restartAcquisition(timestamp_us);
+        return;
+    }
+
+    double t = static_cast<double>(timestamp_us - origin_us_);
+    tick_count_++;
+
+    if (tick_count_ == 2) {
+        acquire(t);
+        return;
+    }
+
+    double error = t - next_tick_;
+
+    // A tick about one period late is most likely a dropped pulse: skip ahead
+    double drop_window = period_us_ * OUTLIER_FRACTION * 0.5;
+    if (std::fabs(error - period_us_) < drop_window) {
+        next_tick_ += period_us_;
+        error = t - next_tick_;
+        outlier_count_++;
+    }
+
+    bool outlier = std::fabs(error) > period_us_ * OUTLIER_FRACTION;
+    outlier_history_ = (outlier_history_ << 1) | (outlier ? 1u : 0u);
+    if (outlier) {
+        outlier_count_++;
+        if (std::bitset<OUTLIER_WINDOW>(outlier_history_).count() >= MAX_RECENT_OUTLIERS) {
+            // The source really moved (tempo jump, restart) - re-acquire
+            relock_count_++;
+            restartAcquisition(timestamp_us);
+        }
+        return;
+    }
+    last_error_us_ = error;
+
+    // Loop update: phase correction plus integrated tempo correction
+    next_tick_ += b_ * error + period_us_;
+    period_us_ += c_ * error;
+
+    double min_period = 60000000.0 / (MAX_BPM * ppqn_);
+    double max_period = 60000000.0 / (MIN_BPM * ppqn_);
+    period_us_ = std::clamp(period_us_, min_period, max_period);
+    updateCoefficients();
+
+    // Lock detection with hysteresis
+    double normalized = std::fabs(error) / period_us_;
+    smoothed_error_ += ERROR_SMOOTHING * (normalized - smoothed_error_);
+
+    if (!locked_) {
+        lock_counter_ = smoothed_error_ < LOCK_THRESHOLD ? lock_counter_ + 1 : 0;
+        if (lock_counter_ >= LOCK_TICKS) {
+            locked_ = true;
+            updateCoefficients();  // Narrow to the tracking bandwidth
+        }
+    } else if (smoothed_error_ > UNLOCK_THRESHOLD) {
+        locked_ = false;
+        lock_counter_ = 0;
+        updateCoefficients();
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Delay-locked loop that follows an external MIDI clock
+ *
+ * Fed with the arrival time of every incoming 0xF8, it keeps a filtered
+ * estimate of the tick period (tempo) and of when the next tick is due.
+ * The loop is second order, so it tracks both phase and tempo; a wider
+ * bandwidth converges faster, a narrower one rejects more jitter. The loop
+ * starts with 4x the configured bandwidth and narrows to it once locked.
+ *
+ * - Outliers (ticks further than OUTLIER_FRACTION of a period from the
+ *   prediction) are ignored; a tick arriving about one period late is taken
+ *   as a dropped pulse and absorbed by skipping the prediction ahead.
+ *   MAX_RECENT_OUTLIERS among the last OUTLIER_WINDOW pulses mean the
+ *   source really changed tempo or restarted, so the loop re-acquires. (A
+ *   narrow loop chasing a tempo step slips a cycle every few pulses rather
+ *   than producing outliers in a row.)
+ * - Lock is declared once the smoothed phase error stays under
+ *   LOCK_THRESHOLD of a period and dropped above UNLOCK_THRESHOLD.
+ *
+ * Pure computation with no threading; all calls must come from one thread.
+ */
+class ClockFollower {
+public:
+    static constexpr float MIN_BPM = 20.0f;
+    static constexpr float MAX_BPM = 300.0f;
+
+    explicit ClockFollower(int ppqn = 24);
+
+    void reset();
+
+    // Feed one clock pulse; timestamp in microseconds on a monotonic clock
+    void onTick(uint64_t timestamp_us);
+
+    // Loop bandwidth in Hz (0.05 - 10). Lower = smoother, slower to follow.
+    void setBandwidth(float bandwidth_hz);
+    float getBandwidth() const { return bandwidth_hz_; }
+
+    void setPPQN(int ppqn);
+
+    // Results
+    bool hasEstimate() const { return tick_count_ >= 2; }
+    bool isLocked() const { return locked_; }
+    float getBPM() const;
+    double getPeriodUs() const { return period_us_; }
+    uint64_t getPredictedNextTickUs() const;
+    double getPhaseErrorUs() const { return last_error_us_; }
+
+    // Statistics
+    uint32_t getTickCount() const { return tick_count_; }
+    uint32_t getOutlierCount() const { return outlier_count_; }
+    uint32_t getRelockCount() const { return relock_count_; }
+
+private:
+    static constexpr double OUTLIER_FRACTION = 0.5;
+    static constexpr int OUTLIER_WINDOW = 32;   // Pulses, one bit each in outlier_history_
+    static constexpr int MAX_RECENT_OUTLIERS = 4;
+    static constexpr double LOCK_THRESHOLD = 0.15;
+    static constexpr double UNLOCK_THRESHOLD = 0.30;
+    static constexpr int LOCK_TICKS = 24;
+    static constexpr float ACQUIRE_BANDWIDTH_SCALE = 4.0f;
+
+    void acquire(double t);
+    void restartAcquisition(uint64_t timestamp_us);
+    void updateCoefficients();
+
+    int ppqn_;
+    float bandwidth_hz_ = 0.5f;
+
+    // Times are microseconds relative to origin_us_ to keep double precision
+    uint64_t origin_us_ = 0;
+    double next_tick_ = 0.0;      // Predicted time of the next tick
+    double period_us_ = 0.0;      // Filtered tick period
+    double b_ = 0.0;              // Loop coefficients
+    double c_ = 0.0;
+
+    double last_error_us_ = 0.0;
+    double smoothed_error_ = 0.0; // |error| / period, low-passed
+    bool locked_ = false;
+    int lock_counter_ = 0;
+    uint32_t outlier_history_ = 0;   // Bit 0 = last pulse was an outlier
+
+    uint32_t tick_count_ = 0;
+    uint32_t outlier_count_ = 0;
+    uint32_t relock_count_ = 0;
+};
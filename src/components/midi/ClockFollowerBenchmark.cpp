@@ -0,0 +1,146 @@
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "ClockFollowerBenchmark.h"
+#include "ClockFollower.h"
+#include "MidiEventLog.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int PPQN = 24;
+    constexpr double SEGMENT_S = 30.0;
+    constexpr double STEADY_S = 10.0;          // Measured at the end of each segment
+    constexpr double CONVERGED_FRACTION = 0.005;
+    const float BANDWIDTHS[] = {0.1f, 0.5f, 2.0f};
+    const double JITTERS_US[] = {0.0, 500.0, 2000.0};
+    const double TEMPOS_BPM[] = {120.0, 140.0};
+
+    struct SegmentResult {
+        double converge_s = -1.0;   // -1 = never
+        double bpm_rms = 0.0;
+        double phase_rms_us = 0.0;
+    };
+
+    double rms(double sum_squares, size_t count) {
+        return count ? std::sqrt(sum_squares / count) : 0.0;
+    }
+
+    // Feeds one tempo segment starting at ideal time start_us; returns the
+    // ideal time of the pulse after it
+    double runSegment(ClockFollower& follower, std::mt19937& rng, double start_us, double bpm,
+                      double jitter_us, SegmentResult& result) {
+        std::uniform_real_distribution<double> delay(0.0, jitter_us);
+        double period = 60000000.0 / (bpm * PPQN);
+        size_t pulses = static_cast<size_t>(SEGMENT_S * 1000000.0 / period);
+        size_t steady_from = pulses - static_cast<size_t>(STEADY_S * 1000000.0 / period);
+
+        double last_bad_us = start_us;   // Last pulse at which the follower was off
+        double bpm_squares = 0.0, phase_squares = 0.0;
+        size_t steady_count = 0;
+
+        for (size_t k = 0; k < pulses; ++k) {
+            double ideal = start_us + k * period;
+            follower.onTick(static_cast<uint64_t>(ideal + (jitter_us > 0.0 ? delay(rng) : 0.0)));
+
+            double bpm_error = follower.getBPM() - bpm;
+            if (!follower.isLocked() || std::fabs(bpm_error) > bpm * CONVERGED_FRACTION) {
+                last_bad_us = ideal;
+            }
+            if (k >= steady_from && follower.hasEstimate()) {
+                double phase_error = static_cast<double>(follower.getPredictedNextTickUs()) -
+                                     (ideal + period + jitter_us / 2.0);
+                bpm_squares += bpm_error * bpm_error;
+                phase_squares += phase_error * phase_error;
+                steady_count++;
+            }
+        }
+
+        double end_us = start_us + pulses * period;
+        if (last_bad_us < end_us - period) {
+            result.converge_s = (last_bad_us + period - start_us) / 1000000.0;
+        }
+        result.bpm_rms = rms(bpm_squares, steady_count);
+        result.phase_rms_us = rms(phase_squares, steady_count);
+        return end_us;
+    }
+
+    void runSynthetic() {
+        std::printf("=== Clock Follower Benchmark: %.0f -> %.0f BPM, %.0f s each, %d PPQN ===\n",
+                    TEMPOS_BPM[0], TEMPOS_BPM[1], SEGMENT_S, PPQN);
+        std::printf("  BW Hz  jitter us |");
+        for (double bpm : TEMPOS_BPM) {
+            std::printf("  %3.0f BPM: converge s  BPM rms  phase rms us |", bpm);
+        }
+        std::printf("\n");
+
+        for (float bandwidth : BANDWIDTHS) {
+            for (double jitter : JITTERS_US) {
+                ClockFollower follower(PPQN);
+                follower.setBandwidth(bandwidth);
+                std::mt19937 rng(42);   // Same pulse train for every bandwidth
+                double start = 1000000.0;
+
+                std::printf("  %5.1f  %9.0f |", bandwidth, jitter);
+                for (double bpm : TEMPOS_BPM) {
+                    SegmentResult result;
+                    start = runSegment(follower, rng, start, bpm, jitter, result);
+                    if (result.converge_s < 0.0) {
+                        std::printf("           %10s", "never");
+                    } else {
+                        std::printf("           %10.2f", result.converge_s);
+                    }
+                    std::printf("  %7.3f  %12.1f |", result.bpm_rms, result.phase_rms_us);
+                }
+                std::printf("\n");
+            }
+        }
+    }
+
+    void runRecorded(const std::string& log_path) {
+        MidiEventLogReader reader;
+        if (!reader.open(log_path)) {
+            std::printf("Clock benchmark: cannot read %s\n", log_path.c_str());
+            return;
+        }
+        std::vector<uint64_t> pulses;
+        for (size_t i = 0; i < reader.size(); ++i) {
+            MidiEventLog::Record record = reader.get(i);
+            if (record.direction == MidiEventLog::Direction::IN && record.event.status() == 0xF8) {
+                pulses.push_back(record.time_us);
+            }
+        }
+
+        std::printf("=== Clock Follower Benchmark: %zu pulses from %s ===\n", pulses.size(), log_path.c_str());
+        std::printf("  BW Hz | lock s  final BPM  phase rms us  outliers  relocks\n");
+        for (float bandwidth : BANDWIDTHS) {
+            ClockFollower follower(PPQN);
+            follower.setBandwidth(bandwidth);
+            double lock_s = -1.0;
+            double phase_squares = 0.0;
+            size_t locked_count = 0;
+            for (uint64_t pulse : pulses) {
+                follower.onTick(pulse);
+                if (follower.isLocked()) {
+                    if (lock_s < 0.0) lock_s = (pulse - pulses.front()) / 1000000.0;
+                    phase_squares += follower.getPhaseErrorUs() * follower.getPhaseErrorUs();
+                    locked_count++;
+                }
+            }
+            std::printf("  %5.1f | %6.2f  %9.2f  %12.1f  %8u  %7u\n", bandwidth, lock_s, follower.getBPM(),
+                        rms(phase_squares, locked_count), follower.getOutlierCount(), follower.getRelockCount());
+        }
+    }
+}
+
+void runClockFollowerBenchmark(const std::string& log_path) {
+    if (log_path.empty()) {
+        runSynthetic();
+    } else {
+        runRecorded(log_path);
+    }
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
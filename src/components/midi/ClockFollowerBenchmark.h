@@ -0,0 +1,26 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <string>
+
+/**
+ * @brief Replays clock pulse trains through ClockFollower
+ *
+ * Without a log: synthetic 24 PPQN trains at 120 BPM, stepping to 140 BPM
+ * halfway, with 0..jitter us of uniform random delay per pulse. For each
+ * bandwidth and jitter, and for each tempo, reports:
+ * - convergence: time until the follower is locked and its BPM stays
+ *   within 0.5% for the rest of that tempo
+ * - steady state, over the last 10 s of each tempo: RMS BPM error, and RMS
+ *   error of the predicted next pulse against the jitter-free pulse (plus
+ *   the mean delay)
+ *
+ * With a MidiEventLog recording: replays its incoming 0xF8 pulses and
+ * reports time to lock, final BPM and RMS phase error once locked (a
+ * recording has no ground truth). Run with --bench-clock or
+ * --bench-clock-log LOG.
+ */
+void runClockFollowerBenchmark(const std::string& log_path = "");
+
+#endif // !ESP32_BUILD
@@ -1,4 +1,6 @@
 #include "ESP32USBMidiBackend.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
 #include <iostream>
 
 ESP32USBMidiBackend::ESP32USBMidiBackend() {
@@ -16,6 +18,7 @@ bool ESP32USBMidiBackend::initialize() {
         
         // Create USB MIDI interface using Control Surface
         usb_midi_ = new USBMIDI_Interface();
+        usb_midi_->setCallbacks(&input_callbacks_);
         
         // Begin the Control Surface library (this initializes USB MIDI)
         Control_Surface.begin();
@@ -98,8 +101,7 @@ void ESP32USBMidiBackend::sendMessage(uint8_t status, uint8_t data1, uint8_t dat
     }
 #else
     // Desktop simulation
-    std::cout << "[ESP32 USB MIDI] 0x" << std::hex 
-              << (int)status << " 0x" << (int)data1 << " 0x" << (int)data2 << std::dec << std::endl;
+    LOG_TRACE("ESP32 USB MIDI", "0x%02x 0x%02x 0x%02x", status, data1, data2);
 #endif
     
     messages_sent_++;
@@ -135,29 +137,53 @@ void ESP32USBMidiBackend::sendMessage(uint8_t status) {
     }
 #else
     // Desktop simulation
-    std::cout << "[ESP32 USB MIDI] 0x" << std::hex << (int)status << std::dec << std::endl;
+    LOG_TRACE("ESP32 USB MIDI", "0x%02x", status);
 #endif
     
     messages_sent_++;
 }
 
+void ESP32USBMidiBackend::sendBatch(const MidiEvent* events, size_t count) {
+    if (!initialized_ || status_ != UnifiedMidiManager::ConnectionStatus::CONNECTED) {
+        return;
+    }
+    
+    // Control Surface packs consecutive sends into its USB buffer; flushing
+    // every PACKETS_PER_TRANSFER messages fills whole endpoint transfers
+    // instead of waiting out its send timeout or going one packet at a time
+    for (size_t i = 0; i < count; ++i) {
+        if (events[i].length == 1) {
+            sendMessage(events[i].status());
+        } else {
+            sendMessage(events[i].status(), events[i].data1(), events[i].data2());
+        }
+#ifdef ESP32_BUILD
+        if (usb_midi_ && (i + 1) % PACKETS_PER_TRANSFER == 0) {
+            usb_midi_->sendNow();
+        }
+#endif
+    }
+    
+#ifdef ESP32_BUILD
+    if (usb_midi_ && count % PACKETS_PER_TRANSFER != 0) {
+        usb_midi_->sendNow();
+    }
+#endif
+}
+
 void ESP32USBMidiBackend::update() {
     if (!initialized_) return;
     
 #ifdef ESP32_BUILD
-    // Update Control Surface (this processes USB MIDI input/output)
+    // Update Control Surface (this processes USB MIDI input/output);
+    // incoming messages arrive through input_callbacks_
     Control_Surface.loop();
-    
-    // Check for incoming messages
-    if (usb_midi_) {
-        // Note: Control Surface handles incoming messages via callbacks
-        // We would need to set up a callback system to capture them
-    }
 #endif
 }
 
 void ESP32USBMidiBackend::handleIncomingMessage(uint8_t status, uint8_t data1, uint8_t data2) {
-    // This would be called by a Control Surface callback
-    // TODO: Forward to UnifiedMidiManager callback system
+    // Called from Control Surface's callbacks; UnifiedMidiManager::update() picks it up
     messages_received_++;
+    input_queue_.push(TimedMidiEvent{MidiEvent::make(status, data1, data2), MidiTime::nowUs()});
+    LoopScheduler::getInstance().wake(LoopScheduler::Source::MIDI_INPUT);
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "UnifiedMidiManager.h"
+#include "SpscRing.h"
+#include "MidiTime.h"
+#include <atomic>
 
 #ifdef ESP32_BUILD
 #include <Control_Surface.h>  // Control Surface library has ESP32 USB MIDI support
@@ -25,21 +28,44 @@ public:
     bool supportsOutput() const override { return true; }
     void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) override;
     void sendMessage(uint8_t status) override;
+    void sendBatch(const MidiEvent* events, size_t count) override;
     void update() override;
+    bool pollInput(TimedMidiEvent& event) override { return input_queue_.pop(event); }
     uint32_t getMessagesSent() const override { return messages_sent_; }
     uint32_t getMessagesReceived() const override { return messages_received_; }
     std::string getName() const override { return "ESP32 USB MIDI"; }
     UnifiedMidiManager::BackendType getType() const override { return UnifiedMidiManager::BackendType::USB_MIDI; }
     
 private:
+    // A 64-byte bulk endpoint buffer (CFG_TUD_MIDI_EP_BUFSIZE) holds 16
+    // four-byte USB-MIDI event packets
+    static constexpr size_t PACKETS_PER_TRANSFER = 16;
+    
     void handleIncomingMessage(uint8_t status, uint8_t data1, uint8_t data2);
     
 #ifdef ESP32_BUILD
+    // Routes Control Surface's input callbacks back into handleIncomingMessage()
+    struct InputCallbacks : MIDI_Callbacks {
+        explicit InputCallbacks(ESP32USBMidiBackend* owner) : owner_(owner) {}
+        void onChannelMessage(MIDI_Interface&, ChannelMessage msg) override {
+            owner_->handleIncomingMessage(msg.header, msg.data1, msg.data2);
+        }
+        void onRealTimeMessage(MIDI_Interface&, RealTimeMessage msg) override {
+            owner_->handleIncomingMessage(msg.message, 0, 0);
+        }
+        ESP32USBMidiBackend* owner_;
+    };
+    
     USBMIDI_Interface* usb_midi_ = nullptr;
+    InputCallbacks input_callbacks_{this};
 #endif
     
+    // Received messages: filled on the sender thread (Control_Surface.loop()),
+    // drained by pollInput()
+    SpscRing<TimedMidiEvent, 256> input_queue_;
+    
     bool initialized_ = false;
-    uint32_t messages_sent_ = 0;
-    uint32_t messages_received_ = 0;
+    std::atomic<uint32_t> messages_sent_{0};      // Written by the sender thread
+    std::atomic<uint32_t> messages_received_{0};
     UnifiedMidiManager::ConnectionStatus status_ = UnifiedMidiManager::ConnectionStatus::DISCONNECTED;
 };
@@ -1,4 +1,6 @@
 #include "HardwareMidiBackend.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
 #include <iostream>
 
 HardwareMidiBackend::HardwareMidiBackend() {
@@ -28,6 +30,7 @@ bool HardwareMidiBackend::initialize() {
     // Standard MIDI baud rate: 31250
     // 8 data bits, no parity, 1 stop bit
     midi_serial_->begin(31250, SERIAL_8N1, rx_pin_, tx_pin_);
+    encoder_.reset();
     
     initialized_ = true;
     std::cout << "[Hardware MIDI] Serial MIDI backend initialized successfully" << std::endl;
@@ -70,32 +73,39 @@ UnifiedMidiManager::ConnectionStatus HardwareMidiBackend::getStatus() const {
 void HardwareMidiBackend::sendMessage(uint8_t status, uint8_t data1, uint8_t data2) {
 #if defined(ESP32_BUILD)
     if (midi_serial_ && initialized_) {
-        std::cout << "[Hardware MIDI] Sending: 0x" << std::hex 
-                  << (int)status << " 0x" << (int)data1 << " 0x" << (int)data2 << std::dec << std::endl;
-        midi_serial_->write(status);
-        midi_serial_->write(data1);
-        midi_serial_->write(data2);
-        messages_sent_++;
+        LOG_TRACE("Hardware MIDI", "Sending: 0x%02x 0x%02x 0x%02x", status, data1, data2);
+        writeEncoded(status, data1, data2);
     } else {
-        std::cout << "[Hardware MIDI] Cannot send - not initialized or no serial" << std::endl;
+        LOG_WARN("Hardware MIDI", "Cannot send - not initialized or no serial");
     }
 #else
-    std::cout << "[Hardware MIDI] Desktop sim: 0x" << std::hex 
-              << (int)status << " 0x" << (int)data1 << " 0x" << (int)data2 << std::dec << std::endl;
+    LOG_TRACE("Hardware MIDI", "Desktop sim: 0x%02x 0x%02x 0x%02x", status, data1, data2);
 #endif
 }
 
 void HardwareMidiBackend::sendMessage(uint8_t status) {
 #if defined(ESP32_BUILD)
     if (midi_serial_ && initialized_) {
-        std::cout << "[Hardware MIDI] Sending: 0x" << std::hex << (int)status << std::dec << std::endl;
-        midi_serial_->write(status);
-        messages_sent_++;
+        LOG_TRACE("Hardware MIDI", "Sending: 0x%02x", status);
+        writeEncoded(status, 0, 0);
     } else {
-        std::cout << "[Hardware MIDI] Cannot send - not initialized or no serial" << std::endl;
+        LOG_WARN("Hardware MIDI", "Cannot send - not initialized or no serial");
     }
 #else
-    std::cout << "[Hardware MIDI] Desktop sim: 0x" << std::hex << (int)status << std::dec << std::endl;
+    LOG_TRACE("Hardware MIDI", "Desktop sim: 0x%02x", status);
+#endif
+}
+
+void HardwareMidiBackend::writeEncoded(uint8_t status, uint8_t data1, uint8_t data2) {
+#if defined(ESP32_BUILD)
+    uint8_t bytes[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+    size_t length = encoder_.encode(status, data1, data2, MidiTime::nowNs(), bytes);
+    midi_serial_->write(bytes, length);
+    messages_sent_++;
+#else
+    (void)status;
+    (void)data1;
+    (void)data2;
 #endif
 }
 
@@ -103,6 +113,8 @@ void HardwareMidiBackend::update() {
 #if defined(ESP32_BUILD)
     if (!midi_serial_ || !initialized_) return;
     
+    encoder_.tick(MidiTime::nowNs());
+    
     // Check for incoming MIDI data (if RX is enabled)
     while (midi_serial_->available()) {
         uint8_t byte = midi_serial_->read();
@@ -182,37 +194,38 @@ void HardwareMidiBackend::handleCompleteMessage(uint8_t status, uint8_t data1, u
     uint8_t msg_type = status & 0xF0;
     uint8_t channel = (status & 0x0F) + 1; // Convert to 1-based
     
-    std::cout << "[Hardware MIDI] Received: ";
-    
     switch (msg_type) {
         case 0x90:
-            std::cout << "Note On Ch" << (int)channel << " Note:" << (int)data1 << " Vel:" << (int)data2;
+            LOG_TRACE("Hardware MIDI", "Received: Note On Ch%d Note:%d Vel:%d", channel, data1, data2);
             break;
         case 0x80:
-            std::cout << "Note Off Ch" << (int)channel << " Note:" << (int)data1 << " Vel:" << (int)data2;
+            LOG_TRACE("Hardware MIDI", "Received: Note Off Ch%d Note:%d Vel:%d", channel, data1, data2);
             break;
         case 0xB0:
-            std::cout << "CC Ch" << (int)channel << " CC:" << (int)data1 << " Val:" << (int)data2;
+            LOG_TRACE("Hardware MIDI", "Received: CC Ch%d CC:%d Val:%d", channel, data1, data2);
             break;
         case 0xC0:
-            std::cout << "Program Change Ch" << (int)channel << " Program:" << (int)data1;
+            LOG_TRACE("Hardware MIDI", "Received: Program Change Ch%d Program:%d", channel, data1);
             break;
         case 0xE0:
-            std::cout << "Pitch Bend Ch" << (int)channel << " Value:" << ((data2 << 7) | data1);
+            LOG_TRACE("Hardware MIDI", "Received: Pitch Bend Ch%d Value:%d", channel, (data2 << 7) | data1);
             break;
         default:
             if (status >= 0xF8) {
-                std::cout << "Real-time: 0x" << std::hex << (int)status << std::dec;
+                LOG_TRACE("Hardware MIDI", "Received: Real-time: 0x%02x", status);
             } else {
-                std::cout << "0x" << std::hex << (int)status << " 0x" << (int)data1 << " 0x" << (int)data2 << std::dec;
+                LOG_TRACE("Hardware MIDI", "Received: 0x%02x 0x%02x 0x%02x", status, data1, data2);
             }
             break;
     }
     
-    std::cout << std::endl;
-    
-    // TODO: Forward to callback system for parameter updates
-    // For now, just log the received message
+    // Hand off to UnifiedMidiManager::update(); drop on overflow rather than block the UART
+    input_queue_.push(TimedMidiEvent{MidiEvent::make(status, data1, data2), MidiTime::nowUs()});
+    LoopScheduler::getInstance().wake(LoopScheduler::Source::MIDI_INPUT);
+#else
+    (void)status;
+    (void)data1;
+    (void)data2;
 #endif
 }
 
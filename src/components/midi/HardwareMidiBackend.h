@@ -1,6 +1,10 @@
 #pragma once
 
 #include "UnifiedMidiManager.h"
+#include "SpscRing.h"
+#include "MidiTime.h"
+#include "MidiSerialEncoder.h"
+#include <atomic>
 
 #if defined(ESP32_BUILD)
 #include <HardwareSerial.h>
@@ -22,9 +26,12 @@ public:
     void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) override;
     void sendMessage(uint8_t status) override;
     void update() override;
+    bool pollInput(TimedMidiEvent& event) override { return input_queue_.pop(event); }
     uint32_t getMessagesSent() const override { return messages_sent_; }
     uint32_t getMessagesReceived() const override { return messages_received_; }
     std::string getName() const override;
+    uint32_t getLinkBytesPerSecond() const override { return 31250 / 10; }  // 8N1 at 31.25 kbaud
+    uint32_t getBytesPerSecond() const override { return encoder_.getBytesPerSecond(); }
     UnifiedMidiManager::BackendType getType() const override { return UnifiedMidiManager::BackendType::HARDWARE; }
     
     // Configuration
@@ -37,10 +44,17 @@ private:
     
     int tx_pin_ = 3;
     int rx_pin_ = -1;
-    uint32_t messages_sent_ = 0;
-    uint32_t messages_received_ = 0;
+    std::atomic<uint32_t> messages_sent_{0};      // Written by the sender thread
+    std::atomic<uint32_t> messages_received_{0};
     bool initialized_ = false;
     
+    // Output framing (running status) and byte metering, sender thread only
+    MidiSerialEncoder encoder_;
+    void writeEncoded(uint8_t status, uint8_t data1, uint8_t data2);
+    
+    // Parsed input: filled by update() on the sender thread, drained by pollInput()
+    SpscRing<TimedMidiEvent, 256> input_queue_;
+    
     // MIDI input parsing state
     enum class MidiParseState {
         WAITING_FOR_STATUS,
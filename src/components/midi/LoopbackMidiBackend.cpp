@@ -0,0 +1,135 @@
+#include "LoopbackMidiBackend.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // How often pollInput() logs the latency figures while traffic flows
+    constexpr uint64_t REPORT_INTERVAL_NS = 5ULL * 1000 * 1000 * 1000;
+}
+
+LoopbackMidiBackend::LoopbackMidiBackend(uint32_t latency_us, uint32_t jitter_us)
+    : latency_us_(latency_us), jitter_us_(jitter_us) {
+}
+
+LoopbackMidiBackend::~LoopbackMidiBackend() {
+    cleanup();
+}
+
+bool LoopbackMidiBackend::initialize() {
+    if (initialized_) return true;
+
+    last_due_ns_ = 0;
+    initialized_ = true;
+    std::cout << "[Loopback MIDI] Initialized (latency " << latency_us_.load() << " us, jitter "
+              << jitter_us_.load() << " us)" << std::endl;
+    return true;
+}
+
+void LoopbackMidiBackend::cleanup() {
+    if (!initialized_) return;
+
+    initialized_ = false;
+    InFlight discard;
+    while (in_flight_.pop(discard)) {}
+    std::cout << "[Loopback MIDI] Backend cleaned up" << std::endl;
+}
+
+UnifiedMidiManager::ConnectionStatus LoopbackMidiBackend::getStatus() const {
+    return initialized_ ? UnifiedMidiManager::ConnectionStatus::CONNECTED
+                        : UnifiedMidiManager::ConnectionStatus::DISCONNECTED;
+}
+
+void LoopbackMidiBackend::sendMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    transmit(MidiEvent::make(status, data1, data2), MidiTime::nowNs());
+}
+
+void LoopbackMidiBackend::sendMessage(uint8_t status) {
+    transmit(MidiEvent::realTime(status), MidiTime::nowNs());
+}
+
+void LoopbackMidiBackend::sendBatch(const MidiEvent* events, size_t count) {
+    // One timestamp for the batch, as if it went out in one write
+    uint64_t now_ns = MidiTime::nowNs();
+    for (size_t i = 0; i < count; ++i) {
+        transmit(events[i], now_ns);
+    }
+}
+
+void LoopbackMidiBackend::transmit(const MidiEvent& event, uint64_t now_ns) {
+    if (!initialized_) return;
+
+    uint64_t delay_ns = latency_us_.load(std::memory_order_relaxed) * 1000ULL;
+    uint32_t jitter_us = jitter_us_.load(std::memory_order_relaxed);
+    if (jitter_us) {
+        delay_ns += (rng_() % (jitter_us + 1ULL)) * 1000ULL;
+    }
+
+    // Jitter may delay a message but never let it overtake the previous one
+    uint64_t due_ns = std::max(now_ns + delay_ns, last_due_ns_);
+    if (!in_flight_.push(InFlight{due_ns, now_ns, event})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    last_due_ns_ = due_ns;
+    if (!wake_pending_) {
+        wake_pending_ = true;
+        wake_due_ns_ = due_ns;
+    }
+    messages_sent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool LoopbackMidiBackend::pollInput(TimedMidiEvent& event) {
+    const InFlight* next = in_flight_.front();
+    if (!next) return false;
+
+    uint64_t now_ns = MidiTime::nowNs();
+    if (next->due_ns > now_ns) return false;
+
+    event.event = next->event;
+    event.timestamp_us = next->due_ns / 1000;
+
+    uint32_t latency_us = static_cast<uint32_t>((now_ns - next->sent_ns) / 1000);
+    latency_samples_++;
+    latency_sum_us_ += latency_us;
+    latency_min_us_ = std::min(latency_min_us_, latency_us);
+    latency_max_us_ = std::max(latency_max_us_, latency_us);
+
+    InFlight discard;
+    in_flight_.pop(discard);
+    messages_received_.fetch_add(1, std::memory_order_relaxed);
+
+    // Reported from here rather than update(), which runs on the sender
+    // thread, so the stats stay UI thread only
+    if (now_ns - last_report_ns_ >= REPORT_INTERVAL_NS) {
+        last_report_ns_ = now_ns;
+        LatencyStats stats = getLatencyStats();
+        LOG_INFO("Loopback MIDI", "%u msgs, write->dispatch min %u / mean %.0f / max %u us, %u dropped",
+                 stats.samples, stats.min_us, stats.mean_us, stats.max_us, getDroppedCount());
+    }
+    return true;
+}
+
+void LoopbackMidiBackend::update() {
+    uint64_t now_ns = MidiTime::nowNs();
+
+    // A real port's input thread would wake the UI on arrival; do the same
+    // once the oldest unannounced message is due, then arm for the rest
+    if (wake_pending_ && wake_due_ns_ <= now_ns) {
+        LoopScheduler::getInstance().wake(LoopScheduler::Source::MIDI_INPUT);
+        wake_pending_ = last_due_ns_ > now_ns;
+        wake_due_ns_ = last_due_ns_;
+    }
+}
+
+LoopbackMidiBackend::LatencyStats LoopbackMidiBackend::getLatencyStats() const {
+    LatencyStats stats;
+    stats.samples = latency_samples_;
+    if (latency_samples_) {
+        stats.min_us = latency_min_us_;
+        stats.max_us = latency_max_us_;
+        stats.mean_us = static_cast<float>(latency_sum_us_) / latency_samples_;
+    }
+    return stats;
+}
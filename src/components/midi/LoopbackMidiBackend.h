@@ -0,0 +1,82 @@
+#pragma once
+
+#include "UnifiedMidiManager.h"
+#include "SpscRing.h"
+#include "MidiTime.h"
+#include <atomic>
+#include <random>
+
+/**
+ * @brief In-process backend whose output comes back as its input
+ *
+ * Everything the sender thread writes is delivered to pollInput() after a
+ * configurable latency plus a uniformly distributed jitter of 0..jitter_us.
+ * Delivery order always matches send order, as on a real cable. Lets the
+ * whole parameter -> MIDI -> parameter path run without a sound card, and
+ * measures how long each message took from backend write to UI dispatch.
+ */
+class LoopbackMidiBackend : public UnifiedMidiManager::MidiBackend {
+public:
+    struct LatencyStats {
+        uint32_t samples = 0;
+        uint32_t min_us = 0;
+        uint32_t max_us = 0;
+        float mean_us = 0.0f;
+    };
+
+    LoopbackMidiBackend(uint32_t latency_us = 0, uint32_t jitter_us = 0);
+    ~LoopbackMidiBackend() override;
+
+    bool initialize() override;
+    void cleanup() override;
+    UnifiedMidiManager::ConnectionStatus getStatus() const override;
+    bool supportsInput() const override { return true; }
+    bool supportsOutput() const override { return true; }
+    void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) override;
+    void sendMessage(uint8_t status) override;
+    void sendBatch(const MidiEvent* events, size_t count) override;
+    void update() override;
+    bool pollInput(TimedMidiEvent& event) override;
+    uint32_t getMessagesSent() const override { return messages_sent_; }
+    uint32_t getMessagesReceived() const override { return messages_received_; }
+    std::string getName() const override { return "Loopback"; }
+    UnifiedMidiManager::BackendType getType() const override { return UnifiedMidiManager::BackendType::LOOPBACK; }
+
+    // Simulated link, applied to messages sent from now on
+    void setLatencyUs(uint32_t latency_us) { latency_us_.store(latency_us, std::memory_order_relaxed); }
+    void setJitterUs(uint32_t jitter_us) { jitter_us_.store(jitter_us, std::memory_order_relaxed); }
+
+    // Write-to-dispatch time of delivered messages (UI thread)
+    LatencyStats getLatencyStats() const;
+    uint32_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct InFlight {
+        uint64_t due_ns;
+        uint64_t sent_ns;
+        MidiEvent event;
+    };
+
+    void transmit(const MidiEvent& event, uint64_t now_ns);   // Sender thread
+
+    SpscRing<InFlight, 1024> in_flight_;
+    std::atomic<bool> initialized_{false};
+    std::atomic<uint32_t> latency_us_;
+    std::atomic<uint32_t> jitter_us_;
+    std::atomic<uint32_t> messages_sent_{0};       // Written by the sender thread
+    std::atomic<uint32_t> messages_received_{0};
+    std::atomic<uint32_t> dropped_{0};
+
+    // Sender thread only
+    std::minstd_rand rng_;
+    uint64_t last_due_ns_ = 0;
+    bool wake_pending_ = false;       // Sent but the UI loop not yet woken for it
+    uint64_t wake_due_ns_ = 0;
+
+    // UI thread only
+    uint32_t latency_samples_ = 0;
+    uint64_t latency_sum_us_ = 0;
+    uint32_t latency_min_us_ = UINT32_MAX;
+    uint32_t latency_max_us_ = 0;
+    uint64_t last_report_ns_ = 0;
+};
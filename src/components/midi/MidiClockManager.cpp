@@ -1,20 +1,46 @@
 #include "MidiClockManager.h"
 #include "UnifiedMidiManager.h"
-#include <iostream>
+#include "MidiTime.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
 #include <algorithm>
+#include <cmath>
 
 MidiClockManager& MidiClockManager::getInstance() {
     static MidiClockManager instance;
     return instance;
 }
 
+MidiClockManager::MidiClockManager() {
+    clock_follower_.setPPQN(settings_.ppqn);
+    clock_follower_.setBandwidth(settings_.sync_bandwidth_hz);
+    
+    // Runs on the clock thread: only touch atomics and the sender queues here
+    clock_thread_.setTickCallback([this]() {
+        sendMidiClock();
+        uint64_t now_ns = MidiTime::nowNs();
+        if (now_ns - last_ui_wake_ns_ >= UI_WAKE_INTERVAL_NS) {
+            last_ui_wake_ns_ = now_ns;
+            LoopScheduler::getInstance().wake(LoopScheduler::Source::CLOCK);
+        }
+    });
+    scheduler_.setOutputCallback([](const MidiEvent& event) {
+        UnifiedMidiManager::getInstance().sendFromClockThread(event);
+    });
+    clock_thread_.setScheduler(&scheduler_);
+}
+
+MidiClockManager::~MidiClockManager() {
+    clock_thread_.stop();
+}
+
 void MidiClockManager::play() {
     TransportState old_state = transport_state_;
+    bool from_stop = transport_state_ == TransportState::STOPPED;
     
     if (transport_state_ == TransportState::STOPPED) {
         // Starting from stop - reset tick counter
         current_tick_ = 0;
-        first_tick_ = true;
         
         if (settings_.send_transport) {
             sendMidiStart();
@@ -27,9 +53,9 @@ void MidiClockManager::play() {
     }
     
     transport_state_ = TransportState::PLAYING;
-    last_tick_time_ = std::chrono::steady_clock::now();
+    syncClockThread(true, from_stop);
     
-    std::cout << "MidiClockManager: Transport PLAY (BPM: " << settings_.bpm << ")" << std::endl;
+    LOG_INFO("MidiClock", "Transport PLAY (BPM: %.1f)", settings_.bpm);
     notifyTransportChanged(old_state, transport_state_);
 }
 
@@ -38,13 +64,14 @@ void MidiClockManager::pause() {
     
     TransportState old_state = transport_state_;
     transport_state_ = TransportState::PAUSED;
+    syncClockThread();
     
     // Note: MIDI standard doesn't have a pause message, so we send stop
     if (settings_.send_transport) {
         sendMidiStop();
     }
     
-    std::cout << "MidiClockManager: Transport PAUSE" << std::endl;
+    LOG_INFO("MidiClock", "Transport PAUSE");
     notifyTransportChanged(old_state, transport_state_);
 }
 
@@ -54,12 +81,15 @@ void MidiClockManager::stop() {
     TransportState old_state = transport_state_;
     transport_state_ = TransportState::STOPPED;
     current_tick_ = 0;
+    syncClockThread();
+    scheduler_.clearTickEvents();  // Song-position events are meaningless after Stop
+    clock_thread_.wake();
     
     if (settings_.send_transport) {
         sendMidiStop();
     }
     
-    std::cout << "MidiClockManager: Transport STOP" << std::endl;
+    LOG_INFO("MidiClock", "Transport STOP");
     notifyTransportChanged(old_state, transport_state_);
 }
 
@@ -73,9 +103,12 @@ void MidiClockManager::setClockSettings(const ClockSettings& settings) {
     ClockSettings old_settings = settings_;
     settings_ = settings;
     
-    std::cout << "MidiClockManager: Settings updated - BPM: " << settings_.bpm 
-              << ", PPQN: " << settings_.ppqn 
-              << ", Mode: " << (int)settings_.mode << std::endl;
+    LOG_INFO("MidiClock", "Settings updated - BPM: %.1f, PPQN: %d, Mode: %d",
+             settings_.bpm, settings_.ppqn, (int)settings_.mode);
+    
+    syncClockThread();
+    clock_follower_.setPPQN(settings_.ppqn);
+    clock_follower_.setBandwidth(settings_.sync_bandwidth_hz);
     
     if (old_settings.bpm != settings_.bpm) {
         notifyBPMChanged();
@@ -83,10 +116,11 @@ void MidiClockManager::setClockSettings(const ClockSettings& settings) {
 }
 
 void MidiClockManager::setBPM(float bpm) {
-    bpm = std::clamp(bpm, 60.0f, 200.0f); // Reasonable BPM range
+    bpm = std::clamp(bpm, ClockFollower::MIN_BPM, ClockFollower::MAX_BPM);
     if (settings_.bpm != bpm) {
         settings_.bpm = bpm;
-        std::cout << "MidiClockManager: BPM changed to " << bpm << std::endl;
+        LOG_DEBUG("MidiClock", "BPM changed to %.2f", bpm);
+        syncClockThread();
         notifyBPMChanged();
     }
 }
@@ -96,53 +130,82 @@ void MidiClockManager::setPPQN(int ppqn) {
     ppqn = std::clamp(ppqn, 12, 96);
     if (settings_.ppqn != ppqn) {
         settings_.ppqn = ppqn;
-        std::cout << "MidiClockManager: PPQN changed to " << ppqn << std::endl;
+        LOG_INFO("MidiClock", "PPQN changed to %d", ppqn);
+        clock_follower_.setPPQN(ppqn);
+        syncClockThread();
     }
 }
 
 void MidiClockManager::setClockMode(ClockMode mode) {
     if (settings_.mode != mode) {
         settings_.mode = mode;
-        std::cout << "MidiClockManager: Clock mode changed to " << (int)mode << std::endl;
+        LOG_INFO("MidiClock", "Clock mode changed to %d", (int)mode);
         
         if (mode == ClockMode::EXTERNAL) {
             // Reset external sync state
-            external_tick_count_ = 0;
-            detected_bpm_ = 120.0f;
+            clock_follower_.reset();
         }
+        syncClockThread();
     }
 }
 
 void MidiClockManager::update() {
-    if (transport_state_ != TransportState::PLAYING) return;
+    // Ticks (and MIDI clock output) come from the clock thread; here we only
+    // advance the UI-side counter. Several ticks per frame are coalesced into
+    // a single callback.
+    uint32_t ticks = clock_thread_.takeTicks();
+    
+    if (ticks == 0 || transport_state_ != TransportState::PLAYING) return;
     
     if (settings_.mode == ClockMode::INTERNAL) {
-        auto now = std::chrono::steady_clock::now();
-        
-        if (first_tick_) {
-            first_tick_ = false;
-            last_tick_time_ = now;
-            return;
-        }
-        
-        double interval_ms = getTickIntervalMs();
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last_tick_time_);
-        
-        if (elapsed.count() >= (interval_ms * 1000)) {
-            // Time for next tick
-            current_tick_++;
-            last_tick_time_ = now;
-            
-            if (settings_.send_clock) {
-                sendMidiClock();
-            }
-            
-            notifyClockTick();
-        }
+        current_tick_ += static_cast<int>(ticks);
+        notifyClockTick();
     }
     // External mode timing is handled by incoming MIDI messages
 }
 
+bool MidiClockManager::scheduleEventAtUs(const MidiEvent& event, uint64_t time_us) {
+    clock_thread_.start();
+    bool queued = scheduler_.scheduleAtUs(event, time_us);
+    clock_thread_.wake();
+    return queued;
+}
+
+bool MidiClockManager::scheduleEventInUs(const MidiEvent& event, uint64_t delay_us) {
+    return scheduleEventAtUs(event, MidiTime::nowUs() + delay_us);
+}
+
+bool MidiClockManager::hasSongPosition() const {
+    return settings_.mode == ClockMode::INTERNAL ||
+           (settings_.mode == ClockMode::EXTERNAL && settings_.receive_clock);
+}
+
+bool MidiClockManager::scheduleEventAtTick(const MidiEvent& event, uint32_t tick) {
+    if (!hasSongPosition()) return false;  // Nothing would ever release it
+
+    clock_thread_.start();
+    bool queued = scheduler_.scheduleAtTick(event, tick);
+    clock_thread_.wake();
+    return queued;
+}
+
+bool MidiClockManager::scheduleEventInTicks(const MidiEvent& event, uint32_t delta_ticks) {
+    // Stopped: the clock thread still holds the old count, but the next
+    // Start restarts from 0. External: our count is the one the clock
+    // thread is handed, and it is never behind.
+    uint32_t position = 0;
+    if (transport_state_ != TransportState::STOPPED) {
+        position = settings_.mode == ClockMode::EXTERNAL ? static_cast<uint32_t>(current_tick_)
+                                                         : clock_thread_.getTickCount();
+    }
+    return scheduleEventAtTick(event, position + delta_ticks);
+}
+
+void MidiClockManager::clearScheduledEvents() {
+    scheduler_.clearAll();
+    clock_thread_.wake();
+}
+
 double MidiClockManager::getTickIntervalMs() const {
     // Calculate interval between MIDI clock ticks
     // 60 seconds/minute * 1000 ms/second / (BPM * PPQN) = ms per tick
@@ -150,62 +213,75 @@ double MidiClockManager::getTickIntervalMs() const {
 }
 
 // MIDI message handlers (called by MidiHandler)
-void MidiClockManager::handleMidiClockMessage() {
+void MidiClockManager::handleMidiClockMessage(uint64_t timestamp_us) {
     if (!settings_.receive_clock || settings_.mode != ClockMode::EXTERNAL) return;
     
-    auto now = std::chrono::steady_clock::now();
+    clock_follower_.onTick(timestamp_us ? timestamp_us : MidiTime::nowUs());
     
-    if (external_tick_count_ > 0) {
-        // Calculate BPM from incoming clock
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last_external_clock_);
-        double tick_interval_ms = elapsed.count() / 1000.0;
-        
-        if (tick_interval_ms > 0) {
-            // BPM = 60000 / (tick_interval_ms * PPQN)
-            float new_bpm = 60000.0f / (tick_interval_ms * settings_.ppqn);
-            
-            // Smooth the BPM detection
-            detected_bpm_ = (detected_bpm_ * 0.9f) + (new_bpm * 0.1f);
-            
-            if (abs(detected_bpm_ - settings_.bpm) > 1.0f) {
-                setBPM(detected_bpm_);
-            }
+    // Only publish the tempo once the loop has settled, and ignore changes
+    // too small to show so the BPM display doesn't flicker
+    if (clock_follower_.isLocked()) {
+        float bpm = clock_follower_.getBPM();
+        if (std::fabs(bpm - settings_.bpm) >= 0.1f) {
+            settings_.bpm = bpm;
+            notifyBPMChanged();
         }
     }
     
-    last_external_clock_ = now;
-    external_tick_count_++;
-    current_tick_++;
+    // As with the internal clock, the song position only moves while playing
+    if (transport_state_ != TransportState::PLAYING) return;
     
+    current_tick_++;
+    // The clock thread doesn't tick in this mode; it releases tick events
+    // at the position we hand it
+    clock_thread_.start();
+    clock_thread_.externalTick(static_cast<uint32_t>(current_tick_));
     notifyClockTick();
 }
 
 void MidiClockManager::handleMidiStartMessage() {
     if (!settings_.receive_transport) return;
     
-    std::cout << "MidiClockManager: Received MIDI Start" << std::endl;
+    LOG_DEBUG("MidiClock", "Received MIDI Start");
     current_tick_ = 0;
-    external_tick_count_ = 0;
     play();
 }
 
 void MidiClockManager::handleMidiStopMessage() {
     if (!settings_.receive_transport) return;
     
-    std::cout << "MidiClockManager: Received MIDI Stop" << std::endl;
+    LOG_DEBUG("MidiClock", "Received MIDI Stop");
     stop();
 }
 
 void MidiClockManager::handleMidiContinueMessage() {
     if (!settings_.receive_transport) return;
     
-    std::cout << "MidiClockManager: Received MIDI Continue" << std::endl;
+    LOG_DEBUG("MidiClock", "Received MIDI Continue");
     continue_playback();
 }
 
 // Private helper methods
+void MidiClockManager::syncClockThread(bool restart, bool reset_position) {
+    send_clock_.store(settings_.send_clock, std::memory_order_relaxed);
+    clock_thread_.setPeriodNs(static_cast<uint32_t>(getTickIntervalMs() * 1000000.0));
+    
+    bool should_tick = transport_state_ == TransportState::PLAYING &&
+                       settings_.mode == ClockMode::INTERNAL;
+    
+    if (should_tick && (restart || !clock_thread_.isTicking())) {
+        clock_thread_.start();
+        clock_thread_.takeTicks();  // Drop anything left from before the restart
+        clock_thread_.startTicking(reset_position);
+    } else if (!should_tick && clock_thread_.isTicking()) {
+        clock_thread_.stopTicking();
+        clock_thread_.takeTicks();
+    }
+}
+
 void MidiClockManager::sendMidiClock() {
-    if (settings_.send_clock) {
+    // Called on the clock thread
+    if (send_clock_.load(std::memory_order_relaxed)) {
         UnifiedMidiManager::getInstance().sendClockPulse();
     }
 }
@@ -213,21 +289,21 @@ void MidiClockManager::sendMidiClock() {
 void MidiClockManager::sendMidiStart() {
     if (settings_.send_transport) {
         UnifiedMidiManager::getInstance().sendStart();
-        std::cout << "MidiClockManager: Sending MIDI Start" << std::endl;
+        LOG_DEBUG("MidiClock", "Sending MIDI Start");
     }
 }
 
 void MidiClockManager::sendMidiStop() {
     if (settings_.send_transport) {
         UnifiedMidiManager::getInstance().sendStop();
-        std::cout << "MidiClockManager: Sending MIDI Stop" << std::endl;
+        LOG_DEBUG("MidiClock", "Sending MIDI Stop");
     }
 }
 
 void MidiClockManager::sendMidiContinue() {
     if (settings_.send_transport) {
         UnifiedMidiManager::getInstance().sendContinue();
-        std::cout << "MidiClockManager: Sending MIDI Continue" << std::endl;
+        LOG_DEBUG("MidiClock", "Sending MIDI Continue");
     }
 }
 
@@ -3,12 +3,20 @@
 #include <functional>
 #include <chrono>
 #include <memory>
+#include <atomic>
+
+#include "MidiClockThread.h"
+#include "ClockFollower.h"
+#include "MidiEventScheduler.h"
 
 /**
  * @brief MIDI Clock and Transport Manager
  * 
  * Handles MIDI clock generation, transport controls (play/pause/stop),
  * and synchronization with external devices.
+ *
+ * Internal clock ticks are generated on a MidiClockThread; update() (UI
+ * thread) only collects the ticks it produced and runs the UI callbacks.
  */
 class MidiClockManager {
 public:
@@ -32,6 +40,7 @@ public:
         bool send_transport = true; // Send start/stop/continue messages
         bool receive_clock = false; // Respond to incoming clock
         bool receive_transport = false; // Respond to transport messages
+        float sync_bandwidth_hz = 0.5f; // External clock follower loop bandwidth
     };
 
     using TransportChangedCallback = std::function<void(TransportState old_state, TransportState new_state)>;
@@ -64,7 +73,7 @@ public:
     void setClockMode(ClockMode mode);
     ClockMode getClockMode() const { return settings_.mode; }
 
-    // Update loop (call from main loop)
+    // Update loop (call from main loop) - delivers ticks to the UI callbacks
     void update();
 
     // Event callbacks
@@ -72,8 +81,9 @@ public:
     void setClockTickCallback(ClockTickCallback callback) { clock_callback_ = callback; }
     void setBPMChangedCallback(BPMChangedCallback callback) { bpm_callback_ = callback; }
 
-    // MIDI message handling (called by MidiHandler)
-    void handleMidiClockMessage();
+    // MIDI message handling (called with incoming MIDI on the UI thread).
+    // timestamp_us is the arrival time (MidiTime::nowUs()); 0 means "now".
+    void handleMidiClockMessage(uint64_t timestamp_us = 0);
     void handleMidiStartMessage();
     void handleMidiStopMessage();
     void handleMidiContinueMessage();
@@ -86,10 +96,39 @@ public:
     // Calculate timing
     double getTickIntervalMs() const;
     double getBeatIntervalMs() const { return getTickIntervalMs() * settings_.ppqn; }
+    
+    // Scheduled output, released by the clock thread at the exact deadline.
+    // Times are MidiTime microseconds; ticks are song position since Start
+    // (first tick after Start = 1), following the internal clock or, in
+    // EXTERNAL mode, the received clock pulses. The position only advances
+    // while playing: in ticks counts from the paused position, or from the
+    // next Start while stopped. Tick scheduling returns false when there is
+    // no clock to follow (OFF, or EXTERNAL without receive_clock).
+    bool scheduleEventAtUs(const MidiEvent& event, uint64_t time_us);
+    bool scheduleEventInUs(const MidiEvent& event, uint64_t delay_us);
+    bool scheduleEventAtTick(const MidiEvent& event, uint32_t tick);
+    bool scheduleEventInTicks(const MidiEvent& event, uint32_t delta_ticks);
+    void clearScheduledEvents();
+    uint32_t getClockThreadTick() const { return clock_thread_.getTickCount(); }
+    const MidiEventScheduler& getScheduler() const { return scheduler_; }
+    
+    // External clock following
+    bool isExternalClockLocked() const { return clock_follower_.isLocked(); }
+    float getExternalBPM() const { return clock_follower_.getBPM(); }
+    uint64_t getPredictedNextTickUs() const { return clock_follower_.getPredictedNextTickUs(); }
+    const ClockFollower& getClockFollower() const { return clock_follower_; }
+    
+    // Internal clock timing quality (lateness of each tick vs. its deadline)
+    MidiClockThread::JitterStats getTickJitterStats() const { return clock_thread_.getJitterStats(); }
+    void resetTickJitterStats() { clock_thread_.resetJitterStats(); }
 
 private:
-    MidiClockManager() = default;
-    ~MidiClockManager() = default;
+    // The UI only shows the tick count and beat, so the clock thread wakes
+    // it at most this often (~30 fps) rather than on every pulse
+    static constexpr uint64_t UI_WAKE_INTERVAL_NS = 33000000ULL;
+
+    MidiClockManager();
+    ~MidiClockManager();
     MidiClockManager(const MidiClockManager&) = delete;
     MidiClockManager& operator=(const MidiClockManager&) = delete;
 
@@ -101,20 +140,25 @@ private:
     void notifyTransportChanged(TransportState old_state, TransportState new_state);
     void notifyClockTick();
     void notifyBPMChanged();
+    
+    bool hasSongPosition() const;
+
+    // Push transport/tempo/mode into the clock thread
+    void syncClockThread(bool restart = false, bool reset_position = false);
 
     // State
     ClockSettings settings_;
     TransportState transport_state_ = TransportState::STOPPED;
     
-    // Timing
-    std::chrono::steady_clock::time_point last_tick_time_;
+    // Timing (scheduler declared first so it outlives the thread using it)
+    MidiEventScheduler scheduler_;
+    MidiClockThread clock_thread_;
+    std::atomic<bool> send_clock_{true};  // Copy of settings_.send_clock for the clock thread
+    uint64_t last_ui_wake_ns_ = 0;        // Clock thread only
     int current_tick_ = 0;
-    bool first_tick_ = true;
     
     // External sync
-    std::chrono::steady_clock::time_point last_external_clock_;
-    float detected_bpm_ = 120.0f;
-    int external_tick_count_ = 0;
+    ClockFollower clock_follower_;
 
     // Callbacks
     TransportChangedCallback transport_callback_;
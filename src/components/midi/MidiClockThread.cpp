@@ -0,0 +1,348 @@
+#include "MidiClockThread.h"
+#include "MidiEventScheduler.h"
+#include "Constants.h"
+#include <iostream>
+#include <algorithm>
+
+#if !defined(ESP32_BUILD)
+#include <time.h>
+#include <cerrno>
+#include <chrono>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    // If the thread falls this many periods behind (debugger, suspend, heavy
+    // load) skip ahead instead of bursting out the backlog of ticks
+    constexpr uint32_t MAX_CATCHUP_PERIODS = 4;
+
+#if defined(ESP32_BUILD)
+    constexpr uint32_t TASK_STACK_SIZE = 4096;
+    constexpr UBaseType_t TASK_PRIORITY = configMAX_PRIORITIES - 2;  // Above the MIDI sender tasks
+#else
+    constexpr int REALTIME_PRIORITY = 80;  // SCHED_FIFO, needs CAP_SYS_NICE / rtprio
+
+    // Sleep interruptibly until this close to a deadline, then finish with an
+    // absolute clock_nanosleep for precision
+    constexpr uint64_t PRECISE_SLEEP_NS = 1000000;
+#endif
+}
+
+MidiClockThread::MidiClockThread() {
+    clearStats();
+}
+
+MidiClockThread::~MidiClockThread() {
+    stop();
+}
+
+void MidiClockThread::start() {
+    if (running_.load(std::memory_order_acquire)) return;
+
+    running_.store(true, std::memory_order_release);
+
+#if defined(ESP32_BUILD)
+    esp_timer_create_args_t timer_args = {};
+    timer_args.callback = &MidiClockThread::timerCallback;
+    timer_args.arg = this;
+    timer_args.dispatch_method = ESP_TIMER_TASK;
+    timer_args.name = "midi_clock_deadline";
+    if (esp_timer_create(&timer_args, &deadline_timer_) != ESP_OK) {
+        std::cout << "[MidiClock] Failed to create deadline timer" << std::endl;
+        running_.store(false, std::memory_order_release);
+        deadline_timer_ = nullptr;
+        return;
+    }
+
+    task_exited_.store(false, std::memory_order_release);
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "midi_clock", TASK_STACK_SIZE, this,
+                                                TASK_PRIORITY, &task_handle_, SynthConstants::Core::MIDI);
+    if (result != pdPASS) {
+        std::cout << "[MidiClock] Failed to create clock task" << std::endl;
+        running_.store(false, std::memory_order_release);
+        task_exited_.store(true, std::memory_order_release);
+        task_handle_ = nullptr;
+        esp_timer_delete(deadline_timer_);
+        deadline_timer_ = nullptr;
+    }
+#else
+    thread_ = std::thread(&MidiClockThread::run, this);
+
+    sched_param param{};
+    param.sched_priority = REALTIME_PRIORITY;
+    if (pthread_setschedparam(thread_.native_handle(), SCHED_FIFO, &param) != 0) {
+        std::cout << "[MidiClock] Real-time priority unavailable, using default scheduling" << std::endl;
+    }
+#endif
+}
+
+void MidiClockThread::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+    ticking_.store(false, std::memory_order_release);
+    wake();
+
+#if defined(ESP32_BUILD)
+    // The task deletes itself once it sees running_ == false
+    while (!task_exited_.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    task_handle_ = nullptr;
+
+    if (deadline_timer_) {
+        esp_timer_stop(deadline_timer_);
+        esp_timer_delete(deadline_timer_);
+        deadline_timer_ = nullptr;
+    }
+#else
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+#endif
+}
+
+void MidiClockThread::startTicking(bool reset_position) {
+    reset_position_.store(reset_position, std::memory_order_release);
+    restart_.store(true, std::memory_order_release);
+    ticking_.store(true, std::memory_order_release);
+    wake();
+}
+
+void MidiClockThread::stopTicking() {
+    ticking_.store(false, std::memory_order_release);
+}
+
+bool MidiClockThread::externalTick(uint32_t position) {
+    if (!external_ticks_.push(position)) return false;
+    wake();
+    return true;
+}
+
+void MidiClockThread::setPeriodNs(uint32_t period_ns) {
+    if (period_ns == 0) return;
+    period_ns_.store(period_ns, std::memory_order_relaxed);
+}
+
+void MidiClockThread::run() {
+    uint64_t next_tick = 0;
+
+    while (running_.load(std::memory_order_acquire)) {
+        if (restart_.exchange(false, std::memory_order_acq_rel)) {
+            // First tick one period after play, so Start reaches the wire first
+            next_tick = nowNs() + period_ns_.load(std::memory_order_relaxed);
+            if (reset_position_.exchange(false, std::memory_order_acq_rel)) {
+                tick_count_.store(0, std::memory_order_release);
+            }
+        }
+
+        if (scheduler_) {
+            scheduler_->collect();
+        }
+
+        // Pulses from an external clock, in order. The position is taken as
+        // given, so a Start (back to 1) needs no separate reset.
+        uint32_t position;
+        while (external_ticks_.pop(position)) {
+            tick_count_.store(position, std::memory_order_release);
+            if (scheduler_) {
+                scheduler_->releaseTick(position);
+            }
+        }
+
+        bool ticking = ticking_.load(std::memory_order_acquire);
+        uint64_t deadline = ticking ? next_tick : MidiEventScheduler::NO_DEADLINE;
+        if (scheduler_) {
+            deadline = std::min(deadline, scheduler_->nextTimedDeadlineNs());
+        }
+
+        if (deadline == MidiEventScheduler::NO_DEADLINE) {
+            waitForWork();
+            continue;
+        }
+
+        if (!waitUntil(deadline)) {
+            continue;  // Woken early: state or schedule changed, re-evaluate
+        }
+
+        uint64_t now = nowNs();
+
+        if (ticking && now >= next_tick &&
+            ticking_.load(std::memory_order_acquire) &&
+            !restart_.load(std::memory_order_acquire)) {
+            tick(next_tick, now);
+
+            // Absolute schedule: the next deadline is derived from the previous
+            // deadline, never from the wake-up time, so lateness doesn't accumulate
+            uint32_t period = period_ns_.load(std::memory_order_relaxed);
+            next_tick += period;
+
+            if (now > next_tick + static_cast<uint64_t>(period) * MAX_CATCHUP_PERIODS) {
+                missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+                next_tick = now + period;
+            }
+        }
+
+        if (scheduler_) {
+            scheduler_->releaseDue(now);
+        }
+    }
+}
+
+void MidiClockThread::tick(uint64_t deadline_ns, uint64_t now_ns) {
+    recordLateness(static_cast<int64_t>(now_ns - deadline_ns));
+
+    if (tick_callback_) {
+        tick_callback_();
+    }
+
+    uint32_t position = tick_count_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (scheduler_) {
+        scheduler_->releaseTick(position);
+    }
+
+    pending_ticks_.fetch_add(1, std::memory_order_release);
+}
+
+void MidiClockThread::recordLateness(int64_t lateness_ns) {
+    if (reset_stats_.exchange(false, std::memory_order_acq_rel)) {
+        clearStats();
+    }
+
+    int32_t lateness_us = static_cast<int32_t>(lateness_ns / 1000);
+    uint32_t samples = samples_.load(std::memory_order_relaxed);
+
+    if (samples == 0 || lateness_us < min_us_.load(std::memory_order_relaxed)) {
+        min_us_.store(lateness_us, std::memory_order_relaxed);
+    }
+    if (samples == 0 || lateness_us > max_us_.load(std::memory_order_relaxed)) {
+        max_us_.store(lateness_us, std::memory_order_relaxed);
+    }
+
+    int bin = std::clamp(lateness_us / HISTOGRAM_BIN_US, 0, HISTOGRAM_BINS - 1);
+    histogram_[bin].fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(static_cast<uint32_t>(std::max(lateness_us, 0)), std::memory_order_relaxed);
+    samples_.store(samples + 1, std::memory_order_release);
+}
+
+void MidiClockThread::clearStats() {
+    for (auto& bin : histogram_) {
+        bin.store(0, std::memory_order_relaxed);
+    }
+    min_us_.store(0, std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+    sum_us_.store(0, std::memory_order_relaxed);
+    samples_.store(0, std::memory_order_release);
+}
+
+MidiClockThread::JitterStats MidiClockThread::getJitterStats() const {
+    JitterStats stats;
+    stats.samples = samples_.load(std::memory_order_acquire);
+    if (stats.samples == 0) return stats;
+
+    stats.min_us = min_us_.load(std::memory_order_relaxed);
+    stats.max_us = max_us_.load(std::memory_order_relaxed);
+    stats.mean_us = static_cast<float>(sum_us_.load(std::memory_order_relaxed)) / stats.samples;
+
+    // Walk the histogram up to the 99th percentile
+    uint32_t target = stats.samples - stats.samples / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < HISTOGRAM_BINS; ++i) {
+        seen += histogram_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            stats.p99_us = std::min((i + 1) * HISTOGRAM_BIN_US, stats.max_us);
+            break;
+        }
+    }
+
+    return stats;
+}
+
+#if defined(ESP32_BUILD)
+
+void MidiClockThread::taskEntry(void* arg) {
+    auto* self = static_cast<MidiClockThread*>(arg);
+    self->run();
+    self->task_exited_.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+
+void MidiClockThread::timerCallback(void* arg) {
+    auto* self = static_cast<MidiClockThread*>(arg);
+    if (self->task_handle_) {
+        xTaskNotifyGive(self->task_handle_);
+    }
+}
+
+bool MidiClockThread::waitUntil(uint64_t deadline_ns) {
+    if (!deadline_timer_) return false;
+
+    // Re-derive the relative timeout from the absolute deadline each time;
+    // loop so a stray notification can't produce an early tick
+    while (running_.load(std::memory_order_acquire)) {
+        if (wake_pending_.exchange(false, std::memory_order_acq_rel)) return false;
+
+        uint64_t now = nowNs();
+        if (now >= deadline_ns) return true;
+
+        esp_timer_stop(deadline_timer_);
+        esp_timer_start_once(deadline_timer_, (deadline_ns - now + 999ULL) / 1000ULL);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    return false;
+}
+
+void MidiClockThread::waitForWork() {
+    while (running_.load(std::memory_order_acquire) &&
+           !wake_pending_.exchange(false, std::memory_order_acq_rel)) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+void MidiClockThread::wake() {
+    wake_pending_.store(true, std::memory_order_release);
+    if (task_handle_) {
+        xTaskNotifyGive(task_handle_);
+    }
+}
+
+#else
+
+bool MidiClockThread::waitUntil(uint64_t deadline_ns) {
+    // Coarse part: interruptible by wake()
+    uint64_t now = nowNs();
+    if (deadline_ns > now + PRECISE_SLEEP_NS) {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        bool woken = wake_cv_.wait_for(lock, std::chrono::nanoseconds(deadline_ns - now - PRECISE_SLEEP_NS), [this] {
+            return wake_pending_.load(std::memory_order_acquire) || !running_.load(std::memory_order_acquire);
+        });
+        if (woken) {
+            wake_pending_.store(false, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // Precise part: absolute sleep, resuming after EINTR keeps the same deadline
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000ULL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+    return true;
+}
+
+void MidiClockThread::waitForWork() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait(lock, [this] {
+        return wake_pending_.load(std::memory_order_acquire) || !running_.load(std::memory_order_acquire);
+    });
+    wake_pending_.store(false, std::memory_order_relaxed);
+}
+
+void MidiClockThread::wake() {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_pending_.store(true, std::memory_order_release);
+    wake_cv_.notify_one();
+}
+
+#endif
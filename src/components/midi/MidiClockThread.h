@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "MidiTime.h"
+#include "SpscRing.h"
+
+class MidiEventScheduler;
+
+#if defined(ESP32_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_timer.h>
+#else
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/**
+ * @brief High-resolution internal MIDI clock
+ *
+ * Generates clock ticks on a dedicated thread against absolute deadlines
+ * (next = previous deadline + period), so ticks neither drift nor get
+ * quantized to the UI loop's frame time. The tick callback runs on the clock
+ * thread and must not touch LVGL; the UI picks up ticks with takeTicks().
+ *
+ * Desktop: std::thread sleeping with clock_nanosleep(TIMER_ABSTIME).
+ * ESP32: high-priority FreeRTOS task woken by a one-shot esp_timer armed for
+ * each deadline.
+ *
+ * Every tick's lateness (wake time - deadline) is recorded in a histogram
+ * exposed through getJitterStats().
+ *
+ * An optional MidiEventScheduler is serviced on the same thread: the thread
+ * sleeps until the earlier of the next tick and the next timed event, and
+ * tick-based events are released right after their tick's clock pulse.
+ * While following an external clock the thread doesn't tick; the UI hands it
+ * each received pulse with externalTick() and it releases tick-based events
+ * at that position instead.
+ */
+class MidiClockThread {
+public:
+    using TickCallback = std::function<void()>;
+
+    struct JitterStats {
+        uint32_t samples = 0;
+        int32_t min_us = 0;
+        int32_t max_us = 0;
+        int32_t p99_us = 0;    // Upper edge of the histogram bin holding the 99th percentile
+        float mean_us = 0.0f;
+    };
+
+    MidiClockThread();
+    ~MidiClockThread();
+
+    MidiClockThread(const MidiClockThread&) = delete;
+    MidiClockThread& operator=(const MidiClockThread&) = delete;
+
+    // Called on the clock thread for every tick. Set before start().
+    void setTickCallback(TickCallback callback) { tick_callback_ = callback; }
+    void setScheduler(MidiEventScheduler* scheduler) { scheduler_ = scheduler; }
+
+    void start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Begin ticking one period from now / stop ticking (thread stays alive).
+    // reset_position restarts the tick count (Start rather than Continue).
+    void startTicking(bool reset_position);
+    void stopTicking();
+    bool isTicking() const { return ticking_.load(std::memory_order_acquire); }
+
+    // Ticks generated since the last position reset (first tick = 1)
+    uint32_t getTickCount() const { return tick_count_.load(std::memory_order_acquire); }
+
+    // UI side, external clock: a pulse was received and the song position is
+    // now `position` (first pulse after Start = 1). Releases the tick-based
+    // events due at it. Returns false if the thread is too far behind.
+    bool externalTick(uint32_t position);
+
+    // Make the thread re-evaluate its next deadline (e.g. after scheduling)
+    void wake();
+
+    // Takes effect from the next deadline, so tempo changes are glitch-free
+    void setPeriodNs(uint32_t period_ns);
+    uint32_t getPeriodNs() const { return period_ns_.load(std::memory_order_relaxed); }
+
+    // UI side: number of ticks generated since the last call
+    uint32_t takeTicks() { return pending_ticks_.exchange(0, std::memory_order_acq_rel); }
+
+    // Statistics (safe to call from any thread)
+    JitterStats getJitterStats() const;
+    void resetJitterStats() { reset_stats_.store(true, std::memory_order_release); }
+    uint32_t getMissedDeadlines() const { return missed_deadlines_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int HISTOGRAM_BINS = 512;
+    static constexpr int HISTOGRAM_BIN_US = 10;   // 0 - 5.12 ms, last bin catches the rest
+    static constexpr size_t EXTERNAL_TICK_CAPACITY = 64;
+
+    static uint64_t nowNs() { return MidiTime::nowNs(); }
+
+    void run();
+    void tick(uint64_t deadline_ns, uint64_t now_ns);
+    bool waitUntil(uint64_t deadline_ns);
+    void waitForWork();
+    void recordLateness(int64_t lateness_ns);
+    void clearStats();
+
+    TickCallback tick_callback_;
+    MidiEventScheduler* scheduler_ = nullptr;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> ticking_{false};
+    std::atomic<bool> restart_{false};
+    std::atomic<bool> reset_position_{false};
+    std::atomic<bool> wake_pending_{false};
+    std::atomic<uint32_t> tick_count_{0};
+    std::atomic<uint32_t> period_ns_{20833333};   // 120 BPM @ 24 PPQN
+    std::atomic<uint32_t> pending_ticks_{0};
+    std::atomic<uint32_t> missed_deadlines_{0};
+    SpscRing<uint32_t, EXTERNAL_TICK_CAPACITY> external_ticks_;   // UI -> clock thread
+
+    // Written only by the clock thread
+    std::atomic<uint32_t> histogram_[HISTOGRAM_BINS] = {};
+    std::atomic<uint32_t> samples_{0};
+    std::atomic<int32_t> min_us_{0};
+    std::atomic<int32_t> max_us_{0};
+    std::atomic<uint32_t> sum_us_{0};
+    std::atomic<bool> reset_stats_{false};
+
+#if defined(ESP32_BUILD)
+    static void taskEntry(void* arg);
+    static void timerCallback(void* arg);
+    TaskHandle_t task_handle_ = nullptr;
+    esp_timer_handle_t deadline_timer_ = nullptr;
+    std::atomic<bool> task_exited_{true};
+#else
+    std::thread thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+#endif
+};
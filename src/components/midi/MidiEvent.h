@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Fixed-size MIDI message
+ *
+ * Holds a complete channel voice, system common or real-time message inline
+ * (up to 3 bytes), so messages can be built on the stack and handed straight
+ * to a backend as a (pointer, length) pair without any heap allocation.
+ *
+ * Channels passed to the factory helpers are 0-based (0-15), matching the
+ * low nibble of the status byte.
+ */
+struct MidiEvent {
+    uint8_t bytes[3] = {0, 0, 0};
+    uint8_t length = 0;
+
+    uint8_t status() const { return bytes[0]; }
+    uint8_t data1() const { return bytes[1]; }
+    uint8_t data2() const { return bytes[2]; }
+    uint8_t type() const { return bytes[0] & 0xF0; }
+    uint8_t channel() const { return bytes[0] & 0x0F; }
+    bool isRealTime() const { return bytes[0] >= 0xF8; }
+    bool isChannelMessage() const { return bytes[0] >= 0x80 && bytes[0] < 0xF0; }
+
+    // Number of bytes (including status) a message with this status byte occupies
+    static constexpr uint8_t lengthForStatus(uint8_t status) {
+        switch (status & 0xF0) {
+            case 0x80: // Note Off
+            case 0x90: // Note On
+            case 0xA0: // Poly Aftertouch
+            case 0xB0: // Control Change
+            case 0xE0: // Pitch Bend
+                return 3;
+            case 0xC0: // Program Change
+            case 0xD0: // Channel Aftertouch
+                return 2;
+            default:
+                break;
+        }
+
+        switch (status) {
+            case 0xF1: // MTC Quarter Frame
+            case 0xF3: // Song Select
+                return 2;
+            case 0xF2: // Song Position Pointer
+                return 3;
+            default:
+                return 1; // Tune request, real-time and anything we don't decode
+        }
+    }
+
+    static MidiEvent make(uint8_t status, uint8_t data1 = 0, uint8_t data2 = 0) {
+        MidiEvent event;
+        event.bytes[0] = status;
+        event.bytes[1] = data1 & 0x7F;
+        event.bytes[2] = data2 & 0x7F;
+        event.length = lengthForStatus(status);
+        return event;
+    }
+
+    static MidiEvent noteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+        return make(0x90 | (channel & 0x0F), note, velocity);
+    }
+
+    static MidiEvent noteOff(uint8_t channel, uint8_t note, uint8_t velocity = 0) {
+        return make(0x80 | (channel & 0x0F), note, velocity);
+    }
+
+    static MidiEvent controlChange(uint8_t channel, uint8_t cc, uint8_t value) {
+        return make(0xB0 | (channel & 0x0F), cc, value);
+    }
+
+    static MidiEvent programChange(uint8_t channel, uint8_t program) {
+        return make(0xC0 | (channel & 0x0F), program);
+    }
+
+    static MidiEvent pitchBend(uint8_t channel, uint16_t value) {
+        return make(0xE0 | (channel & 0x0F), value & 0x7F, (value >> 7) & 0x7F);
+    }
+
+    static MidiEvent realTime(uint8_t status) {
+        return make(status);
+    }
+};
+
+static_assert(sizeof(MidiEvent) == 4, "MidiEvent must stay packed into 4 bytes");
+
+/**
+ * @brief Received message stamped with its arrival time (MidiTime::nowUs())
+ *
+ * The timestamp is taken on the I/O thread that decoded the message, so
+ * clock-following code sees the wire timing rather than UI loop latency.
+ */
+struct TimedMidiEvent {
+    MidiEvent event;
+    uint64_t timestamp_us = 0;
+};
@@ -0,0 +1,87 @@
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "MidiEventBenchmark.h"
+#include "MidiEvent.h"
+#include "MidiTime.h"
+#include "components/profiling/AllocationCounter.h"
+#include "hardware/MidiHandler.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+    // Stands in for the driver call: reads every byte so nothing is optimised out
+    volatile uint32_t sink_checksum = 0;
+
+    void consume(const unsigned char* bytes, size_t length) {
+        uint32_t sum = sink_checksum;
+        for (size_t i = 0; i < length; ++i) {
+            sum += bytes[i];
+        }
+        sink_checksum = sum;
+    }
+
+    struct Result {
+        double per_message_ns;
+        double allocations_per_message;
+    };
+
+    template <typename Send>
+    Result measure(size_t count, Send send) {
+        uint64_t allocations_before = allocationCount();
+        uint64_t start = MidiTime::nowNs();
+        for (size_t i = 0; i < count; ++i) {
+            send(static_cast<uint8_t>(i & 0x0F), static_cast<uint8_t>(i % 120), static_cast<uint8_t>(i & 0x7F));
+        }
+        Result result;
+        result.per_message_ns = double(MidiTime::nowNs() - start) / count;
+        result.allocations_per_message = double(allocationCount() - allocations_before) / count;
+        return result;
+    }
+
+    void print(const char* label, const Result& result) {
+        if (ALLOCATION_COUNTING) {
+            std::printf("  %-10s %8.1f ns/message   %5.2f allocations/message\n",
+                        label, result.per_message_ns, result.allocations_per_message);
+        } else {
+            std::printf("  %-10s %8.1f ns/message\n", label, result.per_message_ns);
+        }
+    }
+}
+
+void runMidiEventBenchmark(size_t count) {
+    if (count == 0) count = 1;
+
+    Result vector_result = measure(count, [](uint8_t channel, uint8_t cc, uint8_t value) {
+        std::vector<unsigned char> message;
+        message.push_back(0xB0 | channel);
+        message.push_back(cc);
+        message.push_back(value);
+        consume(message.data(), message.size());
+    });
+
+    Result event_result = measure(count, [](uint8_t channel, uint8_t cc, uint8_t value) {
+        MidiEvent event = MidiEvent::controlChange(channel, cc, value);
+        consume(event.bytes, event.length);
+    });
+
+    std::printf("=== MIDI Event Benchmark: %zu Control Change messages ===\n", count);
+    print("vector:", vector_result);
+    print("MidiEvent:", event_result);
+    if (!ALLOCATION_COUNTING) {
+        std::printf("  (allocations are only counted in the desktop_bench build)\n");
+    }
+    std::fflush(stdout);
+
+    MidiHandler handler;
+    if (!handler.initialize()) {
+        std::printf("  sendEvent: skipped (no MIDI output could be opened)\n");
+        std::fflush(stdout);
+        return;
+    }
+    print("sendEvent:", measure(count, [&handler](uint8_t channel, uint8_t cc, uint8_t value) {
+        handler.sendEvent(MidiEvent::controlChange(channel, cc, value));
+    }));
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,22 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <cstddef>
+
+/**
+ * @brief Per-message cost of building and sending desktop MIDI output
+ *
+ * Sends `count` Control Change messages three ways and reports time and
+ * (in the desktop_bench build, see AllocationCounter.h) heap allocations
+ * per message for each:
+ * - vector:    a std::vector<unsigned char> per message, as MidiHandler
+ *              built them before MidiEvent
+ * - MidiEvent: built on the stack and handed on as (pointer, length)
+ * - sendEvent: MidiHandler::sendEvent() into RtMidi (virtual port unless a
+ *              device is found); skipped when no MIDI output can be opened
+ * Run with --bench-midi.
+ */
+void runMidiEventBenchmark(size_t count);
+
+#endif // !ESP32_BUILD
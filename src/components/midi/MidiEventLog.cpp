@@ -0,0 +1,282 @@
+#if !defined(ESP32_BUILD)
+
+#include "MidiEventLog.h"
+#include "MidiTime.h"
+#include "components/log/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr uint64_t TIME_MASK = (1ULL << 40) - 1;
+    constexpr uint8_t OUT_FLAG = 0x80;
+
+    // SMF timing: 500000 us per quarter at 500 ticks per quarter = 1 ms/tick
+    constexpr uint16_t SMF_DIVISION = 500;
+    constexpr uint32_t SMF_TEMPO_US = 500000;
+
+    void putBE32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putVarLen(std::vector<uint8_t>& out, uint32_t value) {
+        uint8_t buffer[5];
+        int n = 0;
+        buffer[n++] = value & 0x7F;
+        while (value >>= 7) {
+            buffer[n++] = 0x80 | (value & 0x7F);
+        }
+        while (n > 0) {
+            out.push_back(buffer[--n]);
+        }
+    }
+}
+
+constexpr char MidiEventLog::MAGIC[8];
+
+uint64_t MidiEventLog::pack(uint64_t time_us, Direction direction, const MidiEvent& event) {
+    uint8_t data1 = event.data1() & 0x7F;
+    if (direction == Direction::OUT) data1 |= OUT_FLAG;
+
+    return ((time_us & TIME_MASK) << 24) |
+           (static_cast<uint64_t>(event.status()) << 16) |
+           (static_cast<uint64_t>(data1) << 8) |
+           event.data2();
+}
+
+MidiEventLog::Record MidiEventLog::unpack(uint64_t packed) {
+    uint8_t status = static_cast<uint8_t>(packed >> 16);
+    uint8_t data1 = static_cast<uint8_t>(packed >> 8);
+
+    Record record;
+    record.time_us = packed >> 24;
+    record.direction = (data1 & OUT_FLAG) ? Direction::OUT : Direction::IN;
+    record.event = MidiEvent::make(status, data1 & 0x7F, static_cast<uint8_t>(packed));
+    return record;
+}
+
+MidiEventLog::~MidiEventLog() {
+    close();
+}
+
+bool MidiEventLog::open(const std::string& path, size_t capacity_records) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        LOG_ERROR("MidiEventLog", "Cannot create %s", path.c_str());
+        return false;
+    }
+
+    size_t size = HEADER_SIZE + capacity_records * RECORD_SIZE;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        LOG_ERROR("MidiEventLog", "Cannot size %s to %zu bytes", path.c_str(), size);
+        ::close(fd);
+        return false;
+    }
+
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        LOG_ERROR("MidiEventLog", "Cannot map %s", path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    path_ = path;
+    fd_ = fd;
+    map_ = static_cast<uint8_t*>(map);
+    map_size_ = size;
+    records_ = reinterpret_cast<uint64_t*>(map_ + HEADER_SIZE);
+    capacity_ = capacity_records;
+    start_us_ = MidiTime::nowUs();
+
+    std::memcpy(map_, MAGIC, sizeof(MAGIC));
+    std::memcpy(map_ + sizeof(MAGIC), &start_us_, sizeof(start_us_));
+
+    next_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    open_.store(true, std::memory_order_seq_cst);
+
+    LOG_INFO("MidiEventLog", "Recording to %s (%zu records max)", path.c_str(), capacity_records);
+    return true;
+}
+
+void MidiEventLog::close() {
+    if (!open_.exchange(false, std::memory_order_seq_cst)) return;
+
+    // Appends that saw open_ == true may still be storing into the mapping
+    while (writers_.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+
+    uint64_t count = getRecordCount();
+    munmap(map_, map_size_);
+    if (ftruncate(fd_, static_cast<off_t>(HEADER_SIZE + count * RECORD_SIZE)) != 0) {
+        LOG_WARN("MidiEventLog", "Cannot trim %s", path_.c_str());
+    }
+    ::close(fd_);
+
+    LOG_INFO("MidiEventLog", "Closed %s: %llu records, %u dropped", path_.c_str(),
+             static_cast<unsigned long long>(count), getDroppedCount());
+
+    fd_ = -1;
+    map_ = nullptr;
+    records_ = nullptr;
+    map_size_ = 0;
+    capacity_ = 0;
+}
+
+void MidiEventLog::append(Direction direction, const MidiEvent& event, uint64_t timestamp_us) {
+    writers_.fetch_add(1, std::memory_order_seq_cst);
+    if (open_.load(std::memory_order_seq_cst)) {
+        uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+        if (index < capacity_) {
+            uint64_t time_us = timestamp_us > start_us_ ? timestamp_us - start_us_ : 0;
+            records_[index] = pack(time_us, direction, event);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    writers_.fetch_sub(1, std::memory_order_release);
+}
+
+uint64_t MidiEventLog::getRecordCount() const {
+    return std::min<uint64_t>(next_.load(std::memory_order_relaxed), capacity_);
+}
+
+MidiEventLogReader::~MidiEventLogReader() {
+    close();
+}
+
+bool MidiEventLogReader::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("MidiEventLog", "Cannot open %s", path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < MidiEventLog::HEADER_SIZE) {
+        LOG_ERROR("MidiEventLog", "%s is not a MIDI event log", path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);   // The mapping keeps the file alive
+    if (map == MAP_FAILED) {
+        LOG_ERROR("MidiEventLog", "Cannot map %s", path.c_str());
+        return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(map);
+    if (std::memcmp(bytes, MidiEventLog::MAGIC, sizeof(MidiEventLog::MAGIC)) != 0) {
+        LOG_ERROR("MidiEventLog", "%s is not a MIDI event log", path.c_str());
+        munmap(map, size);
+        return false;
+    }
+
+    map_ = bytes;
+    map_size_ = size;
+    std::memcpy(&start_us_, bytes + sizeof(MidiEventLog::MAGIC), sizeof(start_us_));
+
+    // Count up to the first empty record (log still open or not closed cleanly)
+    const uint64_t* records = reinterpret_cast<const uint64_t*>(map_ + MidiEventLog::HEADER_SIZE);
+    size_t capacity = (size - MidiEventLog::HEADER_SIZE) / MidiEventLog::RECORD_SIZE;
+    count_ = 0;
+    while (count_ < capacity && ((records[count_] >> 16) & 0xFF) != 0) {
+        count_++;
+    }
+    return true;
+}
+
+void MidiEventLogReader::close() {
+    if (map_) {
+        munmap(const_cast<uint8_t*>(map_), map_size_);
+    }
+    map_ = nullptr;
+    map_size_ = 0;
+    count_ = 0;
+}
+
+MidiEventLog::Record MidiEventLogReader::get(size_t index) const {
+    const uint64_t* records = reinterpret_cast<const uint64_t*>(map_ + MidiEventLog::HEADER_SIZE);
+    return MidiEventLog::unpack(records[index]);
+}
+
+bool MidiEventLogReader::exportSmf(const std::string& smf_path, bool include_in, bool include_out) const {
+    if (!isOpen()) return false;
+
+    // The UI and clock threads record concurrently, so file order can be a
+    // few microseconds off time order; SMF deltas must not go negative
+    std::vector<MidiEventLog::Record> events;
+    events.reserve(count_);
+    for (size_t i = 0; i < count_; ++i) {
+        MidiEventLog::Record record = get(i);
+        bool wanted = record.direction == MidiEventLog::Direction::IN ? include_in : include_out;
+        if (wanted && record.event.status() < 0xF0) {
+            events.push_back(record);
+        }
+    }
+    std::stable_sort(events.begin(), events.end(),
+        [](const MidiEventLog::Record& a, const MidiEventLog::Record& b) {
+            return a.time_us < b.time_us;
+        });
+
+    std::vector<uint8_t> track;
+    track.reserve(events.size() * 4 + 16);
+
+    // Tempo meta event so the tick length is explicit
+    const uint8_t tempo[] = {0x00, 0xFF, 0x51, 0x03,
+                             static_cast<uint8_t>(SMF_TEMPO_US >> 16),
+                             static_cast<uint8_t>(SMF_TEMPO_US >> 8),
+                             static_cast<uint8_t>(SMF_TEMPO_US)};
+    track.insert(track.end(), tempo, tempo + sizeof(tempo));
+
+    uint64_t last_tick = 0;
+    for (const auto& record : events) {
+        uint64_t tick = record.time_us / 1000;
+        putVarLen(track, static_cast<uint32_t>(tick - last_tick));
+        last_tick = tick;
+        track.insert(track.end(), record.event.bytes, record.event.bytes + record.event.length);
+    }
+
+    const uint8_t end_of_track[] = {0x00, 0xFF, 0x2F, 0x00};
+    track.insert(track.end(), end_of_track, end_of_track + sizeof(end_of_track));
+
+    std::vector<uint8_t> file = {'M', 'T', 'h', 'd', 0, 0, 0, 6,
+                                 0, 0,    // Format 0
+                                 0, 1,    // One track
+                                 static_cast<uint8_t>(SMF_DIVISION >> 8),
+                                 static_cast<uint8_t>(SMF_DIVISION & 0xFF),
+                                 'M', 'T', 'r', 'k'};
+    putBE32(file, static_cast<uint32_t>(track.size()));
+    file.insert(file.end(), track.begin(), track.end());
+
+    FILE* out = std::fopen(smf_path.c_str(), "wb");
+    if (!out) {
+        LOG_ERROR("MidiEventLog", "Cannot create %s", smf_path.c_str());
+        return false;
+    }
+    bool ok = std::fwrite(file.data(), 1, file.size(), out) == file.size();
+    ok = (std::fclose(out) == 0) && ok;
+
+    LOG_INFO("MidiEventLog", "Exported %zu events to %s", events.size(), smf_path.c_str());
+    return ok;
+}
+
+#endif // !ESP32_BUILD
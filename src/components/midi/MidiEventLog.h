@@ -0,0 +1,119 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)
+
+#include "MidiEvent.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Append-only binary log of MIDI traffic (desktop only)
+ *
+ * File layout: a 16-byte header ("MIDILOG1" + MidiTime microseconds at which
+ * recording started) followed by fixed 8-byte records, one per message.
+ * Each record is a little-endian uint64:
+ *
+ *   bits 63..24  microseconds since the start of the log (40 bits, ~12 days)
+ *   bits 23..16  status byte
+ *   bits 15..8   data1, with bit 15 set for outgoing messages
+ *   bits  7..0   data2
+ *
+ * Data bytes are 7-bit, so the direction flag costs nothing. A record whose
+ * status byte is 0 marks the end of a log that was not closed cleanly.
+ *
+ * The file is sized to the requested capacity up front (sparse, so unused
+ * space costs nothing on disk) and mapped once; append() is a fetch_add and
+ * a store into the mapping, so the UI and clock threads can both record
+ * without locks or syscalls. When the capacity is reached further messages
+ * are counted as dropped. close() trims the file to the records written.
+ */
+class MidiEventLog {
+public:
+    static constexpr char MAGIC[8] = {'M', 'I', 'D', 'I', 'L', 'O', 'G', '1'};
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t RECORD_SIZE = 8;
+    static constexpr size_t DEFAULT_CAPACITY = 8 * 1024 * 1024;   // Records (64 MiB)
+
+    enum class Direction : uint8_t {
+        IN,
+        OUT
+    };
+
+    struct Record {
+        uint64_t time_us;          // Since the start of the log
+        Direction direction;
+        MidiEvent event;
+    };
+
+    static uint64_t pack(uint64_t time_us, Direction direction, const MidiEvent& event);
+    static Record unpack(uint64_t packed);
+
+    MidiEventLog() = default;
+    ~MidiEventLog();
+    MidiEventLog(const MidiEventLog&) = delete;
+    MidiEventLog& operator=(const MidiEventLog&) = delete;
+
+    // Create (truncating) the log file. Not thread-safe against append().
+    bool open(const std::string& path, size_t capacity_records = DEFAULT_CAPACITY);
+    // Stop recording, wait for in-flight appends and trim the file
+    void close();
+    bool isOpen() const { return open_.load(std::memory_order_acquire); }
+
+    // Any thread. timestamp_us is MidiTime::nowUs().
+    void append(Direction direction, const MidiEvent& event, uint64_t timestamp_us);
+
+    uint64_t getRecordCount() const;
+    uint32_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    const std::string& getPath() const { return path_; }
+
+private:
+    std::string path_;
+    int fd_ = -1;
+    uint8_t* map_ = nullptr;
+    size_t map_size_ = 0;
+    uint64_t* records_ = nullptr;
+    size_t capacity_ = 0;
+    uint64_t start_us_ = 0;
+
+    std::atomic<bool> open_{false};
+    std::atomic<int> writers_{0};
+    std::atomic<uint64_t> next_{0};
+    std::atomic<uint32_t> dropped_{0};
+};
+
+/**
+ * @brief Read-only view of a MidiEventLog file
+ *
+ * Maps the file and decodes records on demand. Works on logs that are still
+ * being written or were not closed cleanly (stops at the first empty record).
+ */
+class MidiEventLogReader {
+public:
+    MidiEventLogReader() = default;
+    ~MidiEventLogReader();
+    MidiEventLogReader(const MidiEventLogReader&) = delete;
+    MidiEventLogReader& operator=(const MidiEventLogReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return map_ != nullptr; }
+
+    size_t size() const { return count_; }
+    MidiEventLog::Record get(size_t index) const;
+    uint64_t getStartUs() const { return start_us_; }
+
+    // Write a Standard MIDI File (format 0, 1 tick = 1 ms). Realtime and
+    // system messages have no place in an SMF track and are skipped.
+    bool exportSmf(const std::string& smf_path, bool include_in = true, bool include_out = true) const;
+
+private:
+    const uint8_t* map_ = nullptr;
+    size_t map_size_ = 0;
+    size_t count_ = 0;
+    uint64_t start_us_ = 0;
+};
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,108 @@
+#if !defined(ESP32_BUILD)
+
+#include "MidiEventReplayer.h"
+#include "MidiEventLog.h"
+#include "MidiTime.h"
+#include "components/log/Log.h"
+
+#include <algorithm>
+#include <time.h>
+
+namespace {
+    // Long waits are split so stop() is honoured promptly
+    constexpr uint64_t MAX_SLEEP_NS = 10 * 1000 * 1000;
+    // Back-off while the consumer's ring is full
+    constexpr uint64_t FULL_RETRY_NS = 100 * 1000;
+}
+
+MidiEventReplayer::~MidiEventReplayer() {
+    stop();
+}
+
+bool MidiEventReplayer::start(const std::string& path, const Options& options, Sink sink) {
+    stop();
+
+    if (!sink || options.speed < 0.0) return false;
+
+    sink_ = sink;
+    replayed_.store(0, std::memory_order_relaxed);
+    elapsed_us_.store(0, std::memory_order_relaxed);
+    stop_requested_.store(false, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MidiEventReplayer::run, this, path, options);
+    return true;
+}
+
+void MidiEventReplayer::stop() {
+    stop_requested_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+bool MidiEventReplayer::sleepUntilNs(uint64_t deadline_ns) {
+    while (!stop_requested_.load(std::memory_order_acquire)) {
+        uint64_t now = MidiTime::nowNs();
+        if (now >= deadline_ns) return true;
+
+        uint64_t target = std::min(deadline_ns, now + MAX_SLEEP_NS);
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(target / 1000000000ULL);
+        ts.tv_nsec = static_cast<long>(target % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+    }
+    return false;
+}
+
+void MidiEventReplayer::run(std::string path, Options options) {
+    MidiEventLogReader reader;
+    if (!reader.open(path)) {
+        running_.store(false, std::memory_order_release);
+        return;
+    }
+
+    LOG_INFO("MidiReplay", "Replaying %zu records from %s at %s", reader.size(), path.c_str(),
+             options.speed > 0.0 ? "recorded pace" : "full speed");
+
+    const uint64_t start_ns = MidiTime::nowNs();
+    bool have_origin = false;
+    uint64_t origin_us = 0;
+
+    for (size_t i = 0; i < reader.size() && !stop_requested_.load(std::memory_order_acquire); ++i) {
+        MidiEventLog::Record record = reader.get(i);
+        if (record.direction == MidiEventLog::Direction::OUT && !options.include_outgoing) continue;
+
+        if (!have_origin) {
+            origin_us = record.time_us;
+            have_origin = true;
+        }
+
+        if (options.speed > 0.0 && record.time_us > origin_us) {
+            uint64_t offset_ns = static_cast<uint64_t>((record.time_us - origin_us) * 1000.0 / options.speed);
+            if (!sleepUntilNs(start_ns + offset_ns)) break;
+        }
+
+        TimedMidiEvent timed;
+        timed.event = record.event;
+        timed.timestamp_us = MidiTime::nowUs();
+        while (!sink_(timed)) {
+            if (!sleepUntilNs(MidiTime::nowNs() + FULL_RETRY_NS)) break;
+        }
+        if (stop_requested_.load(std::memory_order_acquire)) break;
+
+        replayed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t elapsed_us = (MidiTime::nowNs() - start_ns) / 1000;
+    elapsed_us_.store(elapsed_us, std::memory_order_relaxed);
+
+    uint32_t count = getReplayedCount();
+    LOG_INFO("MidiReplay", "Replayed %u events in %llu us (%.0f events/s)", count,
+             static_cast<unsigned long long>(elapsed_us),
+             elapsed_us ? count * 1e6 / elapsed_us : 0.0);
+
+    running_.store(false, std::memory_order_release);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,60 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)
+
+#include "MidiEvent.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Plays a MidiEventLog back into the input pipeline (desktop only)
+ *
+ * Runs on its own thread and hands each recorded message to a sink, stamped
+ * with the current MidiTime, as if it had just arrived from a port. Pacing
+ * follows the recorded timestamps scaled by the speed factor; speed 0 means
+ * as fast as the consumer drains the sink, which makes a replay a
+ * repeatable throughput benchmark for the UI-thread input path.
+ *
+ * Only incoming messages are replayed unless include_outgoing is set (e.g. to
+ * drive parameter dispatch with a recorded dial gesture).
+ */
+class MidiEventReplayer {
+public:
+    // Returns false when the consumer is full; the replayer retries
+    using Sink = std::function<bool(const TimedMidiEvent& event)>;
+
+    struct Options {
+        double speed = 1.0;            // 1 = real time, N = N times faster, 0 = unpaced
+        bool include_outgoing = false;
+    };
+
+    MidiEventReplayer() = default;
+    ~MidiEventReplayer();
+    MidiEventReplayer(const MidiEventReplayer&) = delete;
+    MidiEventReplayer& operator=(const MidiEventReplayer&) = delete;
+
+    bool start(const std::string& path, const Options& options, Sink sink);
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Results of the current / last replay
+    uint32_t getReplayedCount() const { return replayed_.load(std::memory_order_relaxed); }
+    uint64_t getElapsedUs() const { return elapsed_us_.load(std::memory_order_relaxed); }
+
+private:
+    void run(std::string path, Options options);
+    bool sleepUntilNs(uint64_t deadline_ns);
+
+    Sink sink_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<uint32_t> replayed_{0};
+    std::atomic<uint64_t> elapsed_us_{0};
+};
+
+#endif // !ESP32_BUILD
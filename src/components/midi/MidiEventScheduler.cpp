@@ -0,0 +1,75 @@
+#include "MidiEventScheduler.h"
+#include <algorithm>
+
+MidiEventScheduler::MidiEventScheduler() {
+    // Reserve up front so the clock thread never allocates
+    timed_heap_.reserve(MAX_PENDING);
+    tick_heap_.reserve(MAX_PENDING);
+}
+
+bool MidiEventScheduler::scheduleAtUs(const MidiEvent& event, uint64_t time_us) {
+    return submit(Entry{time_us * 1000ULL, next_sequence_++, event, false});
+}
+
+bool MidiEventScheduler::scheduleAtTick(const MidiEvent& event, uint32_t tick) {
+    return submit(Entry{tick, next_sequence_++, event, true});
+}
+
+bool MidiEventScheduler::submit(const Entry& entry) {
+    if (!submit_queue_.push(entry)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void MidiEventScheduler::collect() {
+    if (clear_all_requested_.exchange(false, std::memory_order_acq_rel)) {
+        timed_heap_.clear();
+        tick_heap_.clear();
+    }
+    if (clear_ticks_requested_.exchange(false, std::memory_order_acq_rel)) {
+        tick_heap_.clear();
+    }
+
+    Entry entry;
+    while (submit_queue_.pop(entry)) {
+        insert(entry.by_tick ? tick_heap_ : timed_heap_, entry);
+    }
+}
+
+void MidiEventScheduler::insert(std::vector<Entry>& heap, const Entry& entry) {
+    if (heap.size() >= MAX_PENDING) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    heap.push_back(entry);
+    std::push_heap(heap.begin(), heap.end(), Later());
+}
+
+uint64_t MidiEventScheduler::nextTimedDeadlineNs() const {
+    return timed_heap_.empty() ? NO_DEADLINE : timed_heap_.front().when;
+}
+
+void MidiEventScheduler::releaseDue(uint64_t now_ns) {
+    while (!timed_heap_.empty() && timed_heap_.front().when <= now_ns) {
+        std::pop_heap(timed_heap_.begin(), timed_heap_.end(), Later());
+        emit(timed_heap_.back());
+        timed_heap_.pop_back();
+    }
+}
+
+void MidiEventScheduler::releaseTick(uint32_t tick) {
+    while (!tick_heap_.empty() && tick_heap_.front().when <= tick) {
+        std::pop_heap(tick_heap_.begin(), tick_heap_.end(), Later());
+        emit(tick_heap_.back());
+        tick_heap_.pop_back();
+    }
+}
+
+void MidiEventScheduler::emit(const Entry& entry) {
+    if (output_) {
+        output_(entry.event);
+    }
+    released_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "MidiEvent.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Timestamped MIDI event queue released by the clock thread
+ *
+ * The UI thread queues events ahead of time, either at an absolute time
+ * (MidiTime microseconds) or at a clock tick (song position in ticks since
+ * Start). Submissions go through a lock-free SPSC ring; the clock thread
+ * moves them into two min-heaps and releases each event at its deadline, so
+ * the UI can queue a whole bar and stay off the timing-critical path.
+ *
+ * Events with equal deadlines are released in submission order.
+ *
+ * Thread contract: schedule*() and clear*() from the UI thread only;
+ * collect(), nextTimedDeadlineNs() and release*() from the clock thread only.
+ */
+class MidiEventScheduler {
+public:
+    static constexpr size_t SUBMIT_CAPACITY = 512;
+    static constexpr size_t MAX_PENDING = 1024;
+    static constexpr uint64_t NO_DEADLINE = UINT64_MAX;
+
+    using OutputCallback = std::function<void(const MidiEvent& event)>;
+
+    MidiEventScheduler();
+
+    // Where released events go (called on the clock thread). Set before use.
+    void setOutputCallback(OutputCallback callback) { output_ = callback; }
+
+    // UI side. Return false if the submission ring is full.
+    bool scheduleAtUs(const MidiEvent& event, uint64_t time_us);
+    bool scheduleAtTick(const MidiEvent& event, uint32_t tick);
+
+    // UI side. Applied by the clock thread on its next collect().
+    void clearTickEvents() { clear_ticks_requested_.store(true, std::memory_order_release); }
+    void clearAll() { clear_all_requested_.store(true, std::memory_order_release); }
+
+    // Clock side
+    void collect();
+    uint64_t nextTimedDeadlineNs() const;
+    void releaseDue(uint64_t now_ns);
+    void releaseTick(uint32_t tick);
+
+    // Statistics
+    uint32_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    uint32_t getReleasedCount() const { return released_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint64_t when;      // ns for timed events, tick number for tick events
+        uint32_t sequence;
+        MidiEvent event;
+        bool by_tick;
+    };
+
+    // Min-heap ordering on (when, sequence)
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.when != b.when ? a.when > b.when : a.sequence > b.sequence;
+        }
+    };
+
+    bool submit(const Entry& entry);
+    void insert(std::vector<Entry>& heap, const Entry& entry);
+    void emit(const Entry& entry);
+
+    SpscRing<Entry, SUBMIT_CAPACITY> submit_queue_;
+    uint32_t next_sequence_ = 0;                 // UI side only
+
+    std::vector<Entry> timed_heap_;              // Clock side only
+    std::vector<Entry> tick_heap_;
+    OutputCallback output_;
+
+    std::atomic<bool> clear_ticks_requested_{false};
+    std::atomic<bool> clear_all_requested_{false};
+    std::atomic<uint32_t> dropped_{0};
+    std::atomic<uint32_t> released_{0};
+};
@@ -0,0 +1,178 @@
+#include "MidiOutputLimiter.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    // Bucket holds ~10 ms of budget so short bursts (a chord, a transport
+    // message next to a CC) still go out back to back
+    constexpr double BURST_SECONDS = 0.01;
+    constexpr double CC_BYTES = 3.0;
+
+    // Data entry (6, 38), increment / decrement (96, 97) and the NRPN / RPN
+    // selects (98-101) only mean something in the order they were sent
+    bool isSequenceController(uint8_t cc) {
+        return cc == 6 || cc == 38 || (cc >= 96 && cc <= 101);
+    }
+
+    bool isLsb(uint16_t slot) {
+        return slot % 128 >= 32 && slot % 128 < 64;
+    }
+}
+
+double MidiOutputLimiter::cost(const MidiEvent& event) {
+    uint8_t status = event.status();
+    if (status >= 0xF8) return 1.0;
+
+    double bytes = event.length;
+    if (status == running_status_) bytes -= 1.0;
+    running_status_ = status < 0xF0 ? status : 0;
+    return bytes;
+}
+
+void MidiOutputLimiter::setBudget(uint32_t bytes_per_second) {
+    if (bytes_per_second == budget_) return;
+
+    budget_ = bytes_per_second;
+    bucket_size_ = std::max(CC_BYTES, budget_ * BURST_SECONDS);
+    tokens_ = bucket_size_;
+    last_refill_ns_ = 0;
+}
+
+void MidiOutputLimiter::refill(uint64_t now_ns) {
+    if (last_refill_ns_ != 0 && now_ns > last_refill_ns_) {
+        tokens_ += (now_ns - last_refill_ns_) * 1e-9 * budget_;
+        tokens_ = std::min(tokens_, bucket_size_);
+    }
+    last_refill_ns_ = now_ns;
+}
+
+bool MidiOutputLimiter::admit(const MidiEvent& event, uint64_t now_ns) {
+    if (!isLimited()) return true;
+
+    refill(now_ns);
+
+    if (event.type() != 0xB0 || isSequenceController(event.data1())) {
+        // Never hold back notes, transport, clock or NRPN sequences (parking
+        // their CCs separately would reorder them); they may overdraw the bucket
+        if (event.type() == 0xB0) {
+            sent_msb_slot_ = NO_SLOT;
+        }
+        tokens_ -= cost(event);
+        return true;
+    }
+
+    int slot = event.channel() * 128 + event.data1();
+    bool completes_pair = slot - 32 == sent_msb_slot_;
+    sent_msb_slot_ = NO_SLOT;
+
+    if (event.data1() >= 32 && event.data1() < 64) {
+        if (completes_pair && !pending_[slot]) {
+            // LSB right behind the 14-bit MSB that was just sent: send it
+            // now, as parking it alone could let a later MSB overtake it
+            tokens_ -= cost(event);
+            return true;
+        }
+        if (pending_[slot - 32]) {
+            // Behind a parked MSB: parked too, and follows it out
+            park(event);
+            return false;
+        }
+        // Anything else on 32-63 is a plain CC
+    }
+    if (pending_[slot] || tokens_ < CC_BYTES) {
+        // An older value for this CC is still parked (sending now would let it
+        // overwrite us later), or we're over budget: keep only the latest
+        park(event);
+        return false;
+    }
+
+    tokens_ -= cost(event);
+    if (event.data1() < 32) {
+        sent_msb_slot_ = slot;   // Its LSB, if next, goes with it
+    }
+    return true;
+}
+
+void MidiOutputLimiter::park(const MidiEvent& event) {
+    int slot = event.channel() * 128 + event.data1();
+
+    if (pending_[slot]) {
+        coalesced_count_++;
+    } else {
+        pending_.set(slot);
+        order_[order_tail_] = static_cast<uint16_t>(slot);
+        order_tail_ = (order_tail_ + 1) % SLOTS;
+        pending_count_++;
+        channel_pending_[event.channel()]++;
+    }
+    pending_value_[slot] = event.data2();
+}
+
+MidiEvent MidiOutputLimiter::take(uint16_t slot) {
+    pending_count_--;
+    channel_pending_[slot / 128]--;
+    pending_.reset(slot);
+
+    MidiEvent event = MidiEvent::controlChange(slot / 128, slot % 128, pending_value_[slot]);
+    tokens_ -= cost(event);
+    return event;
+}
+
+bool MidiOutputLimiter::nextDeferred(MidiEvent& event, uint64_t now_ns) {
+    if (!hasDeferred()) return false;
+
+    refill(now_ns);
+    if (tokens_ < CC_BYTES) return false;
+
+    uint16_t slot = order_[order_head_];
+    order_head_ = (order_head_ + 1) % SLOTS;
+    while (isLsb(slot) && pending_[slot - 32]) {
+        // A 14-bit LSB whose MSB was parked again after it: back of the
+        // line, so the receiver doesn't get the new MSB last (which resets
+        // the LSB)
+        order_[order_tail_] = slot;
+        order_tail_ = (order_tail_ + 1) % SLOTS;
+        slot = order_[order_head_];
+        order_head_ = (order_head_ + 1) % SLOTS;
+    }
+
+    event = take(slot);
+    return true;
+}
+
+bool MidiOutputLimiter::takeDeferredBefore(const MidiEvent& next, MidiEvent& event) {
+    uint8_t type = next.type();
+    if (type < 0x80 || type >= 0xF0 || type == 0xB0) return false;
+
+    uint8_t channel = next.channel();
+    if (channel_pending_[channel] == 0) return false;
+
+    // Oldest slot on this channel, skipping an LSB whose MSB is parked
+    // behind it (the MSB is found first and the LSB on the next call)
+    uint16_t index = order_head_;
+    uint16_t slot = order_[index];
+    while (slot / 128 != channel || (isLsb(slot) && pending_[slot - 32])) {
+        index = (index + 1) % SLOTS;
+        slot = order_[index];
+    }
+
+    // Close the gap by moving the entries ahead of it back one place
+    while (index != order_head_) {
+        uint16_t prev = (index + SLOTS - 1) % SLOTS;
+        order_[index] = order_[prev];
+        index = prev;
+    }
+    order_head_ = (order_head_ + 1) % SLOTS;
+
+    event = take(slot);
+    return true;
+}
+
+void MidiOutputLimiter::clear() {
+    pending_.reset();
+    sent_msb_slot_ = NO_SLOT;
+    order_head_ = 0;
+    order_tail_ = 0;
+    pending_count_ = 0;
+    std::fill(std::begin(channel_pending_), std::end(channel_pending_), 0);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "MidiEvent.h"
+
+#include <bitset>
+#include <cstdint>
+
+/**
+ * @brief Bandwidth budget with per-(channel, CC) coalescing
+ *
+ * Used by a MidiSenderThread whose backend sits on a slow link (31.25 kbaud
+ * DIN moves ~3125 bytes/s). Outgoing bytes are metered by a token bucket.
+ * When the budget is exhausted, Control Changes are parked in a 16x128 slot
+ * table that keeps only the latest value per (channel, CC), and flushed in
+ * first-parked order as tokens refill. A dial gesture therefore sends fewer
+ * intermediate values but always ends on its final one.
+ *
+ * NRPN / RPN controllers (6, 38, 96-101) are not parked, since they only
+ * work in order. A 14-bit pair (ParameterMidiEncoder sends CC n, then CC
+ * n+32 straight after) stays together: an LSB that directly follows its
+ * sent MSB is sent too, and one behind a parked MSB is parked and follows
+ * it out. Any other CC 32-63 is limited like every other CC.
+ *
+ * Other messages are never delayed or dropped; they just consume budget.
+ * A note, program change, pressure or pitch bend must not overtake a CC
+ * parked on its channel (it would play with the stale value), so the sender
+ * takes that channel's parked CCs with takeDeferredBefore() first.
+ * Costs are wire bytes with running status (see MidiSerialEncoder), since
+ * only serial links have a budget: a CC repeating the previous status is
+ * charged 2 bytes, not 3.
+ *
+ * Not thread-safe: owned and used by a single sender thread.
+ */
+class MidiOutputLimiter {
+public:
+    // 0 = unlimited (every event passes straight through)
+    void setBudget(uint32_t bytes_per_second);
+    uint32_t getBudget() const { return budget_; }
+    bool isLimited() const { return budget_ != 0; }
+
+    // Returns true if the event should be sent now, false if it was parked
+    bool admit(const MidiEvent& event, uint64_t now_ns);
+
+    // Next parked CC that fits the budget, if any
+    bool nextDeferred(MidiEvent& event, uint64_t now_ns);
+    bool hasDeferred() const { return pending_count_ != 0; }
+    uint16_t getDeferredCount() const { return pending_count_; }
+
+    // Oldest CC parked on the channel of a note (or other non-CC channel
+    // message) about to be sent, regardless of budget. Call until false.
+    bool takeDeferredBefore(const MidiEvent& next, MidiEvent& event);
+
+    // Drop everything parked (e.g. backend disconnected)
+    void clear();
+
+    // Intermediate values replaced before they were sent
+    uint32_t getCoalescedCount() const { return coalesced_count_; }
+
+private:
+    static constexpr int SLOTS = 16 * 128;
+
+    void refill(uint64_t now_ns);
+    void park(const MidiEvent& event);
+    MidiEvent take(uint16_t slot);
+    double cost(const MidiEvent& event);
+
+    uint32_t budget_ = 0;
+    double tokens_ = 0.0;
+    double bucket_size_ = 0.0;
+    uint64_t last_refill_ns_ = 0;
+    uint8_t running_status_ = 0;   // Mirrors the encoder for cost()
+
+    // Slot of the CC 0-31 just sent, if the previous CC admitted was one
+    static constexpr int NO_SLOT = -1;
+    int sent_msb_slot_ = NO_SLOT;
+
+    // Slot = channel * 128 + cc
+    uint8_t pending_value_[SLOTS] = {};
+    std::bitset<SLOTS> pending_;
+    uint16_t order_[SLOTS] = {};   // FIFO of parked slots
+    uint16_t order_head_ = 0;
+    uint16_t order_tail_ = 0;
+    uint16_t pending_count_ = 0;
+    uint16_t channel_pending_[16] = {};
+
+    uint32_t coalesced_count_ = 0;
+};
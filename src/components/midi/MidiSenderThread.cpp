@@ -0,0 +1,268 @@
+#include "MidiSenderThread.h"
+#include "MidiTime.h"
+#include "Constants.h"
+#include <iostream>
+
+#if !defined(ESP32_BUILD)
+#include <chrono>
+#endif
+
+namespace {
+    // How long the thread sleeps with an empty queue before polling the
+    // backend's update() again (incoming MIDI, connection housekeeping)
+#if defined(ESP32_BUILD)
+    constexpr TickType_t POLL_INTERVAL_TICKS = pdMS_TO_TICKS(1) > 0 ? pdMS_TO_TICKS(1) : 1;
+    constexpr uint32_t TASK_STACK_SIZE = 4096;
+    constexpr UBaseType_t TASK_PRIORITY = 5;  // Above the Arduino loop task (1)
+#else
+    constexpr auto POLL_INTERVAL = std::chrono::milliseconds(2);
+#endif
+}
+
+MidiSenderThread::MidiSenderThread(UnifiedMidiManager::MidiBackend* backend)
+    : backend_(backend) {
+}
+
+MidiSenderThread::~MidiSenderThread() {
+    stop();
+}
+
+void MidiSenderThread::start() {
+    if (running_.load(std::memory_order_acquire) || !backend_) return;
+
+    running_.store(true, std::memory_order_release);
+
+#if defined(ESP32_BUILD)
+    task_exited_.store(false, std::memory_order_release);
+    BaseType_t result = xTaskCreatePinnedToCore(taskEntry, "midi_sender", TASK_STACK_SIZE, this,
+                                                TASK_PRIORITY, &task_handle_, SynthConstants::Core::MIDI);
+    if (result != pdPASS) {
+        std::cout << "[MidiSender] Failed to create task for " << backend_->getName() << std::endl;
+        running_.store(false, std::memory_order_release);
+        task_exited_.store(true, std::memory_order_release);
+        task_handle_ = nullptr;
+    }
+#else
+    thread_ = std::thread(&MidiSenderThread::run, this);
+#endif
+}
+
+void MidiSenderThread::stop() {
+    if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+    wake();
+
+#if defined(ESP32_BUILD)
+    // The task deletes itself once it sees running_ == false
+    while (!task_exited_.load(std::memory_order_acquire)) {
+        vTaskDelay(1);
+    }
+    task_handle_ = nullptr;
+#else
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+#endif
+}
+
+bool MidiSenderThread::enqueue(const MidiEvent& event) {
+    QueuedEvent queued{event, next_sequence_.fetch_add(1, std::memory_order_relaxed)};
+    if (!queue_.push(queued)) {
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return false;
+    }
+
+    // Only this (single) producer writes the high-water mark
+    uint32_t depth = static_cast<uint32_t>(queue_.size());
+    if (depth > high_water_mark_.load(std::memory_order_relaxed)) {
+        high_water_mark_.store(depth, std::memory_order_relaxed);
+    }
+
+    wake();
+    return true;
+}
+
+bool MidiSenderThread::enqueueRealTime(const MidiEvent& event) {
+    if (!realtime_queue_.push(event)) {
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return false;
+    }
+
+    wake();
+    return true;
+}
+
+bool MidiSenderThread::enqueueScheduled(const MidiEvent& event) {
+    QueuedEvent queued{event, next_sequence_.fetch_add(1, std::memory_order_relaxed)};
+    if (!scheduled_queue_.push(queued)) {
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return false;
+    }
+
+    wake();
+    return true;
+}
+
+void MidiSenderThread::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        waitForWork();
+        drainQueue();
+        flushDeferred();
+        backend_->update();
+    }
+
+    // Deliver whatever was queued before shutdown (e.g. a final Stop)
+    drainQueue();
+    limiter_.setBudget(0);
+    flushDeferred();
+}
+
+void MidiSenderThread::drainQueue() {
+    limiter_.setBudget(output_budget_.load(std::memory_order_relaxed));
+    if (!hasWork()) return;
+
+    bool connected = canSend();
+    if (!connected) {
+        dropDeferred();
+    }
+
+    MidiEvent event;
+    MidiEvent parked;
+    for (;;) {
+        // Checked before every event, so a clock pulse waits for at most
+        // one sendBatch() rather than for the rest of the queue
+        sendRealTime(connected);
+        if (!popQueued(event)) break;
+
+        if (!connected) {
+            dropped_disconnected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        // CCs parked on this channel go first, so a note never plays with a
+        // stale controller value
+        while (limiter_.takeDeferredBefore(event, parked)) {
+            addToBatch(parked);
+        }
+        if (limiter_.admit(event, MidiTime::nowNs())) {
+            addToBatch(event);
+        }
+    }
+    flushBatch();
+    sendRealTime(connected);
+    coalesced_count_.store(limiter_.getCoalescedCount(), std::memory_order_relaxed);
+}
+
+void MidiSenderThread::sendRealTime(bool connected) {
+    // Straight to the backend, ahead of anything batched: real-time bytes
+    // may go out between any two messages
+    MidiEvent event;
+    while (realtime_queue_.pop(event)) {
+        if (!connected) {
+            dropped_disconnected_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        limiter_.admit(event, MidiTime::nowNs());   // Always admitted; charges the budget
+        backend_->sendMessage(event.status());
+    }
+}
+
+bool MidiSenderThread::popQueued(MidiEvent& event) {
+    // Oldest of the two lane fronts (sequence compared with wrap-around)
+    const QueuedEvent* main = queue_.front();
+    const QueuedEvent* scheduled = scheduled_queue_.front();
+    if (!main && !scheduled) return false;
+
+    bool take_scheduled = scheduled &&
+                          (!main || static_cast<int32_t>(scheduled->sequence - main->sequence) < 0);
+    QueuedEvent queued;
+    if (take_scheduled) {
+        scheduled_queue_.pop(queued);
+    } else {
+        queue_.pop(queued);
+    }
+    event = queued.event;
+    return true;
+}
+
+void MidiSenderThread::flushDeferred() {
+    // Parked CCs go out as the budget refills; the poll interval in
+    // waitForWork() bounds how long the final value of a gesture waits
+    bool connected = canSend();
+    if (!connected) {
+        dropDeferred();
+        return;
+    }
+
+    MidiEvent event;
+    while (limiter_.nextDeferred(event, MidiTime::nowNs())) {
+        addToBatch(event);
+        sendRealTime(connected);
+    }
+    flushBatch();
+}
+
+void MidiSenderThread::dropDeferred() {
+    // Counted like any other event lost to the disconnect
+    dropped_disconnected_.fetch_add(limiter_.getDeferredCount(), std::memory_order_relaxed);
+    limiter_.clear();
+}
+
+void MidiSenderThread::addToBatch(const MidiEvent& event) {
+    batch_[batch_size_++] = event;
+    if (batch_size_ == MAX_BATCH) {
+        flushBatch();
+    }
+}
+
+void MidiSenderThread::flushBatch() {
+    if (batch_size_ == 0) return;
+    backend_->sendBatch(batch_, batch_size_);
+    batch_size_ = 0;
+}
+
+#if defined(ESP32_BUILD)
+
+void MidiSenderThread::taskEntry(void* arg) {
+    auto* self = static_cast<MidiSenderThread*>(arg);
+    self->run();
+    self->task_exited_.store(true, std::memory_order_release);
+    vTaskDelete(nullptr);
+}
+
+void MidiSenderThread::waitForWork() {
+    if (hasWork()) return;
+    ulTaskNotifyTake(pdTRUE, POLL_INTERVAL_TICKS);
+}
+
+void MidiSenderThread::wake() {
+    if (task_handle_) {
+        xTaskNotifyGive(task_handle_);
+    }
+}
+
+#else
+
+void MidiSenderThread::waitForWork() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    sleeping_.store(true, std::memory_order_seq_cst);
+    // Pairs with the fence in wake(): either the producer sees us sleeping
+    // and notifies, or we see its event here and skip the wait.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    wake_cv_.wait_for(lock, POLL_INTERVAL, [this] {
+        return hasWork() || !running_.load(std::memory_order_acquire);
+    });
+    sleeping_.store(false, std::memory_order_relaxed);
+}
+
+void MidiSenderThread::wake() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_cv_.notify_one();
+    }
+}
+
+#endif
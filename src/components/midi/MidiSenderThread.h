@@ -0,0 +1,135 @@
+#pragma once
+
+#include "UnifiedMidiManager.h"
+#include "MidiEvent.h"
+#include "SpscRing.h"
+#include "MidiOutputLimiter.h"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(ESP32_BUILD)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#else
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/**
+ * @brief Dedicated I/O thread for one MIDI backend
+ *
+ * Producers (parameter changes, the clock manager) push packed MidiEvents
+ * into lock-free SPSC rings and return immediately; this thread drains the
+ * rings and performs the actual backend writes, so a slow ALSA write or a USB
+ * stall never shows up as UI frame time. The thread also runs the backend's
+ * update() so all of a backend's I/O stays confined to a single thread.
+ *
+ * Three lanes, one producer each:
+ * - main (UI thread) and scheduled (clock thread, events released by the
+ *   MidiEventScheduler) carry channel messages; they share one sequence
+ *   counter and are merged in enqueue order, so a released note never
+ *   overtakes a CC the UI queued before it
+ * - real-time (clock thread) carries clock bytes only; they skip the batch
+ *   and go out between any two events
+ *
+ * Runs as a std::thread on desktop and as a FreeRTOS task on ESP32.
+ */
+class MidiSenderThread {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 256;
+    static constexpr size_t REALTIME_QUEUE_CAPACITY = 64;
+    static constexpr size_t SCHEDULED_QUEUE_CAPACITY = 256;  // A dense tick: chords plus CC ramps
+    static constexpr size_t MAX_BATCH = 32;  // Events handed to one sendBatch()
+
+    explicit MidiSenderThread(UnifiedMidiManager::MidiBackend* backend);
+    ~MidiSenderThread();
+
+    MidiSenderThread(const MidiSenderThread&) = delete;
+    MidiSenderThread& operator=(const MidiSenderThread&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Producer side (single producer). Never blocks; drops the event and
+    // counts an overflow if the ring is full.
+    bool enqueue(const MidiEvent& event);
+
+    // Second producer lane, reserved for the clock thread's real-time bytes.
+    // Checked before every queued event and sent without batching, so clock
+    // bytes never wait behind a burst of CCs.
+    bool enqueueRealTime(const MidiEvent& event);
+
+    // Third lane, for the clock thread's scheduled channel messages
+    bool enqueueScheduled(const MidiEvent& event);
+
+    UnifiedMidiManager::MidiBackend* getBackend() const { return backend_; }
+
+    // Bytes/second for CC coalescing (see MidiOutputLimiter), 0 = unlimited.
+    // Applied by the thread on its next drain.
+    void setOutputBudget(uint32_t bytes_per_second) { output_budget_.store(bytes_per_second, std::memory_order_relaxed); }
+    uint32_t getOutputBudget() const { return output_budget_.load(std::memory_order_relaxed); }
+
+    // Statistics
+    uint32_t getOverflowCount() const { return overflow_count_.load(std::memory_order_relaxed); }
+    uint32_t getHighWaterMark() const { return high_water_mark_.load(std::memory_order_relaxed); }
+    uint32_t getDroppedWhileDisconnected() const { return dropped_disconnected_.load(std::memory_order_relaxed); }
+    uint32_t getCoalescedCount() const { return coalesced_count_.load(std::memory_order_relaxed); }
+    size_t getQueueDepth() const { return queue_.size() + scheduled_queue_.size() + realtime_queue_.size(); }
+
+private:
+    void run();
+    void waitForWork();
+    void wake();
+    void drainQueue();
+    bool hasWork() const { return !queue_.empty() || !scheduled_queue_.empty() || !realtime_queue_.empty(); }
+    bool popQueued(MidiEvent& event);
+    bool canSend() const {
+        return backend_->getPublishedStatus() == UnifiedMidiManager::ConnectionStatus::CONNECTED &&
+               backend_->supportsOutput();
+    }
+    void flushDeferred();
+    void dropDeferred();
+    void sendRealTime(bool connected);
+    void addToBatch(const MidiEvent& event);
+    void flushBatch();
+
+    UnifiedMidiManager::MidiBackend* backend_;
+    // Main and scheduled lanes are stamped from one counter so the
+    // consumer can merge them in enqueue order
+    struct QueuedEvent {
+        MidiEvent event;
+        uint32_t sequence;
+    };
+    SpscRing<QueuedEvent, QUEUE_CAPACITY> queue_;
+    SpscRing<QueuedEvent, SCHEDULED_QUEUE_CAPACITY> scheduled_queue_;
+    SpscRing<MidiEvent, REALTIME_QUEUE_CAPACITY> realtime_queue_;
+    std::atomic<uint32_t> next_sequence_{0};
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint32_t> overflow_count_{0};
+    std::atomic<uint32_t> high_water_mark_{0};
+    std::atomic<uint32_t> dropped_disconnected_{0};
+    std::atomic<uint32_t> coalesced_count_{0};
+
+    // Output policy (sender thread only, except the atomic budget request)
+    std::atomic<uint32_t> output_budget_{0};
+    MidiOutputLimiter limiter_;
+
+    // Events collected during one drain, sent with a single sendBatch()
+    MidiEvent batch_[MAX_BATCH];
+    size_t batch_size_ = 0;
+
+#if defined(ESP32_BUILD)
+    static void taskEntry(void* arg);
+    TaskHandle_t task_handle_ = nullptr;
+    std::atomic<bool> task_exited_{true};
+#else
+    std::thread thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<bool> sleeping_{false};
+#endif
+};
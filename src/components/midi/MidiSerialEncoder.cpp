@@ -0,0 +1,65 @@
+#include "MidiSerialEncoder.h"
+
+size_t MidiSerialEncoder::dataLength(uint8_t status) {
+    switch (status & 0xF0) {
+        case 0xC0:  // Program Change
+        case 0xD0:  // Channel Pressure
+            return 1;
+        case 0xF0:
+            switch (status) {
+                case 0xF1:  // MTC Quarter Frame
+                case 0xF3:  // Song Select
+                    return 1;
+                case 0xF2:  // Song Position
+                    return 2;
+                default:
+                    return 0;
+            }
+        default:
+            return 2;
+    }
+}
+
+size_t MidiSerialEncoder::encode(uint8_t status, uint8_t data1, uint8_t data2, uint64_t now_ns, uint8_t* out) {
+    size_t length = 0;
+
+    if (status >= 0xF8) {
+        // Real-time: single byte, leaves running status alone
+        out[length++] = status;
+    } else {
+        bool channel_message = status < 0xF0;
+        bool stale = now_ns - status_sent_ns_ >= STATUS_REFRESH_NS;
+
+        if (channel_message && status == running_status_ && !stale) {
+            status_bytes_saved_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            out[length++] = status;
+            status_sent_ns_ = now_ns;
+        }
+        running_status_ = channel_message ? status : 0;
+
+        size_t data_length = dataLength(status);
+        if (data_length >= 1) out[length++] = data1 & 0x7F;
+        if (data_length >= 2) out[length++] = data2 & 0x7F;
+    }
+
+    tick(now_ns);
+    window_bytes_ += static_cast<uint32_t>(length);
+    return length;
+}
+
+void MidiSerialEncoder::tick(uint64_t now_ns) {
+    if (window_start_ns_ == 0) {
+        window_start_ns_ = now_ns;
+        return;
+    }
+
+    uint64_t elapsed = now_ns - window_start_ns_;
+    if (elapsed < WINDOW_NS) return;
+
+    // A window that ran long (idle sender) is scaled back to one second
+    uint64_t rate = static_cast<uint64_t>(window_bytes_) * WINDOW_NS / elapsed;
+    bytes_per_second_.store(static_cast<uint32_t>(rate), std::memory_order_relaxed);
+    window_bytes_ = 0;
+    window_start_ns_ = now_ns;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Byte encoder for a DIN (UART) MIDI link
+ *
+ * Applies running status: consecutive channel messages with the same status
+ * byte are sent as data bytes only, so a stream of CCs on one channel costs
+ * 2 bytes per message instead of 3. The status byte is re-sent at least every
+ * STATUS_REFRESH_NS so a receiver that was plugged in (or dropped a byte)
+ * mid-stream resynchronises quickly.
+ *
+ * Real-time messages (0xF8-0xFF) may be interleaved without breaking running
+ * status; system common messages (0xF0-0xF7) cancel it, as the spec requires.
+ *
+ * Also meters the bytes it produces: getBytesPerSecond() is the byte count
+ * of the last complete one-second window.
+ *
+ * encode() and tick() belong to the sender thread; the statistics getters
+ * can be read from any thread.
+ */
+class MidiSerialEncoder {
+public:
+    static constexpr size_t MAX_MESSAGE_BYTES = 3;
+    static constexpr uint64_t STATUS_REFRESH_NS = 200000000ULL;  // 200 ms
+
+    // Encode one message into out (at least MAX_MESSAGE_BYTES); returns the
+    // number of bytes to write
+    size_t encode(uint8_t status, uint8_t data1, uint8_t data2, uint64_t now_ns, uint8_t* out);
+
+    // Roll the measurement window even when nothing is being sent
+    void tick(uint64_t now_ns);
+
+    // Forget running status (e.g. after the port was reopened)
+    void reset() { running_status_ = 0; }
+
+    // Statistics
+    uint32_t getBytesPerSecond() const { return bytes_per_second_.load(std::memory_order_relaxed); }
+    uint32_t getStatusBytesSaved() const { return status_bytes_saved_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t WINDOW_NS = 1000000000ULL;
+
+    static size_t dataLength(uint8_t status);
+
+    uint8_t running_status_ = 0;
+    uint64_t status_sent_ns_ = 0;
+
+    uint64_t window_start_ns_ = 0;
+    uint32_t window_bytes_ = 0;
+
+    std::atomic<uint32_t> bytes_per_second_{0};
+    std::atomic<uint32_t> status_bytes_saved_{0};
+};
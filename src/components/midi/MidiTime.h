@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(ESP32_BUILD)
+#include <esp_timer.h>
+#else
+#include <time.h>
+#endif
+
+/**
+ * @brief Monotonic time base shared by the MIDI threads
+ *
+ * Input timestamps, clock deadlines and scheduled events all use this clock
+ * so they can be compared directly.
+ */
+namespace MidiTime {
+
+inline uint64_t nowNs() {
+#if defined(ESP32_BUILD)
+    return static_cast<uint64_t>(esp_timer_get_time()) * 1000ULL;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+inline uint64_t nowUs() {
+#if defined(ESP32_BUILD)
+    return static_cast<uint64_t>(esp_timer_get_time());
+#else
+    return nowNs() / 1000ULL;
+#endif
+}
+
+} // namespace MidiTime
@@ -0,0 +1,51 @@
+#include "NullMidiBackend.h"
+#include <iostream>
+
+NullMidiBackend::~NullMidiBackend() {
+    cleanup();
+}
+
+bool NullMidiBackend::initialize() {
+    if (!initialized_) {
+        initialized_ = true;
+        std::cout << "[Null MIDI] Initialized" << std::endl;
+    }
+    return true;
+}
+
+void NullMidiBackend::cleanup() {
+    if (initialized_.exchange(false)) {
+        std::cout << "[Null MIDI] Backend cleaned up after " << messages_sent_.load() << " messages, "
+                  << bytes_sent_.load() << " bytes in " << writes_.load() << " writes" << std::endl;
+    }
+}
+
+UnifiedMidiManager::ConnectionStatus NullMidiBackend::getStatus() const {
+    return initialized_ ? UnifiedMidiManager::ConnectionStatus::CONNECTED
+                        : UnifiedMidiManager::ConnectionStatus::DISCONNECTED;
+}
+
+void NullMidiBackend::sendMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    (void)data1;
+    (void)data2;
+    tally(1, MidiEvent::lengthForStatus(status));
+}
+
+void NullMidiBackend::sendMessage(uint8_t status) {
+    (void)status;
+    tally(1, 1);
+}
+
+void NullMidiBackend::sendBatch(const MidiEvent* events, size_t count) {
+    uint32_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        bytes += events[i].length;
+    }
+    tally(static_cast<uint32_t>(count), bytes);
+}
+
+void NullMidiBackend::tally(uint32_t messages, uint32_t bytes) {
+    messages_sent_.fetch_add(messages, std::memory_order_relaxed);
+    bytes_sent_.fetch_add(bytes, std::memory_order_relaxed);
+    writes_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "UnifiedMidiManager.h"
+#include <atomic>
+
+/**
+ * @brief Output-only backend that discards everything it is sent
+ *
+ * Counts messages, bytes and write calls (a batch is one call), so the send
+ * path can be measured without any device or driver in the way.
+ */
+class NullMidiBackend : public UnifiedMidiManager::MidiBackend {
+public:
+    ~NullMidiBackend() override;
+
+    bool initialize() override;
+    void cleanup() override;
+    UnifiedMidiManager::ConnectionStatus getStatus() const override;
+    bool supportsInput() const override { return false; }
+    bool supportsOutput() const override { return true; }
+    void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) override;
+    void sendMessage(uint8_t status) override;
+    void sendBatch(const MidiEvent* events, size_t count) override;
+    void update() override {}
+    uint32_t getMessagesSent() const override { return messages_sent_; }
+    uint32_t getMessagesReceived() const override { return 0; }
+    std::string getName() const override { return "Null Sink"; }
+    UnifiedMidiManager::BackendType getType() const override { return UnifiedMidiManager::BackendType::NULL_SINK; }
+
+    uint64_t getBytesSent() const { return bytes_sent_.load(std::memory_order_relaxed); }
+    uint32_t getWriteCount() const { return writes_.load(std::memory_order_relaxed); }
+
+private:
+    void tally(uint32_t messages, uint32_t bytes);   // Sender thread
+
+    std::atomic<bool> initialized_{false};
+    std::atomic<uint32_t> messages_sent_{0};
+    std::atomic<uint64_t> bytes_sent_{0};
+    std::atomic<uint32_t> writes_{0};
+};
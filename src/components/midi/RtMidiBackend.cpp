@@ -52,13 +52,11 @@ void RtMidiBackend::cleanup() {
 
 UnifiedMidiManager::ConnectionStatus RtMidiBackend::getStatus() const {
     if (!midi_handler_) {
-        std::cout << "[RtMidi] getStatus: No midi_handler_" << std::endl;
         return UnifiedMidiManager::ConnectionStatus::DISCONNECTED;
     }
     
+    // Called per drain by the sender thread; keep it to a flag read
     bool is_connected = midi_handler_->isConnected();
-    std::string status_str = midi_handler_->getConnectionStatus();
-    std::cout << "[RtMidi] getStatus: isConnected=" << is_connected << ", status=" << status_str << std::endl;
     
     return is_connected ? 
         UnifiedMidiManager::ConnectionStatus::CONNECTED :
@@ -70,32 +68,9 @@ void RtMidiBackend::sendMessage(uint8_t status, uint8_t data1, uint8_t data2) {
         return;
     }
     
-    uint8_t command = status & 0xF0;
-    uint8_t channel = status & 0x0F;
-    
-    switch (command) {
-        case 0x80: // Note Off
-            midi_handler_->sendNoteOff(channel, data1, data2);
-            break;
-        case 0x90: // Note On
-            midi_handler_->sendNoteOn(channel, data1, data2);
-            break;
-        case 0xB0: // Control Change
-            midi_handler_->sendControlChange(channel, data1, data2);
-            break;
-        case 0xC0: // Program Change
-            // MidiHandler doesn't have sendProgramChange, simulate with CC
-            std::cout << "[RtMidi] Program Change " << (int)data1 << " (simulated)" << std::endl;
-            break;
-        case 0xE0: // Pitch Bend
-            // MidiHandler doesn't have sendPitchBend, simulate with CC
-            std::cout << "[RtMidi] Pitch Bend " << (int)data1 << "," << (int)data2 << " (simulated)" << std::endl;
-            break;
-        default:
-            std::cout << "[RtMidi] Unknown MIDI command: 0x" << std::hex << (int)command << std::dec << std::endl;
-            break;
-    }
-    
+    // Forward the raw message - MidiEvent sizes itself from the status byte,
+    // so program change, pitch bend etc. go out as real messages too.
+    midi_handler_->sendEvent(MidiEvent::make(status, data1, data2));
     messages_sent_++;
 }
 
@@ -104,33 +79,49 @@ void RtMidiBackend::sendMessage(uint8_t status) {
         return;
     }
     
-    // Handle single-byte messages (system real-time)
-    switch (status) {
-        case 0xF8: // MIDI Clock
-        case 0xFA: // Start
-        case 0xFB: // Continue  
-        case 0xFC: // Stop
-        case 0xFE: // Active Sensing
-        case 0xFF: // System Reset
-            // For now, just log these - MidiHandler may not support them directly
-            std::cout << "[RtMidi] System message: 0x" << std::hex << (int)status << std::dec << std::endl;
-            break;
-        default:
-            std::cout << "[RtMidi] Unknown single-byte message: 0x" << std::hex << (int)status << std::dec << std::endl;
-            break;
+    // Single-byte messages (system real-time: clock, start, stop, ...)
+    midi_handler_->sendEvent(MidiEvent::realTime(status));
+    messages_sent_++;
+}
+
+void RtMidiBackend::sendBatch(const MidiEvent* events, size_t count) {
+    if (!midi_handler_ || !initialized_) {
+        return;
     }
     
-    messages_sent_++;
+    midi_handler_->sendEvents(events, count);
+    messages_sent_ += static_cast<uint32_t>(count);
 }
 
 void RtMidiBackend::update() {
-    // Update input processing - MidiHandler may handle this internally
-    if (midi_handler_) {
-        // Check for incoming messages and call callbacks if needed
-        // This depends on how MidiHandler implements input processing
+    // Input needs no polling: RtMidiIn delivers on its own thread straight
+    // into MidiHandler's input ring, which pollInput() drains. Hot-plug
+    // changes are applied here, on the sender thread that owns the output.
+    if (midi_handler_ && initialized_ && midi_handler_->servicePortChanges()) {
+        publishStatus(getStatus());
     }
 }
 
+uint32_t RtMidiBackend::getReconnectLatencyUs() const {
+    return midi_handler_ ? midi_handler_->getReconnectLatencyUs() : 0;
+}
+
+uint32_t RtMidiBackend::getReconnectCount() const {
+    return midi_handler_ ? midi_handler_->getReconnectCount() : 0;
+}
+
+bool RtMidiBackend::pollInput(TimedMidiEvent& event) {
+    if (!midi_handler_ || !initialized_) {
+        return false;
+    }
+    
+    if (!midi_handler_->pollInput(event)) {
+        return false;
+    }
+    messages_received_++;
+    return true;
+}
+
 #else
 // ESP32 stub - RtMidi not available on ESP32
 RtMidiBackend::RtMidiBackend() {}
@@ -142,5 +133,9 @@ UnifiedMidiManager::ConnectionStatus RtMidiBackend::getStatus() const {
 }
 void RtMidiBackend::sendMessage(uint8_t, uint8_t, uint8_t) {}
 void RtMidiBackend::sendMessage(uint8_t) {}
+void RtMidiBackend::sendBatch(const MidiEvent*, size_t) {}
 void RtMidiBackend::update() {}
+bool RtMidiBackend::pollInput(TimedMidiEvent&) { return false; }
+uint32_t RtMidiBackend::getReconnectLatencyUs() const { return 0; }
+uint32_t RtMidiBackend::getReconnectCount() const { return 0; }
 #endif
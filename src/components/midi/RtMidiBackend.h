@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UnifiedMidiManager.h"
+#include <atomic>
 
 #if !defined(ESP32_BUILD)
 #include "hardware/MidiHandler.h"
@@ -25,7 +26,11 @@ public:
     bool supportsOutput() const override { return true; }
     void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) override;
     void sendMessage(uint8_t status) override;
+    void sendBatch(const MidiEvent* events, size_t count) override;
     void update() override;
+    bool pollInput(TimedMidiEvent& event) override;
+    uint32_t getReconnectLatencyUs() const override;
+    uint32_t getReconnectCount() const override;
     uint32_t getMessagesSent() const override { return messages_sent_; }
     uint32_t getMessagesReceived() const override { return messages_received_; }
     std::string getName() const override { return "RtMidi (USB)"; }
@@ -33,8 +38,8 @@ public:
     
 private:
     std::shared_ptr<MidiHandler> midi_handler_;  // Shared MIDI handler
-    uint32_t messages_sent_ = 0;
-    uint32_t messages_received_ = 0;
+    std::atomic<uint32_t> messages_sent_{0};      // Written by the sender thread
+    std::atomic<uint32_t> messages_received_{0};
     bool initialized_ = false;
 };
 
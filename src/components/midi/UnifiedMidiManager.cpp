@@ -1,6 +1,14 @@
 #include "UnifiedMidiManager.h"
 #include "HardwareMidiBackend.h"
 #include "ESP32USBMidiBackend.h"
+#include "LoopbackMidiBackend.h"
+#include "NullMidiBackend.h"
+#include "MidiSenderThread.h"
+#include "MidiTime.h"
+#include "components/settings/SettingsManager.h"
+#include "components/app/LoopScheduler.h"
+#include "components/app/UiThread.h"
+#include "components/log/Log.h"
 
 #if !defined(ESP32_BUILD)
 #include "RtMidiBackend.h"
@@ -8,20 +16,37 @@
 
 #include <iostream>
 #include <algorithm>
+#include <thread>
 
 // Static storage for shared MIDI handler
 static std::shared_ptr<MidiHandler> shared_midi_handler_ = nullptr;
+static UnifiedMidiManager::TestBackendConfig test_backends_;
+
+// Upper bound on messages dispatched per backend per update() so a flood of
+// incoming clock/CC data can't stall a UI frame; the rest waits for the next loop
+static constexpr int MAX_INPUT_EVENTS_PER_UPDATE = 256;
 
 UnifiedMidiManager& UnifiedMidiManager::getInstance() {
     static UnifiedMidiManager instance;
     return instance;
 }
 
+UnifiedMidiManager::~UnifiedMidiManager() {
+    for (auto& sender : senders_) {
+        sender->stop();
+    }
+    delete active_sinks_.exchange(nullptr);
+}
+
 void UnifiedMidiManager::setSharedMidiHandler(std::shared_ptr<MidiHandler> handler) {
     shared_midi_handler_ = handler;
     std::cout << "[UnifiedMidiManager] Shared MidiHandler set" << std::endl;
 }
 
+void UnifiedMidiManager::setTestBackends(const TestBackendConfig& config) {
+    test_backends_ = config;
+}
+
 void UnifiedMidiManager::initialize() {
     if (initialized_) return;
     
@@ -38,6 +63,47 @@ void UnifiedMidiManager::initialize() {
         }
     }
     
+    // Give every backend its own sender thread; only connected ones start now,
+    // the rest are started by enableBackend()
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        senders_.clear();
+        for (auto& backend : backends_) {
+            auto sender = std::make_unique<MidiSenderThread>(backend.get());
+            if (backend->getStatus() == ConnectionStatus::CONNECTED) {
+                sender->start();
+            }
+            senders_.push_back(std::move(sender));
+        }
+    }
+    applyOutputBudget();
+    
+    // From here on backends push their connection changes to us
+    for (auto& backend : backends_) {
+        backend->setStatusListener([this](MidiBackend* changed, ConnectionStatus status) {
+            onBackendStatusChanged(changed, status);
+        });
+        backend->publishStatus(backend->getStatus());
+    }
+    rebuildActiveSinks();
+    
+    // Follow the output budget setting. The observer only sees changes, so
+    // apply the current value now if the setting is already registered (the
+    // settings UI usually registers it later, which notifies us of a
+    // non-default value)
+    SettingsManager& settings = SettingsManager::getInstance();
+    settings.addObserver("UnifiedMidiManager",
+        [this](const std::string& key, const std::any& /* old_value */, const std::any& new_value) {
+            if (key == "midi.output_budget" && new_value.type() == typeid(int)) {
+                setOutputBudgetPercent(std::any_cast<int>(new_value));
+            }
+        });
+    if (const auto* budget = settings.getSettingDefinition("midi.output_budget")) {
+        if (budget->current_value.type() == typeid(int)) {
+            setOutputBudgetPercent(std::any_cast<int>(budget->current_value));
+        }
+    }
+    
     initialized_ = true;
     
     // Print status summary
@@ -55,8 +121,33 @@ void UnifiedMidiManager::initialize() {
 }
 
 void UnifiedMidiManager::cleanup() {
+    SettingsManager::getInstance().removeObserver("UnifiedMidiManager");
+    stopReplay();
+    stopRecording();
+    
+    // Take every sender out of the fan-out first, so the clock thread can't be
+    // iterating them while they are stopped and destroyed below
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        ActiveSinks* old = active_sinks_.exchange(nullptr, std::memory_order_seq_cst);
+        while (sink_readers_.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+        delete old;
+    }
+    
+    // Stop sender threads so nothing touches a backend mid-cleanup
+    for (auto& sender : senders_) {
+        sender->stop();
+    }
+    {
+        std::lock_guard<std::mutex> lock(sinks_mutex_);
+        senders_.clear();
+    }
+    
     for (auto& backend : backends_) {
         backend->cleanup();
+        backend->publishStatus(ConnectionStatus::DISCONNECTED);
     }
     backends_.clear();
     initialized_ = false;
@@ -88,6 +179,14 @@ void UnifiedMidiManager::createBackends() {
     // Add Hardware MIDI backend for desktop simulation
     backends_.push_back(std::make_unique<HardwareMidiBackend>());
 #endif
+    
+    if (test_backends_.loopback) {
+        backends_.push_back(std::make_unique<LoopbackMidiBackend>(
+            test_backends_.loopback_latency_us, test_backends_.loopback_jitter_us));
+    }
+    if (test_backends_.null_sink) {
+        backends_.push_back(std::make_unique<NullMidiBackend>());
+    }
 }
 
 std::vector<UnifiedMidiManager::BackendInfo> UnifiedMidiManager::getAvailableBackends() const {
@@ -102,6 +201,17 @@ std::vector<UnifiedMidiManager::BackendInfo> UnifiedMidiManager::getAvailableBac
         info.supports_output = backend->supportsOutput();
         info.messages_sent = backend->getMessagesSent();
         info.messages_received = backend->getMessagesReceived();
+        
+        auto* sender = getSender(backend.get());
+        info.queue_overflows = sender ? sender->getOverflowCount() : 0;
+        info.queue_high_water = sender ? sender->getHighWaterMark() : 0;
+        info.cc_coalesced = sender ? sender->getCoalescedCount() : 0;
+        info.output_budget = sender ? sender->getOutputBudget() : 0;
+        info.bytes_per_second = backend->getBytesPerSecond();
+        uint32_t link = backend->getLinkBytesPerSecond();
+        info.link_utilization = link ? static_cast<float>(info.bytes_per_second) / link : 0.0f;
+        info.reconnect_count = backend->getReconnectCount();
+        info.reconnect_latency_us = backend->getReconnectLatencyUs();
         info_list.push_back(info);
     }
     
@@ -115,115 +225,198 @@ bool UnifiedMidiManager::enableBackend(BackendType type) {
         return false;
     }
     
-    return backend->initialize();
+    auto* sender = getSender(backend);
+    if (sender) {
+        sender->stop();
+    }
+    
+    bool ok = backend->initialize();
+    if (ok && sender) {
+        sender->start();
+    }
+    backend->publishStatus(backend->getStatus());
+    rebuildActiveSinks();
+    return ok;
 }
 
 bool UnifiedMidiManager::disableBackend(BackendType type) {
     auto* backend = getBackend(type);
     if (!backend) return false;
     
+    // Stop the sender thread before tearing the backend down underneath it;
+    // the rebuild drops it from the fan-out
+    if (auto* sender = getSender(backend)) {
+        sender->stop();
+    }
+    rebuildActiveSinks();
     backend->cleanup();
+    backend->publishStatus(backend->getStatus());
     return true;
 }
 
 bool UnifiedMidiManager::isBackendEnabled(BackendType type) const {
     auto* backend = getBackend(type);
-    return backend && backend->getStatus() == ConnectionStatus::CONNECTED;
+    return backend && backend->getPublishedStatus() == ConnectionStatus::CONNECTED;
 }
 
-// MIDI Output methods - send to all connected backends
-void UnifiedMidiManager::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
-    uint8_t status = 0x90 | ((channel - 1) & 0x0F); // Convert to 0-15 range
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(status, note & 0x7F, velocity & 0x7F);
-        }
+void UnifiedMidiManager::onBackendStatusChanged(MidiBackend* backend, ConnectionStatus status) {
+    // May run on a backend's I/O thread (e.g. a hot-plug monitor)
+    LOG_INFO("UnifiedMidiManager", "%s is now %s", backend->getName().c_str(),
+             status == ConnectionStatus::CONNECTED ? "connected" :
+             status == ConnectionStatus::ERROR ? "in error" : "disconnected");
+    if (status == ConnectionStatus::CONNECTED) {
+        // The receiver knows none of our NRPN selections; the encoder is
+        // UI-thread only, so sendParameter() does the reset
+        encoder_reset_pending_.store(true, std::memory_order_release);
     }
+    rebuildActiveSinks();
 }
 
-void UnifiedMidiManager::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
-    uint8_t status = 0x80 | ((channel - 1) & 0x0F);
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(status, note & 0x7F, velocity & 0x7F);
+void UnifiedMidiManager::rebuildActiveSinks() {
+    std::lock_guard<std::mutex> lock(sinks_mutex_);
+    
+    auto* next = new ActiveSinks();
+    for (auto& sender : senders_) {
+        auto* backend = sender->getBackend();
+        if (next->count < MAX_BACKENDS && sender->isRunning() && backend->supportsOutput() &&
+            backend->getPublishedStatus() == ConnectionStatus::CONNECTED) {
+            next->senders[next->count++] = sender.get();
         }
     }
+    
+    // Readers either still hold the old list (we wait for them) or already
+    // see the new one
+    ActiveSinks* old = active_sinks_.exchange(next, std::memory_order_seq_cst);
+    while (sink_readers_.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    delete old;
+}
+
+size_t UnifiedMidiManager::getActiveOutputCount() const {
+    size_t count = 0;
+    forEachSink([&count](MidiSenderThread*) { ++count; });
+    return count;
+}
+
+// MIDI Output methods - queued to every backend's sender thread.
+// Channels are 1-based here and converted to the 0-15 status nibble.
+void UnifiedMidiManager::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+    enqueueOutput(MidiEvent::noteOn(channel - 1, note, velocity));
+}
+
+void UnifiedMidiManager::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
+    enqueueOutput(MidiEvent::noteOff(channel - 1, note, velocity));
 }
 
 void UnifiedMidiManager::sendControlChange(uint8_t channel, uint8_t cc, uint8_t value) {
-    uint8_t status = 0xB0 | ((channel - 1) & 0x0F);
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(status, cc & 0x7F, value & 0x7F);
-        }
-    }
+    enqueueOutput(MidiEvent::controlChange(channel - 1, cc, value));
 }
 
 void UnifiedMidiManager::sendProgramChange(uint8_t channel, uint8_t program) {
-    uint8_t status = 0xC0 | ((channel - 1) & 0x0F);
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(status, program & 0x7F, 0);
-        }
-    }
+    enqueueOutput(MidiEvent::programChange(channel - 1, program));
 }
 
 void UnifiedMidiManager::sendPitchBend(uint8_t channel, uint16_t value) {
-    uint8_t status = 0xE0 | ((channel - 1) & 0x0F);
-    uint8_t lsb = value & 0x7F;
-    uint8_t msb = (value >> 7) & 0x7F;
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(status, lsb, msb);
-        }
+    enqueueOutput(MidiEvent::pitchBend(channel - 1, value));
+}
+
+void UnifiedMidiManager::sendParameter(uint8_t channel, const Parameter& parameter, uint16_t value) {
+    ASSERT_UI_THREAD();
+    
+    if (encoder_reset_pending_.exchange(false, std::memory_order_acquire)) {
+        parameter_encoder_.reset();
+    }
+    
+    MidiEvent events[ParameterMidiEncoder::MAX_EVENTS];
+    size_t count = parameter_encoder_.encode(parameter, channel - 1, value, MidiTime::nowNs(), events);
+    bool delivered = true;
+    for (size_t i = 0; i < count; ++i) {
+        delivered &= enqueueOutput(events[i]);
+    }
+    if (!delivered) {
+        // A full queue may have dropped a 99/98 selection the encoder now
+        // believes was sent; select again next time
+        parameter_encoder_.reset();
     }
 }
 
 void UnifiedMidiManager::sendClockPulse() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xF8); // MIDI Clock
-        }
-    }
+    enqueueRealTime(MidiEvent::realTime(0xF8)); // MIDI Clock
 }
 
 void UnifiedMidiManager::sendStart() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xFA); // MIDI Start
-        }
-    }
+    enqueueOutput(MidiEvent::realTime(0xFA)); // MIDI Start
 }
 
 void UnifiedMidiManager::sendStop() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xFC); // MIDI Stop
-        }
-    }
+    enqueueOutput(MidiEvent::realTime(0xFC)); // MIDI Stop
 }
 
 void UnifiedMidiManager::sendContinue() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xFB); // MIDI Continue
-        }
+    enqueueOutput(MidiEvent::realTime(0xFB)); // MIDI Continue
+}
+
+void UnifiedMidiManager::sendFromClockThread(const MidiEvent& event) {
+    if (event.isRealTime()) {
+        enqueueRealTime(event);
+    } else {
+        enqueueScheduled(event);
     }
 }
 
 void UnifiedMidiManager::sendSystemReset() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xFF); // System Reset
-        }
-    }
+    enqueueOutput(MidiEvent::realTime(0xFF)); // System Reset
 }
 
 void UnifiedMidiManager::sendActiveSensing() {
-    for (auto& backend : backends_) {
-        if (backend->getStatus() == ConnectionStatus::CONNECTED && backend->supportsOutput()) {
-            backend->sendMessage(0xFE); // Active Sensing
-        }
+    enqueueOutput(MidiEvent::realTime(0xFE)); // Active Sensing
+}
+
+bool UnifiedMidiManager::enqueueOutput(const MidiEvent& event) {
+#if !defined(ESP32_BUILD)
+    if (event_log_.isOpen()) {
+        event_log_.append(MidiEventLog::Direction::OUT, event, MidiTime::nowUs());
+    }
+#endif
+    // Never touches the backends directly - the sender threads do the
+    // (possibly slow) write
+    bool delivered = true;
+    forEachSink([&event, &delivered](MidiSenderThread* sender) { delivered &= sender->enqueue(event); });
+    return delivered;
+}
+
+void UnifiedMidiManager::enqueueRealTime(const MidiEvent& event) {
+#if !defined(ESP32_BUILD)
+    if (event_log_.isOpen()) {
+        event_log_.append(MidiEventLog::Direction::OUT, event, MidiTime::nowUs());
+    }
+#endif
+    forEachSink([&event](MidiSenderThread* sender) { sender->enqueueRealTime(event); });
+}
+
+void UnifiedMidiManager::enqueueScheduled(const MidiEvent& event) {
+#if !defined(ESP32_BUILD)
+    if (event_log_.isOpen()) {
+        event_log_.append(MidiEventLog::Direction::OUT, event, MidiTime::nowUs());
+    }
+#endif
+    forEachSink([&event](MidiSenderThread* sender) { sender->enqueueScheduled(event); });
+}
+
+void UnifiedMidiManager::setOutputBudgetPercent(int percent) {
+    percent = std::clamp(percent, 10, 100);
+    if (percent == output_budget_percent_) return;
+    
+    output_budget_percent_ = percent;
+    std::cout << "[UnifiedMidiManager] Output budget: " << percent << "% of link bandwidth" << std::endl;
+    applyOutputBudget();
+}
+
+void UnifiedMidiManager::applyOutputBudget() {
+    for (auto& sender : senders_) {
+        uint32_t link = sender->getBackend()->getLinkBytesPerSecond();
+        sender->setOutputBudget(link ? link * output_budget_percent_ / 100 : 0);
     }
 }
 
@@ -236,7 +429,7 @@ UnifiedMidiManager::ConnectionStatus UnifiedMidiManager::getOverallStatus() cons
     bool any_error = false;
     
     for (const auto& backend : backends_) {
-        auto status = backend->getStatus();
+        auto status = backend->getPublishedStatus();
         if (status == ConnectionStatus::CONNECTED) {
             any_connected = true;
         } else if (status == ConnectionStatus::ERROR) {
@@ -266,11 +459,103 @@ uint32_t UnifiedMidiManager::getTotalMessagesReceived() const {
 }
 
 void UnifiedMidiManager::update() {
+    // Input callbacks drive parameters and widgets
+    ASSERT_UI_THREAD();
+    
+    // Backends with a running sender thread are updated from that thread;
+    // only poll the ones that are not (e.g. not yet enabled) from here
+    for (size_t i = 0; i < backends_.size(); ++i) {
+        if (i >= senders_.size() || !senders_[i]->isRunning()) {
+            backends_[i]->update();
+        }
+    }
+    
+    dispatchInput();
+}
+
+void UnifiedMidiManager::dispatchInput() {
+    TimedMidiEvent timed;
     for (auto& backend : backends_) {
-        backend->update();
+        for (int i = 0; i < MAX_INPUT_EVENTS_PER_UPDATE && backend->pollInput(timed); ++i) {
+            dispatchEvent(timed);
+        }
+    }
+    for (int i = 0; i < MAX_INPUT_EVENTS_PER_UPDATE && injected_input_.pop(timed); ++i) {
+        dispatchEvent(timed);
+    }
+}
+
+bool UnifiedMidiManager::injectInput(const TimedMidiEvent& event) {
+    if (!injected_input_.push(event)) return false;
+    LoopScheduler::getInstance().wake(LoopScheduler::Source::MIDI_INPUT);
+    return true;
+}
+
+void UnifiedMidiManager::dispatchEvent(const TimedMidiEvent& timed) {
+    const MidiEvent& event = timed.event;
+#if !defined(ESP32_BUILD)
+    if (event_log_.isOpen()) {
+        event_log_.append(MidiEventLog::Direction::IN, event, timed.timestamp_us);
+    }
+#endif
+    if (message_callback_) {
+        message_callback_(event.status(), event.data1(), event.data2(), timed.timestamp_us);
     }
 }
 
+bool UnifiedMidiManager::startRecording(const std::string& path) {
+#if !defined(ESP32_BUILD)
+    return event_log_.open(path);
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void UnifiedMidiManager::stopRecording() {
+#if !defined(ESP32_BUILD)
+    event_log_.close();
+#endif
+}
+
+bool UnifiedMidiManager::isRecording() const {
+#if !defined(ESP32_BUILD)
+    return event_log_.isOpen();
+#else
+    return false;
+#endif
+}
+
+bool UnifiedMidiManager::startReplay(const std::string& path, double speed, bool include_outgoing) {
+#if !defined(ESP32_BUILD)
+    MidiEventReplayer::Options options;
+    options.speed = speed;
+    options.include_outgoing = include_outgoing;
+    return replayer_.start(path, options, [this](const TimedMidiEvent& event) {
+        return injectInput(event);
+    });
+#else
+    (void)path;
+    (void)speed;
+    (void)include_outgoing;
+    return false;
+#endif
+}
+
+void UnifiedMidiManager::stopReplay() {
+#if !defined(ESP32_BUILD)
+    replayer_.stop();
+#endif
+}
+
+bool UnifiedMidiManager::isReplaying() const {
+#if !defined(ESP32_BUILD)
+    return replayer_.isRunning();
+#else
+    return false;
+#endif
+}
+
 UnifiedMidiManager::MidiBackend* UnifiedMidiManager::getBackend(BackendType type) const {
     auto it = std::find_if(backends_.begin(), backends_.end(),
         [type](const std::unique_ptr<MidiBackend>& backend) {
@@ -279,3 +564,12 @@ UnifiedMidiManager::MidiBackend* UnifiedMidiManager::getBackend(BackendType type
     
     return (it != backends_.end()) ? it->get() : nullptr;
 }
+
+MidiSenderThread* UnifiedMidiManager::getSender(const MidiBackend* backend) const {
+    for (const auto& sender : senders_) {
+        if (sender->getBackend() == backend) {
+            return sender.get();
+        }
+    }
+    return nullptr;
+}
@@ -1,11 +1,24 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <memory>
 #include <functional>
+#include <mutex>
 #include <string>
 
+#include "MidiEvent.h"
+#include "SpscRing.h"
+#include "components/parameter/ParameterMidiCodec.h"
+
+#if !defined(ESP32_BUILD)
+#include "MidiEventLog.h"
+#include "MidiEventReplayer.h"
+#endif
+
+class MidiSenderThread;
+
 /**
  * @brief Unified MIDI Manager - handles both hardware and USB MIDI
  * 
@@ -16,8 +29,8 @@
  */
 class UnifiedMidiManager {
 public:
-    // MIDI message callback type
-    using MidiMessageCallback = std::function<void(uint8_t status, uint8_t data1, uint8_t data2)>;
+    // MIDI message callback type (timestamp is MidiTime::nowUs() at arrival)
+    using MidiMessageCallback = std::function<void(uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestamp_us)>;
     
     // Connection status
     enum class ConnectionStatus {
@@ -32,7 +45,18 @@ public:
         HARDWARE,    // ESP32 Serial MIDI
         USB_MIDI,    // ESP32 USB MIDI device
         BLUETOOTH,   // Future: BLE MIDI
-        NETWORK      // Future: Network MIDI
+        NETWORK,     // Future: Network MIDI
+        LOOPBACK,    // In-process output -> input (benchmarks, no hardware)
+        NULL_SINK    // Discards output, counts it
+    };
+    
+    // Optional in-process backends, added by createBackends() when set
+    // before initialize() (see LoopbackMidiBackend / NullMidiBackend)
+    struct TestBackendConfig {
+        bool loopback = false;
+        uint32_t loopback_latency_us = 0;
+        uint32_t loopback_jitter_us = 0;
+        bool null_sink = false;
     };
     
     // Backend info
@@ -44,6 +68,20 @@ public:
         bool supports_output;
         uint32_t messages_sent;
         uint32_t messages_received;
+        
+        // Outbound queue statistics (see MidiSenderThread)
+        uint32_t queue_overflows;
+        uint32_t queue_high_water;
+        uint32_t cc_coalesced;       // CC values superseded before they were sent
+        uint32_t output_budget;      // Bytes/second allowed on the link, 0 = unlimited
+        
+        // Measured output (links that meter their bytes, i.e. DIN)
+        uint32_t bytes_per_second;
+        float link_utilization;      // bytes_per_second / link capacity, 0 if unknown
+        
+        // Hot-plug reconnects (desktop ALSA)
+        uint32_t reconnect_count;
+        uint32_t reconnect_latency_us;   // Last reconnect, 0 if none yet
     };
     
     static UnifiedMidiManager& getInstance();
@@ -51,6 +89,9 @@ public:
     // Set shared MIDI handler (for desktop RtMidi backend)
     static void setSharedMidiHandler(std::shared_ptr<class MidiHandler> handler);
     
+    // Register loopback / null backends on the next initialize()
+    static void setTestBackends(const TestBackendConfig& config);
+    
     // Initialization
     void initialize();
     void cleanup();
@@ -68,19 +109,35 @@ public:
     void sendProgramChange(uint8_t channel, uint8_t program);
     void sendPitchBend(uint8_t channel, uint16_t value);
     
-    // MIDI Clock & Transport (to all enabled backends)
+    // A parameter value as its CC, 14-bit CC pair or NRPN sequence (see
+    // ParameterMidiEncoder). UI thread only.
+    void sendParameter(uint8_t channel, const Parameter& parameter, uint16_t value);
+    
+    // MIDI Clock & Transport (to all enabled backends).
+    // sendClockPulse() uses the senders' real-time lane and must only be
+    // called from the clock thread; everything else is for the UI thread.
     void sendClockPulse();
     void sendStart();
     void sendStop();
     void sendContinue();
     
+    // Scheduled events released by MidiEventScheduler. Clock thread only:
+    // real-time bytes take the senders' real-time lane, channel messages
+    // their scheduled lane (merged with UI output in enqueue order).
+    void sendFromClockThread(const MidiEvent& event);
+    
     // System messages
     void sendSystemReset();
     void sendActiveSensing();
     
-    // MIDI Input callbacks
+    // MIDI Input callbacks (invoked from update(), i.e. on the UI thread)
     void setMidiMessageCallback(MidiMessageCallback callback);
     
+    // Share of a slow link's bandwidth the sender may use (10-100 %).
+    // Driven by the "midi.output_budget" setting.
+    void setOutputBudgetPercent(int percent);
+    int getOutputBudgetPercent() const { return output_budget_percent_; }
+    
     // Status and statistics
     ConnectionStatus getOverallStatus() const;
     uint32_t getTotalMessagesSent() const;
@@ -89,6 +146,23 @@ public:
     // Legacy compatibility
     bool isConnected() const { return getOverallStatus() == ConnectionStatus::CONNECTED; }
     
+    // Number of backends currently receiving output
+    size_t getActiveOutputCount() const;
+    
+    // Feed a message into the input path as if a backend had received it.
+    // Single producer (e.g. the replayer thread); returns false when full.
+    bool injectInput(const TimedMidiEvent& event);
+    
+    // Record every message in and out to a MidiEventLog, and play a log back
+    // through injectInput() (speed 1 = real time, 0 = as fast as possible).
+    // Desktop only; these return false on ESP32.
+    bool startRecording(const std::string& path);
+    void stopRecording();
+    bool isRecording() const;
+    bool startReplay(const std::string& path, double speed = 1.0, bool include_outgoing = false);
+    void stopReplay();
+    bool isReplaying() const;
+    
     // Update loop (call from main loop)
     void update();
     
@@ -104,24 +178,127 @@ public:
         virtual void sendMessage(uint8_t status, uint8_t data1, uint8_t data2) = 0;
         virtual void sendMessage(uint8_t status) = 0;
         virtual void update() = 0;
+        
+        // Send several messages in order. Backends that can share one
+        // syscall/USB transfer between them override this; the default just
+        // sends them one at a time.
+        virtual void sendBatch(const MidiEvent* events, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (events[i].length == 1) {
+                    sendMessage(events[i].status());
+                } else {
+                    sendMessage(events[i].status(), events[i].data1(), events[i].data2());
+                }
+            }
+        }
         virtual uint32_t getMessagesSent() const = 0;
         virtual uint32_t getMessagesReceived() const = 0;
         virtual std::string getName() const = 0;
         virtual BackendType getType() const = 0;
+        
+        // Pop one received message, if any. Called only from the thread that
+        // runs UnifiedMidiManager::update(); backends that receive MIDI push
+        // into their own SPSC ring from their I/O thread.
+        virtual bool pollInput(TimedMidiEvent& event) { (void)event; return false; }
+        
+        // Raw output capacity of the link in bytes/second, 0 = effectively
+        // unlimited (USB). Slow links get CC coalescing in their sender.
+        virtual uint32_t getLinkBytesPerSecond() const { return 0; }
+        
+        // Bytes actually written over the last second, 0 if not metered
+        virtual uint32_t getBytesPerSecond() const { return 0; }
+        
+        // Hot-plug: automatic reconnects so far, and how long the last one
+        // took from the device appearing to the port being usable
+        virtual uint32_t getReconnectCount() const { return 0; }
+        virtual uint32_t getReconnectLatencyUs() const { return 0; }
+        
+        // Connection changes are pushed rather than polled: backends call
+        // publishStatus() when their connection comes or goes (any thread),
+        // and the manager does after initialize()/cleanup(). Hot paths read
+        // the cached value instead of calling getStatus(). The listener is
+        // set on the UI thread while I/O threads may already be publishing,
+        // hence the mutex (status changes are rare, never on a hot path).
+        using StatusListener = std::function<void(MidiBackend* backend, ConnectionStatus status)>;
+        void setStatusListener(StatusListener listener) {
+            std::lock_guard<std::mutex> lock(status_listener_mutex_);
+            status_listener_ = std::move(listener);
+        }
+        void publishStatus(ConnectionStatus status) {
+            if (published_status_.exchange(status, std::memory_order_acq_rel) == status) return;
+            std::lock_guard<std::mutex> lock(status_listener_mutex_);
+            if (status_listener_) {
+                status_listener_(this, status);
+            }
+        }
+        ConnectionStatus getPublishedStatus() const { return published_status_.load(std::memory_order_acquire); }
+        
+    private:
+        std::atomic<ConnectionStatus> published_status_{ConnectionStatus::DISCONNECTED};
+        std::mutex status_listener_mutex_;
+        StatusListener status_listener_;
     };
 
 private:
     UnifiedMidiManager() = default;
-    ~UnifiedMidiManager() = default;
+    ~UnifiedMidiManager();
     UnifiedMidiManager(const UnifiedMidiManager&) = delete;
     UnifiedMidiManager& operator=(const UnifiedMidiManager&) = delete;
     
     // Backend implementations
     std::vector<std::unique_ptr<MidiBackend>> backends_;
+    
+    // One sender thread per backend (same index as backends_)
+    std::vector<std::unique_ptr<MidiSenderThread>> senders_;
+    
+    // Output fan-out: the senders whose backend is connected and whose thread
+    // is running. Rebuilt when a backend publishes a status change and
+    // swapped in atomically, so the send path (UI and clock threads) is a
+    // plain loop over raw pointers. A replaced list is freed once no reader
+    // is inside forEachSink().
+    static constexpr size_t MAX_BACKENDS = 8;
+    struct ActiveSinks {
+        size_t count = 0;
+        MidiSenderThread* senders[MAX_BACKENDS] = {};
+    };
+    std::atomic<ActiveSinks*> active_sinks_{nullptr};
+    mutable std::atomic<int> sink_readers_{0};
+    std::mutex sinks_mutex_;                     // Serialises rebuilds
+    
+    template <typename Fn>
+    void forEachSink(Fn&& fn) const {
+        sink_readers_.fetch_add(1, std::memory_order_seq_cst);
+        const ActiveSinks* sinks = active_sinks_.load(std::memory_order_seq_cst);
+        if (sinks) {
+            for (size_t i = 0; i < sinks->count; ++i) {
+                fn(sinks->senders[i]);
+            }
+        }
+        sink_readers_.fetch_sub(1, std::memory_order_release);
+    }
+    void rebuildActiveSinks();
+    void onBackendStatusChanged(MidiBackend* backend, ConnectionStatus status);
     MidiMessageCallback message_callback_;
+    
+    SpscRing<TimedMidiEvent, 1024> injected_input_;
+#if !defined(ESP32_BUILD)
+    MidiEventLog event_log_;
+    MidiEventReplayer replayer_;
+#endif
+    
     bool initialized_ = false;
+    int output_budget_percent_ = 80;
+    ParameterMidiEncoder parameter_encoder_;   // Remembers NRPN selections sent
+    std::atomic<bool> encoder_reset_pending_{false};   // A sink (re)connected
     
     // Helper methods
     void createBackends();
     MidiBackend* getBackend(BackendType type) const;
+    MidiSenderThread* getSender(const MidiBackend* backend) const;
+    bool enqueueOutput(const MidiEvent& event);   // false if a sink dropped it
+    void enqueueRealTime(const MidiEvent& event);
+    void enqueueScheduled(const MidiEvent& event);
+    void dispatchInput();
+    void dispatchEvent(const TimedMidiEvent& timed);
+    void applyOutputBudget();
 };
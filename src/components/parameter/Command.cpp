@@ -12,7 +12,7 @@ uint32_t Command::getCurrentTime() {
 // SetParameterCommand Implementation
 // ============================================================================
 
-SetParameterCommand::SetParameterCommand(Parameter* parameter, uint8_t new_value)
+SetParameterCommand::SetParameterCommand(Parameter* parameter, uint16_t new_value)
     : parameter_(parameter), new_value_(new_value) {
     if (!parameter_) {
         throw std::invalid_argument("Parameter cannot be null");
@@ -75,7 +75,8 @@ ToggleParameterCommand::ToggleParameterCommand(Parameter* parameter)
     }
     
     old_value_ = parameter_->getCurrentValue();
-    new_value_ = (old_value_ == 0) ? 127 : 0;  // Toggle between 0 and 127
+    // Toggle between the ends of the range (0 and 127 for a 7-bit switch)
+    new_value_ = (old_value_ == parameter_->getMinValue()) ? parameter_->getMaxValue() : parameter_->getMinValue();
     parameter_name_ = parameter_->getName();
 }
 
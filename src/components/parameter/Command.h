@@ -65,7 +65,7 @@ class Parameter;
  */
 class SetParameterCommand : public Command {
 public:
-    SetParameterCommand(Parameter* parameter, uint8_t new_value);
+    SetParameterCommand(Parameter* parameter, uint16_t new_value);
     
     void execute() override;
     void undo() override;
@@ -76,8 +76,8 @@ public:
 
 private:
     Parameter* parameter_;
-    uint8_t old_value_;
-    uint8_t new_value_;
+    uint16_t old_value_;
+    uint16_t new_value_;
     std::string parameter_name_;  // Cache for description
     
     static constexpr uint32_t MERGE_WINDOW_MS = 500;  // 500ms window for merging
@@ -98,8 +98,8 @@ public:
 
 private:
     Parameter* parameter_;
-    uint8_t old_value_;
-    uint8_t new_value_;
+    uint16_t old_value_;
+    uint16_t new_value_;
     std::string parameter_name_;
 };
 
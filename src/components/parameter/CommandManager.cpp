@@ -1,4 +1,6 @@
 #include "CommandManager.h"
+#include "components/log/Log.h"
+#include "components/app/UiThread.h"
 #include <iostream>
 
 CommandManager::CommandManager()
@@ -11,6 +13,8 @@ CommandManager::CommandManager()
 }
 
 void CommandManager::executeCommand(std::unique_ptr<Command> command) {
+    ASSERT_UI_THREAD();
+    
     if (!command || is_executing_) {
         return;  // Prevent null commands and recursion
     }
@@ -19,7 +23,7 @@ void CommandManager::executeCommand(std::unique_ptr<Command> command) {
     if (merging_enabled_ && !undo_stack_.empty()) {
         auto& last_command = undo_stack_.back();
         if (last_command->canMerge(command.get())) {
-            std::cout << "Merging command: " << command->getDescription() << std::endl;
+            LOG_DEBUG("Command", "Merging command: %s", command->getDescription().c_str());
             last_command->mergeWith(command.get());
             // Execute the merged command to apply the new value
             is_executing_ = true;
@@ -34,9 +38,9 @@ void CommandManager::executeCommand(std::unique_ptr<Command> command) {
     is_executing_ = true;
     try {
         command->execute();
-        std::cout << "Executed command: " << command->getDescription() << std::endl;
+        LOG_DEBUG("Command", "Executed command: %s", command->getDescription().c_str());
     } catch (const std::exception& e) {
-        std::cerr << "Command execution failed: " << e.what() << std::endl;
+        LOG_ERROR("Command", "Command execution failed: %s", e.what());
         is_executing_ = false;
         return;
     }
@@ -55,6 +59,8 @@ void CommandManager::executeCommand(std::unique_ptr<Command> command) {
 }
 
 bool CommandManager::undo() {
+    ASSERT_UI_THREAD();
+    
     if (!canUndo() || is_executing_) {
         return false;
     }
@@ -65,10 +71,10 @@ bool CommandManager::undo() {
     
     try {
         command->undo();
-        std::cout << "Undid command: " << command->getDescription() << std::endl;
+        LOG_DEBUG("Command", "Undid command: %s", command->getDescription().c_str());
         redo_stack_.push_back(std::move(command));
     } catch (const std::exception& e) {
-        std::cerr << "Undo failed: " << e.what() << std::endl;
+        LOG_ERROR("Command", "Undo failed: %s", e.what());
         // Put command back in undo stack
         undo_stack_.push_back(std::move(command));
         is_executing_ = false;
@@ -81,6 +87,8 @@ bool CommandManager::undo() {
 }
 
 bool CommandManager::redo() {
+    ASSERT_UI_THREAD();
+    
     if (!canRedo() || is_executing_) {
         return false;
     }
@@ -91,10 +99,10 @@ bool CommandManager::redo() {
     
     try {
         command->execute();
-        std::cout << "Redid command: " << command->getDescription() << std::endl;
+        LOG_DEBUG("Command", "Redid command: %s", command->getDescription().c_str());
         undo_stack_.push_back(std::move(command));
     } catch (const std::exception& e) {
-        std::cerr << "Redo failed: " << e.what() << std::endl;
+        LOG_ERROR("Command", "Redo failed: %s", e.what());
         // Put command back in redo stack
         redo_stack_.push_back(std::move(command));
         is_executing_ = false;
@@ -121,6 +129,7 @@ std::string CommandManager::getRedoDescription() const {
 }
 
 void CommandManager::clearHistory() {
+    ASSERT_UI_THREAD();
     undo_stack_.clear();
     redo_stack_.clear();
     notifyHistoryChanged();
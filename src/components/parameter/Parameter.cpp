@@ -1,43 +1,81 @@
 #include "Parameter.h"
 #include "CommandManager.h"
 #include "Command.h"
+#include "components/app/UiThread.h"
 #include <algorithm>
 #include <cmath>
 
+namespace {
+    ParameterStore::Definition makeDefinition(const std::string& name,
+                                              const std::string& short_name,
+                                              uint8_t cc_number,
+                                              ParameterCategory category,
+                                              uint16_t min_value,
+                                              uint16_t max_value,
+                                              uint16_t default_value,
+                                              const std::string& description) {
+        ParameterStore::Definition definition;
+        definition.name = name;
+        definition.short_name = short_name;
+        definition.description = description;
+        definition.cc_number = cc_number;
+        definition.category = static_cast<uint8_t>(category);
+        definition.min_value = min_value;
+        definition.max_value = max_value;
+        definition.default_value = default_value;
+        return definition;
+    }
+}
+
 Parameter::Parameter(const std::string& name, 
                     const std::string& short_name,
                     uint8_t cc_number,
                     ParameterCategory category,
-                    uint8_t min_value,
-                    uint8_t max_value,
-                    uint8_t default_value,
+                    uint16_t min_value,
+                    uint16_t max_value,
+                    uint16_t default_value,
                     const std::string& description)
-    : name_(name)
-    , short_name_(short_name)
-    , cc_number_(cc_number)
-    , category_(category)
-    , min_value_(min_value)
-    , max_value_(max_value)
-    , default_value_(default_value)
-    , description_(description)
-    , current_value_(default_value)
-    , is_bipolar_(false)
-    , command_manager_(nullptr)
+    : Parameter(makeDefinition(name, short_name, cc_number, category,
+                               min_value, max_value, default_value, description))
 {
+}
+
+Parameter::Parameter(const ParameterStore::Definition& definition)
+    : command_manager_(nullptr)
+{
+    handle_ = store().create(definition, this);
+    
     // Auto-detect bipolar parameters based on common patterns
-    if (name.find("Detune") != std::string::npos || 
-        name.find("Bend") != std::string::npos ||
-        name.find("Fine") != std::string::npos ||
-        name.find("Cent") != std::string::npos) {
-        is_bipolar_ = true;
+    const std::string_view name = definition.name;
+    if (name.find("Detune") != std::string_view::npos || 
+        name.find("Bend") != std::string_view::npos ||
+        name.find("Fine") != std::string_view::npos ||
+        name.find("Cent") != std::string_view::npos) {
+        store().setBipolar(handle_, true);
     }
 }
 
-void Parameter::setValue(uint8_t value) {
+Parameter::~Parameter() {
+    // Leave any remaining observers unsubscribed rather than dangling
+    while (observers_) {
+        removeObserver(observers_);
+    }
+    store().destroy(handle_);
+}
+
+ParameterObserver::~ParameterObserver() {
+    if (observed_) {
+        observed_->removeObserver(this);
+    }
+}
+
+void Parameter::setValue(uint16_t value) {
+    ASSERT_UI_THREAD();
+    
     // Clamp to valid range
-    value = std::max(min_value_, std::min(max_value_, value));
+    value = std::max(getMinValue(), std::min(getMaxValue(), value));
     
-    if (current_value_ != value) {
+    if (getCurrentValue() != value) {
         if (command_manager_) {
             // Create command for undo/redo
             auto command = std::make_unique<SetParameterCommand>(this, value);
@@ -49,84 +87,134 @@ void Parameter::setValue(uint8_t value) {
     }
 }
 
-void Parameter::setValueDirect(uint8_t value) {
+void Parameter::setValueDirect(uint16_t value) {
+    ASSERT_UI_THREAD();
+    
     // Clamp to valid range
-    value = std::max(min_value_, std::min(max_value_, value));
+    value = std::max(getMinValue(), std::min(getMaxValue(), value));
     
-    if (current_value_ != value) {
-        current_value_ = value;
-        notifyObservers();
+    if (getCurrentValue() != value) {
+        store().setValue(handle_, value);
+        store().markDirty(handle_);   // Observers hear about it at the next flush
     }
 }
 
 void Parameter::resetToDefault() {
-    setValue(default_value_);
+    setValue(getDefaultValue());
 }
 
 bool Parameter::isAtDefault() const {
-    return current_value_ == default_value_;
+    return getCurrentValue() == getDefaultValue();
 }
 
 float Parameter::getValueAsPercent() const {
-    if (max_value_ == min_value_) return 0.0f;
-    return static_cast<float>(current_value_ - min_value_) / (max_value_ - min_value_);
+    uint16_t min_value = getMinValue();
+    uint16_t max_value = getMaxValue();
+    if (max_value == min_value) return 0.0f;
+    return static_cast<float>(getCurrentValue() - min_value) / (max_value - min_value);
 }
 
 void Parameter::setValueFromPercent(float percent) {
     percent = std::max(0.0f, std::min(1.0f, percent));
-    uint8_t new_value = min_value_ + static_cast<uint8_t>(percent * (max_value_ - min_value_));
+    uint16_t min_value = getMinValue();
+    uint16_t new_value = min_value + static_cast<uint16_t>(std::lround(percent * (getMaxValue() - min_value)));
     setValue(new_value);
 }
 
 bool Parameter::isBipolar() const {
-    return is_bipolar_;
+    return store().isBipolar(handle_);
 }
 
 void Parameter::setBipolar(bool bipolar) {
-    is_bipolar_ = bipolar;
+    store().setBipolar(handle_, bipolar);
 }
 
 int Parameter::getBipolarValue() const {
-    if (!is_bipolar_) return current_value_;
+    if (!isBipolar()) return getCurrentValue();
     
-    // Convert 0-127 MIDI value to -64 to +63 range
-    return static_cast<int>(current_value_) - 64;
+    // Convert 0-127 (0-16383) MIDI value to -64 to +63 (-8192 to +8191)
+    return static_cast<int>(getCurrentValue()) - getBipolarCenter();
 }
 
 void Parameter::setBipolarValue(int value) {
-    if (!is_bipolar_) {
-        setValue(static_cast<uint8_t>(value));
+    if (!isBipolar()) {
+        setValue(static_cast<uint16_t>(std::max(0, value)));
         return;
     }
     
     // Clamp to bipolar range
-    value = std::max(-64, std::min(63, value));
+    int center = getBipolarCenter();
+    value = std::max(-center, std::min(center - 1, value));
+    
+    // Convert back to the 0-127 (0-16383) MIDI value
+    setValue(static_cast<uint16_t>(value + center));
+}
+
+namespace {
+    // 7 <-> 14 bit: keeps the centre (64 <-> 8192) and both ends
+    uint16_t widenTo14Bit(uint16_t value) {
+        return value >= Parameter::MAX_VALUE_7BIT ? Parameter::MAX_VALUE_14BIT : static_cast<uint16_t>(value << 7);
+    }
+    uint16_t narrowTo7Bit(uint16_t value) {
+        return static_cast<uint16_t>(std::min<uint16_t>(value, Parameter::MAX_VALUE_14BIT) >> 7);
+    }
+}
+
+void Parameter::setHighResolution(bool high_resolution) {
+    ASSERT_UI_THREAD();
+    if (isHighResolution() == high_resolution) return;
     
-    // Convert -64 to +63 range to 0-127 MIDI value
-    setValue(static_cast<uint8_t>(value + 64));
+    auto scale = high_resolution ? widenTo14Bit : narrowTo7Bit;
+    store().setRange(handle_, scale(getMinValue()), scale(getMaxValue()),
+                     scale(getDefaultValue()), scale(getCurrentValue()));
+    store().setHighResolution(handle_, high_resolution);
+    store().markDirty(handle_);
 }
 
-void Parameter::addObserver(std::shared_ptr<ParameterObserver> observer) {
-    observers_.push_back(observer);
+void Parameter::addObserver(ParameterObserver* observer) {
+    ASSERT_UI_THREAD();
+    if (!observer || observer->observed_ == this) return;
+    
+    if (observer->observed_) {
+        observer->observed_->removeObserver(observer);
+    }
+    
+    observer->observed_ = this;
+    observer->prev_ = nullptr;
+    observer->next_ = observers_;
+    if (observers_) {
+        observers_->prev_ = observer;
+    }
+    observers_ = observer;
 }
 
-void Parameter::removeObserver(std::shared_ptr<ParameterObserver> observer) {
-    auto it = std::find_if(observers_.begin(), observers_.end(),
-        [&observer](const std::weak_ptr<ParameterObserver>& weak_obs) {
-            return weak_obs.lock() == observer;
-        });
+void Parameter::removeObserver(ParameterObserver* observer) {
+    ASSERT_UI_THREAD();
+    if (!observer || observer->observed_ != this) return;
     
-    if (it != observers_.end()) {
-        observers_.erase(it);
+    if (notify_next_ == observer) {
+        notify_next_ = observer->next_;
     }
+    if (observer->prev_) {
+        observer->prev_->next_ = observer->next_;
+    } else {
+        observers_ = observer->next_;
+    }
+    if (observer->next_) {
+        observer->next_->prev_ = observer->prev_;
+    }
+    
+    observer->observed_ = nullptr;
+    observer->prev_ = nullptr;
+    observer->next_ = nullptr;
 }
 
 std::string Parameter::getCategoryName() const {
-    return ParameterUtils::categoryToString(category_);
+    return ParameterUtils::categoryToString(getCategory());
 }
 
 std::string Parameter::getValueDisplayText() const {
-    if (is_bipolar_) {
+    if (isBipolar()) {
         int bipolar_val = getBipolarValue();
         if (bipolar_val >= 0) {
             return "+" + std::to_string(bipolar_val);
@@ -134,27 +222,20 @@ std::string Parameter::getValueDisplayText() const {
             return std::to_string(bipolar_val);
         }
     } else {
-        return std::to_string(current_value_);
+        return std::to_string(getCurrentValue());
     }
 }
 
 void Parameter::notifyObservers() {
-    cleanupObservers();
-    
-    for (auto& weak_obs : observers_) {
-        if (auto obs = weak_obs.lock()) {
-            obs->onParameterChanged(*this);
-        }
+    // An observer may unsubscribe itself or others from its callback;
+    // removeObserver() advances notify_next_ past anything it unlinks
+    ParameterObserver* observer = observers_;
+    while (observer) {
+        notify_next_ = observer->next_;
+        observer->onParameterChanged(*this);
+        observer = notify_next_;
     }
-}
-
-void Parameter::cleanupObservers() {
-    observers_.erase(
-        std::remove_if(observers_.begin(), observers_.end(),
-            [](const std::weak_ptr<ParameterObserver>& weak_obs) {
-                return weak_obs.expired();
-            }),
-        observers_.end());
+    notify_next_ = nullptr;
 }
 
 // ParameterUtils implementation
@@ -189,6 +270,7 @@ ParameterCategory ParameterUtils::stringToCategory(const std::string& category_s
     if (category_str == "Arpeggiator") return ParameterCategory::ARPEGGIATOR;
     if (category_str == "Effects") return ParameterCategory::EFFECTS;
     if (category_str == "Amplitude") return ParameterCategory::AMPLITUDE;
+    if (category_str == "Amp") return ParameterCategory::AMPLITUDE;   // hydrasynth.json
     return ParameterCategory::UNKNOWN;
 }
 
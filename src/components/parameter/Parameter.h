@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ParameterStore.h"
 #include <string>
 #include <vector>
 #include <functional>
@@ -30,32 +31,62 @@ enum class ParameterCategory {
  * 
  * Represents a single synthesizer parameter with all its properties.
  * This class is pure data and business logic, with no UI dependencies.
+ * 
+ * The data itself lives in a ParameterStore slot owned by this object; the
+ * Parameter keeps the handle, its observers and the undo integration.
  */
 class Parameter {
 public:
+    static constexpr uint8_t CHANNEL_DEFAULT = 0;   // Follow the synth definition's channel
+    static constexpr uint16_t NO_NRPN = 0xFFFF;
+    static constexpr uint16_t MAX_VALUE_7BIT = 127;
+    static constexpr uint16_t MAX_VALUE_14BIT = 16383;
+    
     Parameter(const std::string& name, 
               const std::string& short_name,
               uint8_t cc_number,
               ParameterCategory category,
-              uint8_t min_value = 0,
-              uint8_t max_value = 127,
-              uint8_t default_value = 64,
+              uint16_t min_value = 0,
+              uint16_t max_value = 127,
+              uint16_t default_value = 64,
               const std::string& description = "");
+    // Everything at once, e.g. from a loaded synth definition
+    explicit Parameter(const ParameterStore::Definition& definition);
+    ~Parameter();
+    
+    // Owns its store slot
+    Parameter(const Parameter&) = delete;
+    Parameter& operator=(const Parameter&) = delete;
+    
+    ParameterStore::Handle getHandle() const { return handle_; }
     
     // Getters
-    const std::string& getName() const { return name_; }
-    const std::string& getShortName() const { return short_name_; }
-    uint8_t getCCNumber() const { return cc_number_; }
-    ParameterCategory getCategory() const { return category_; }
-    uint8_t getMinValue() const { return min_value_; }
-    uint8_t getMaxValue() const { return max_value_; }
-    uint8_t getDefaultValue() const { return default_value_; }
-    const std::string& getDescription() const { return description_; }
-    uint8_t getCurrentValue() const { return current_value_; }
+    const std::string& getName() const { return store().getName(handle_); }
+    const std::string& getShortName() const { return store().getShortName(handle_); }
+    uint8_t getCCNumber() const { return store().getCCNumber(handle_); }
+    ParameterCategory getCategory() const { return static_cast<ParameterCategory>(store().getCategory(handle_)); }
+    uint16_t getMinValue() const { return store().getMinValue(handle_); }
+    uint16_t getMaxValue() const { return store().getMaxValue(handle_); }
+    uint16_t getDefaultValue() const { return store().getDefaultValue(handle_); }
+    const std::string& getDescription() const { return store().getDescription(handle_); }
+    uint16_t getCurrentValue() const { return store().getValue(handle_); }
+    
+    // MIDI addressing
+    uint8_t getMidiChannel() const { return store().getMidiChannel(handle_); }   // 1-16, or CHANNEL_DEFAULT
+    void setMidiChannel(uint8_t channel) { store().setMidiChannel(handle_, channel); }
+    uint16_t getNRPNNumber() const { return store().getNRPNNumber(handle_); }    // 0-16383, or NO_NRPN
+    void setNRPNNumber(uint16_t nrpn) { store().setNRPNNumber(handle_, nrpn); }
+    bool hasNRPN() const { return getNRPNNumber() != NO_NRPN; }
+    
+    // 14-bit values: sent as MSB/LSB pairs (CC n and n+32, or NRPN data
+    // entry 6 and 38) instead of one 7-bit CC. Switching rescales range,
+    // default and current value between 0-127 and 0-16383.
+    bool isHighResolution() const { return store().isHighResolution(handle_); }
+    void setHighResolution(bool high_resolution);
     
     // Value management
-    void setValue(uint8_t value);
-    void setValueDirect(uint8_t value);  // Bypasses command system (for undo/redo)
+    void setValue(uint16_t value);
+    void setValueDirect(uint16_t value);  // Bypasses command system (for undo/redo)
     void resetToDefault();
     bool isAtDefault() const;
     
@@ -66,48 +97,66 @@ public:
     float getValueAsPercent() const;
     void setValueFromPercent(float percent);
     
-    // Bipolar parameter support (-64 to +63 style)
+    // Bipolar parameter support (-64 to +63 style; -8192 to +8191 at 14 bits)
     bool isBipolar() const;
     void setBipolar(bool bipolar);
     int getBipolarValue() const;  // Returns -64 to +63
     void setBipolarValue(int value);  // Accepts -64 to +63
+    uint16_t getBipolarCenter() const { return isHighResolution() ? 8192 : 64; }
     
-    // Observer pattern for UI updates
-    void addObserver(std::shared_ptr<ParameterObserver> observer);
-    void removeObserver(std::shared_ptr<ParameterObserver> observer);
+    // Observer pattern for UI updates. O(1), no allocation; an observer
+    // added here is moved off any parameter it was observing before.
+    void addObserver(ParameterObserver* observer);
+    void removeObserver(ParameterObserver* observer);
     
     // Utility functions
     std::string getCategoryName() const;
     std::string getValueDisplayText() const;
     
 private:
-    std::string name_;
-    std::string short_name_;
-    uint8_t cc_number_;
-    ParameterCategory category_;
-    uint8_t min_value_;
-    uint8_t max_value_;
-    uint8_t default_value_;
-    std::string description_;
-    uint8_t current_value_;
-    bool is_bipolar_;
+    friend class ParameterStore;   // recall() notifies
+    
+    static ParameterStore& store() { return ParameterStore::getInstance(); }
+    
+    ParameterStore::Handle handle_;
     CommandManager* command_manager_;  // Injected dependency for undo/redo
     
-    std::vector<std::weak_ptr<ParameterObserver>> observers_;
+    // Intrusive list through the observers' hooks
+    ParameterObserver* observers_ = nullptr;
+    ParameterObserver* notify_next_ = nullptr;  // Kept valid if notified observers unsubscribe
     
     void notifyObservers();
-    void cleanupObservers();
 };
 
 /**
  * @brief Observer interface for parameter changes
  * 
  * UI controls implement this interface to receive parameter change notifications.
+ * 
+ * The observer carries its own list hook, so it can live anywhere (stack,
+ * arena, member, shared_ptr) and observes at most one parameter at a time.
+ * It unsubscribes itself when destroyed; a parameter destroyed first just
+ * leaves it unsubscribed.
  */
 class ParameterObserver {
 public:
-    virtual ~ParameterObserver() = default;
+    ParameterObserver() = default;
+    virtual ~ParameterObserver();
+    
+    // The hook is tied to this object's address
+    ParameterObserver(const ParameterObserver&) = delete;
+    ParameterObserver& operator=(const ParameterObserver&) = delete;
+    
     virtual void onParameterChanged(const Parameter& parameter) = 0;
+    
+    Parameter* getObservedParameter() const { return observed_; }
+    
+private:
+    friend class Parameter;
+    
+    Parameter* observed_ = nullptr;
+    ParameterObserver* prev_ = nullptr;
+    ParameterObserver* next_ = nullptr;
 };
 
 /**
@@ -1,4 +1,11 @@
 #include "ParameterBinder.h"
+#include "SynthDefinitionBlob.h"
+#include "SynthDefinitionReader.h"
+#include "Constants.h"
+#include "components/log/Log.h"
+#include "components/midi/MidiTime.h"
+#include "components/profiling/HeapUsage.h"
+#include <cstdio>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -17,25 +24,140 @@ ParameterBinder::~ParameterBinder() {
 }
 
 bool ParameterBinder::loadSynthDefinition(const std::string& synth_name) {
-    if (synth_name == "hydrasynth") {
-        // Create Hydrasynth definition from our existing JSON
-        current_synth_ = std::make_unique<SynthDefinition>();
-        current_synth_->name = "ASM Hydrasynth";
-        current_synth_->manufacturer = "Ashun Sound Machines";
-        current_synth_->description = "8-voice polyphonic wavetable synthesizer";
-        
-        // Create some key parameters for demonstration
-        current_synth_->parameters = ParameterFactory::createHydrasynthParameters();
-        
-        buildParameterMaps(*current_synth_);
-        return true;
+    uint64_t start_us = MidiTime::nowUs();
+    size_t heap_before = heapUsedBytes();
+    const char* source = nullptr;
+    
+    SynthDefinitionBlob blob;
+    if (SynthDefinitionBlob::openEmbedded(blob) && loadSynthDefinitionFromBlob(blob, synth_name)) {
+        source = "embedded blob";
+    }
+    
+#if !defined(ESP32_BUILD)
+    if (!source && loadSynthDefinitionFromFile(std::string(DEFINITION_DIR) + "/" + synth_name + ".json")) {
+        source = "JSON";
+    }
+#endif
+    
+    if (!source && synth_name == "hydrasynth") {
+        // Built-in subset, for builds without the definition files
+        auto synth_def = std::make_unique<SynthDefinition>();
+        synth_def->name = "ASM Hydrasynth";
+        synth_def->manufacturer = "Ashun Sound Machines";
+        synth_def->description = "8-voice polyphonic wavetable synthesizer";
+        synth_def->parameters = ParameterFactory::createHydrasynthParameters();
+        installSynthDefinition(std::move(synth_def));
+        source = "built-in set";
+    }
+    
+    if (!source) {
+        LOG_ERROR("ParameterBinder", "No definition found for '%s'", synth_name.c_str());
+        return false;
+    }
+    
+    LOG_INFO("ParameterBinder", "Loaded '%s' from %s: %zu parameters in %llu us, heap %+lld bytes",
+             synth_name.c_str(), source, current_synth_->parameters.size(),
+             (unsigned long long)(MidiTime::nowUs() - start_us),
+             (long long)heapUsedBytes() - (long long)heap_before);
+    return true;
+}
+
+bool ParameterBinder::loadSynthDefinitionFromFile(const std::string& file_path) {
+    std::FILE* file = std::fopen(file_path.c_str(), "rb");
+    if (!file) {
+        LOG_WARN("ParameterBinder", "Cannot open %s", file_path.c_str());
+        return false;
+    }
+    
+    // Streamed through a small buffer; the file is never held in memory
+    auto synth_def = std::make_unique<SynthDefinition>();
+    SynthDefinition& target = *synth_def;
+    SynthDefinitionReader reader([&target](const ParameterStore::Definition& definition) {
+        target.parameters.push_back(std::make_shared<Parameter>(definition));
+    });
+    
+    char buffer[512];
+    bool ok = true;
+    size_t length;
+    while (ok && (length = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        ok = reader.feed(buffer, length);
+    }
+    ok = ok && !std::ferror(file) && reader.finish();
+    std::fclose(file);
+    
+    return finishJsonDefinition(reader, ok, file_path.c_str(), std::move(synth_def));
+}
+
+bool ParameterBinder::loadSynthDefinitionFromJson(std::string_view json) {
+    auto synth_def = std::make_unique<SynthDefinition>();
+    SynthDefinition& target = *synth_def;
+    SynthDefinitionReader reader([&target](const ParameterStore::Definition& definition) {
+        target.parameters.push_back(std::make_shared<Parameter>(definition));
+    });
+    
+    bool ok = reader.parse(json);
+    return finishJsonDefinition(reader, ok, "JSON text", std::move(synth_def));
+}
+
+bool ParameterBinder::loadSynthDefinitionFromBlob(const SynthDefinitionBlob& blob, std::string_view synth_key) {
+    SynthDefinitionBlob::Synth entry;
+    if (!blob.isOpen() || !blob.findSynth(synth_key, entry)) return false;
+    
+    auto synth_def = std::make_unique<SynthDefinition>();
+    synth_def->name = std::string(entry.name);
+    synth_def->manufacturer = std::string(entry.manufacturer);
+    synth_def->description = std::string(entry.description);
+    synth_def->midi_channel = entry.midi_channel;
+    
+    synth_def->parameters.reserve(entry.parameter_count);
+    for (uint32_t i = 0; i < entry.parameter_count; ++i) {
+        synth_def->parameters.push_back(std::make_shared<Parameter>(blob.getParameter(entry.first_parameter + i)));
     }
     
-    return false;
+    installSynthDefinition(std::move(synth_def));
+    return true;
+}
+
+bool ParameterBinder::finishJsonDefinition(SynthDefinitionReader& reader, bool ok, const char* source,
+                                           std::unique_ptr<SynthDefinition> synth_def) {
+    if (!ok) {
+        LOG_ERROR("ParameterBinder", "%s:%zu: %s", source, reader.getLine(),
+                  reader.getError() ? reader.getError() : "Read error");
+        return false;
+    }
+    
+    const SynthDefinitionReader::Header& header = reader.getHeader();
+    synth_def->name = header.name;
+    synth_def->manufacturer = header.manufacturer;
+    synth_def->description = header.description;
+    synth_def->midi_channel = header.midi_channel;
+    installSynthDefinition(std::move(synth_def));
+    return true;
+}
+
+void ParameterBinder::installSynthDefinition(std::unique_ptr<SynthDefinition> synth_def) {
+    if (synth_def->midi_channel == 0) {
+        synth_def->midi_channel = SynthConstants::Midi::CHANNEL;
+    }
+    buildParameterMaps(*synth_def);
+    current_synth_ = std::move(synth_def);
 }
 
 std::vector<std::string> ParameterBinder::getAvailableSynths() const {
-    return {"hydrasynth"};  // For now, just Hydrasynth
+    std::vector<std::string> synths;
+    
+    SynthDefinitionBlob blob;
+    if (SynthDefinitionBlob::openEmbedded(blob)) {
+        for (size_t i = 0; i < blob.getSynthCount(); ++i) {
+            synths.emplace_back(blob.getSynth(i).key);
+        }
+    }
+    
+    // Always loadable, from JSON or the built-in set
+    if (std::find(synths.begin(), synths.end(), "hydrasynth") == synths.end()) {
+        synths.push_back("hydrasynth");
+    }
+    return synths;
 }
 
 std::string ParameterBinder::getCurrentSynthName() const {
@@ -60,6 +182,23 @@ std::shared_ptr<Parameter> ParameterBinder::findParameterByCC(uint8_t cc_number)
     return (it != current_synth_->parameter_by_cc.end()) ? it->second : nullptr;
 }
 
+Parameter* ParameterBinder::dispatchNRPN(uint8_t channel, uint16_t nrpn_number) const {
+    if (!current_synth_) return nullptr;
+    
+    const auto& index = current_synth_->nrpn_dispatch;
+    uint32_t key = (static_cast<uint32_t>(channel & 0x0F) << 14) | (nrpn_number & 0x3FFF);
+    auto it = std::lower_bound(index.begin(), index.end(), key,
+        [](const std::pair<uint32_t, Parameter*>& entry, uint32_t k) { return entry.first < k; });
+    return (it != index.end() && it->first == key) ? it->second : nullptr;
+}
+
+void ParameterBinder::setSynthMidiChannel(uint8_t channel) {
+    if (!current_synth_ || channel > 16) return;
+    
+    current_synth_->midi_channel = channel;
+    buildParameterMaps(*current_synth_);
+}
+
 std::vector<std::shared_ptr<Parameter>> ParameterBinder::getParametersByCategory(ParameterCategory category) const {
     if (!current_synth_) return {};
     
@@ -127,17 +266,45 @@ void ParameterBinder::buildParameterMaps(SynthDefinition& synth_def) {
     synth_def.parameter_by_name.clear();
     synth_def.parameter_by_cc.clear();
     synth_def.parameters_by_category.clear();
+    for (auto& row : synth_def.cc_dispatch) {
+        row.fill(nullptr);
+    }
+    synth_def.nrpn_dispatch.clear();
     
     for (const auto& param : synth_def.parameters) {
         // Build name lookup
         synth_def.parameter_by_name[param->getName()] = param;
         
         // Build CC lookup
-        synth_def.parameter_by_cc[param->getCCNumber()] = param;
+        if (param->getCCNumber() <= 127) {
+            synth_def.parameter_by_cc[param->getCCNumber()] = param;
+        }
         
         // Build category lookup
         synth_def.parameters_by_category[param->getCategory()].push_back(param);
+        
+        // Build MIDI input dispatch: a parameter listens on its own channel,
+        // else the synth's channel, else (omni) on all 16
+        uint8_t channel = param->getMidiChannel() != Parameter::CHANNEL_DEFAULT ?
+                          param->getMidiChannel() : synth_def.midi_channel;
+        uint8_t first = channel ? channel - 1 : 0;
+        uint8_t last = channel ? channel - 1 : 15;
+        
+        for (uint8_t ch = first; ch <= last; ++ch) {
+            if (param->getCCNumber() <= 127) {
+                synth_def.cc_dispatch[ch][param->getCCNumber()] = param.get();
+            }
+            if (param->hasNRPN()) {
+                uint32_t key = (static_cast<uint32_t>(ch) << 14) | (param->getNRPNNumber() & 0x3FFF);
+                synth_def.nrpn_dispatch.emplace_back(key, param.get());
+            }
+        }
     }
+    
+    std::sort(synth_def.nrpn_dispatch.begin(), synth_def.nrpn_dispatch.end(),
+        [](const std::pair<uint32_t, Parameter*>& a, const std::pair<uint32_t, Parameter*>& b) {
+            return a.first < b.first;
+        });
 }
 
 // ============================================================================
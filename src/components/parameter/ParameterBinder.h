@@ -2,10 +2,15 @@
 
 #include "Parameter.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <array>
 #include <memory>
 
+class SynthDefinitionBlob;
+class SynthDefinitionReader;
+
 /**
  * @brief Manages synthesizer parameter definitions and control bindings
  * 
@@ -17,9 +22,15 @@ public:
     ParameterBinder();
     ~ParameterBinder();
     
-    // Synthesizer definition management
+    // Synthesizer definition management. loadSynthDefinition() takes the
+    // first of: the blob embedded in the firmware, DEFINITION_DIR/<name>.json
+    // (desktop), the built-in set ("hydrasynth" only), and logs the time and
+    // heap it took. A failed load keeps the current definition.
+    static constexpr const char* DEFINITION_DIR = "src/config";
     bool loadSynthDefinition(const std::string& synth_name);
     bool loadSynthDefinitionFromFile(const std::string& file_path);
+    bool loadSynthDefinitionFromJson(std::string_view json);
+    bool loadSynthDefinitionFromBlob(const SynthDefinitionBlob& blob, std::string_view synth_key);
     std::vector<std::string> getAvailableSynths() const;
     std::string getCurrentSynthName() const;
     
@@ -27,6 +38,18 @@ public:
     std::shared_ptr<Parameter> findParameterByName(const std::string& name) const;
     std::shared_ptr<Parameter> getParameter(const std::string& name) const;  // Alias for findParameterByName
     std::shared_ptr<Parameter> findParameterByCC(uint8_t cc_number) const;
+    
+    // Hot-path MIDI input lookups: flat table / sorted index, no refcounting.
+    // Channels are 0-based (status byte low nibble). Pointers stay valid until
+    // the next loadSynthDefinition().
+    Parameter* dispatchCC(uint8_t channel, uint8_t cc_number) const {
+        return current_synth_ ? current_synth_->cc_dispatch[channel & 0x0F][cc_number & 0x7F] : nullptr;
+    }
+    Parameter* dispatchNRPN(uint8_t channel, uint16_t nrpn_number) const;
+    
+    // Channel (1-16, 0 = omni) used by parameters that don't set their own
+    void setSynthMidiChannel(uint8_t channel);
+    uint8_t getSynthMidiChannel() const { return current_synth_ ? current_synth_->midi_channel : 0; }
     std::vector<std::shared_ptr<Parameter>> getParametersByCategory(ParameterCategory category) const;
     std::vector<std::shared_ptr<Parameter>> searchParameters(const std::string& query) const;
     std::vector<std::shared_ptr<Parameter>> getAllParameters() const;
@@ -37,9 +60,9 @@ public:
         const std::string& short_name,
         uint8_t cc_number,
         ParameterCategory category,
-        uint8_t min_value = 0,
-        uint8_t max_value = 127,
-        uint8_t default_value = 64,
+        uint16_t min_value = 0,
+        uint16_t max_value = 127,
+        uint16_t default_value = 64,
         const std::string& description = ""
     );
     
@@ -65,6 +88,11 @@ private:
         std::map<std::string, std::shared_ptr<Parameter>> parameter_by_name;
         std::map<uint8_t, std::shared_ptr<Parameter>> parameter_by_cc;
         std::map<ParameterCategory, std::vector<std::shared_ptr<Parameter>>> parameters_by_category;
+        
+        // MIDI input dispatch, rebuilt by buildParameterMaps()
+        uint8_t midi_channel = 0;
+        std::array<std::array<Parameter*, 128>, 16> cc_dispatch{};
+        std::vector<std::pair<uint32_t, Parameter*>> nrpn_dispatch;  // Sorted by (channel << 14 | nrpn)
     };
     
     std::unique_ptr<SynthDefinition> current_synth_;
@@ -72,9 +100,9 @@ private:
     
     // Helper methods
     void buildParameterMaps(SynthDefinition& synth_def);
-    bool parseJsonDefinition(const std::string& json_content, SynthDefinition& synth_def);
-    std::shared_ptr<Parameter> createParameterFromJson(const std::string& param_name, 
-                                                      const std::string& json_content);
+    void installSynthDefinition(std::unique_ptr<SynthDefinition> synth_def);
+    bool finishJsonDefinition(SynthDefinitionReader& reader, bool ok, const char* source,
+                              std::unique_ptr<SynthDefinition> synth_def);
 };
 
 /**
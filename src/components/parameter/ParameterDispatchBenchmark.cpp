@@ -0,0 +1,105 @@
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "ParameterDispatchBenchmark.h"
+#include "ParameterBinder.h"
+#include "components/midi/MidiTime.h"
+#include <array>
+#include <cstdio>
+#include <map>
+#include <string>
+
+namespace {
+    constexpr size_t MESSAGE_COUNT = 4096;
+
+    double perLookupNs(uint64_t start_ns, size_t lookups) {
+        return double(MidiTime::nowNs() - start_ns) / lookups;
+    }
+
+    std::string makeJson(size_t count) {
+        std::string json = "{\"name\": \"Dispatch Benchmark\", \"midi_channel\": 1, \"categories\": "
+                           "{\"Filters\": {\"parameters\": {";
+        for (size_t i = 0; i < count; ++i) {
+            std::string index = std::to_string(i);
+            json += i ? ", " : "";
+            json += "\"Param_" + index + "\": {";
+            if (i < 128) json += "\"cc\": " + index + ", ";
+            json += "\"nrpn\": " + std::to_string(i & 0x3FFF) + "}";
+        }
+        json += "}}}}";
+        return json;
+    }
+
+    struct Message {
+        uint8_t channel;
+        uint16_t number;
+    };
+}
+
+void runParameterDispatchBenchmark(size_t count, size_t iterations) {
+    ParameterBinder binder;
+    if (!binder.loadSynthDefinitionFromJson(makeJson(count))) {
+        std::printf("Dispatch benchmark: definition failed to load\n");
+        return;
+    }
+
+    // Same stream for every variant; odd entries are on channels nothing listens to
+    std::array<Message, MESSAGE_COUNT> messages;
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < MESSAGE_COUNT; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        messages[i].channel = (i & 1) ? static_cast<uint8_t>(1 + (seed >> 28) % 15) : 0;
+        messages[i].number = static_cast<uint16_t>((seed >> 8) % (count < 128 ? 128 : count));
+    }
+
+    std::map<uint32_t, Parameter*> nrpn_tree;
+    for (const auto& param : binder.getAllParameters()) {
+        nrpn_tree[param->getNRPNNumber() & 0x3FFF] = param.get();   // Channel 1 -> key prefix 0
+    }
+
+    size_t lookups = iterations * MESSAGE_COUNT;
+    size_t hits[4] = {};
+
+    uint64_t start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (const Message& message : messages) {
+            // The old path ignored the channel, so it also "hits" the other half
+            hits[0] += binder.findParameterByCC(message.number & 0x7F) != nullptr;
+        }
+    }
+    double cc_tree_ns = perLookupNs(start, lookups);
+
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (const Message& message : messages) {
+            hits[1] += binder.dispatchCC(message.channel, message.number & 0x7F) != nullptr;
+        }
+    }
+    double cc_flat_ns = perLookupNs(start, lookups);
+
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (const Message& message : messages) {
+            uint32_t key = (static_cast<uint32_t>(message.channel) << 14) | (message.number & 0x3FFF);
+            hits[2] += nrpn_tree.find(key) != nrpn_tree.end();
+        }
+    }
+    double nrpn_tree_ns = perLookupNs(start, lookups);
+
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (const Message& message : messages) {
+            hits[3] += binder.dispatchNRPN(message.channel, message.number & 0x3FFF) != nullptr;
+        }
+    }
+    double nrpn_flat_ns = perLookupNs(start, lookups);
+
+    std::printf("=== Parameter Dispatch Benchmark: %zu parameters, %zu lookups ===\n",
+                binder.getParameterCount(), lookups);
+    std::printf("  CC:    std::map %6.1f ns   dispatchCC   %6.1f ns   (hits %zu / %zu)\n",
+                cc_tree_ns, cc_flat_ns, hits[0], hits[1]);
+    std::printf("  NRPN:  std::map %6.1f ns   dispatchNRPN %6.1f ns   (hits %zu / %zu)\n",
+                nrpn_tree_ns, nrpn_flat_ns, hits[2], hits[3]);
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,21 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <cstddef>
+
+/**
+ * @brief Times incoming CC / NRPN lookups: the tree maps against the flat
+ * dispatch tables
+ *
+ * Loads a definition with `count` parameters on channel 1 (the first 128 on
+ * a CC each, all on an NRPN each) and looks up a fixed stream of messages,
+ * half of them on other channels, through:
+ * - CC:   findParameterByCC() (std::map plus shared_ptr copy, the input
+ *         path before dispatchCC) vs dispatchCC()
+ * - NRPN: a std::map keyed like nrpn_dispatch vs dispatchNRPN()
+ * Run with --bench-dispatch.
+ */
+void runParameterDispatchBenchmark(size_t count, size_t iterations = 1000);
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,139 @@
+#include "ParameterMidiCodec.h"
+#include "Parameter.h"
+#include "ParameterBinder.h"
+
+namespace {
+    // Controller numbers (MIDI 1.0 spec)
+    constexpr uint8_t CC_DATA_ENTRY_MSB = 6;
+    constexpr uint8_t CC_LSB_OFFSET = 32;
+    constexpr uint8_t CC_DATA_ENTRY_LSB = CC_DATA_ENTRY_MSB + CC_LSB_OFFSET;
+    constexpr uint8_t CC_NRPN_LSB = 98;
+    constexpr uint8_t CC_NRPN_MSB = 99;
+    constexpr uint8_t CC_RPN_LSB = 100;
+    constexpr uint8_t CC_RPN_MSB = 101;
+    constexpr uint8_t RPN_NULL = 127;
+
+    bool hasLsbController(uint8_t cc) { return cc < CC_LSB_OFFSET; }
+}
+
+// ============================================================================
+// ParameterMidiEncoder
+// ============================================================================
+
+size_t ParameterMidiEncoder::encode(const Parameter& parameter, uint8_t channel, uint16_t value,
+                                    uint64_t now_ns, MidiEvent* out) {
+    channel &= 0x0F;
+    ChannelState& state = channels_[channel];
+    bool high_resolution = parameter.isHighResolution();
+    if (value > Parameter::MAX_VALUE_14BIT) value = Parameter::MAX_VALUE_14BIT;
+
+    uint8_t msb = high_resolution ? static_cast<uint8_t>(value >> 7) : static_cast<uint8_t>(value & 0x7F);
+    uint8_t lsb = static_cast<uint8_t>(value & 0x7F);
+    size_t count = 0;
+
+    if (parameter.hasNRPN()) {
+        uint16_t nrpn = parameter.getNRPNNumber() & 0x3FFF;
+        if (state.nrpn != nrpn || now_ns - state.selected_ns >= SELECT_REFRESH_NS) {
+            out[count++] = MidiEvent::controlChange(channel, CC_NRPN_MSB, static_cast<uint8_t>(nrpn >> 7));
+            out[count++] = MidiEvent::controlChange(channel, CC_NRPN_LSB, static_cast<uint8_t>(nrpn & 0x7F));
+            state.nrpn = nrpn;
+            state.selected_ns = now_ns;
+        }
+        out[count++] = MidiEvent::controlChange(channel, CC_DATA_ENTRY_MSB, msb);
+        if (high_resolution) {
+            out[count++] = MidiEvent::controlChange(channel, CC_DATA_ENTRY_LSB, lsb);
+        }
+        return count;
+    }
+
+    if (parameter.getCCNumber() > 127) return 0;   // No MIDI address
+    uint8_t cc = parameter.getCCNumber();
+
+    if (cc == CC_DATA_ENTRY_MSB || cc == CC_DATA_ENTRY_LSB) {
+        // Plain CC 6 / 38 would be taken as data entry for a selected NRPN
+        if (state.nrpn != NO_SELECTION) {
+            out[count++] = MidiEvent::controlChange(channel, CC_RPN_MSB, RPN_NULL);
+            out[count++] = MidiEvent::controlChange(channel, CC_RPN_LSB, RPN_NULL);
+            state.nrpn = NO_SELECTION;
+        }
+    } else if (cc >= CC_NRPN_LSB && cc <= CC_RPN_MSB) {
+        // Moves the receiver's selection; the next NRPN must select again
+        state.nrpn = NO_SELECTION;
+    }
+
+    out[count++] = MidiEvent::controlChange(channel, cc, msb);
+    if (high_resolution && hasLsbController(cc)) {
+        out[count++] = MidiEvent::controlChange(channel, cc + CC_LSB_OFFSET, lsb);
+    }
+    return count;
+}
+
+void ParameterMidiEncoder::reset() {
+    channels_.fill(ChannelState{});
+}
+
+// ============================================================================
+// ParameterMidiDecoder
+// ============================================================================
+
+ParameterMidiDecoder::ParameterMidiDecoder() {
+    reset();
+}
+
+void ParameterMidiDecoder::reset() {
+    channels_.fill(ChannelState{});
+}
+
+Parameter* ParameterMidiDecoder::decode(const ParameterBinder& binder, uint8_t channel, uint8_t cc,
+                                        uint8_t value, uint16_t& value_out) {
+    channel &= 0x0F;
+    cc &= 0x7F;
+    value &= 0x7F;
+    ChannelState& state = channels_[channel];
+    Parameter* param = nullptr;
+
+    switch (cc) {
+        case CC_NRPN_MSB:
+            state.nrpn = static_cast<uint16_t>((value << 7) | (state.nrpn & 0x7F));
+            return nullptr;
+        case CC_NRPN_LSB:
+            state.nrpn = static_cast<uint16_t>((state.nrpn & 0x3F80) | value);
+            return nullptr;
+        case CC_RPN_MSB:   // RPN select deselects any NRPN
+        case CC_RPN_LSB:
+            state.nrpn = NO_SELECTION;
+            return nullptr;
+        case CC_DATA_ENTRY_MSB:
+            if (state.nrpn == NO_SELECTION) break;
+            state.data_msb = value;
+            param = binder.dispatchNRPN(channel, state.nrpn);
+            if (!param) return nullptr;
+            value_out = param->isHighResolution() ? static_cast<uint16_t>(value << 7) : value;
+            return param;
+        case CC_DATA_ENTRY_LSB:
+            if (state.nrpn == NO_SELECTION) break;
+            param = binder.dispatchNRPN(channel, state.nrpn);
+            if (!param || !param->isHighResolution()) return nullptr;
+            value_out = static_cast<uint16_t>((state.data_msb << 7) | value);
+            return param;
+        default:
+            break;
+    }
+
+    if (hasLsbController(cc)) {
+        state.cc_msb[cc] = value;
+    } else if (cc < 2 * CC_LSB_OFFSET) {
+        // LSB half of a 14-bit pair, if its MSB controller is one
+        uint8_t msb_cc = cc - CC_LSB_OFFSET;
+        param = binder.dispatchCC(channel, msb_cc);
+        if (param && param->isHighResolution()) {
+            value_out = static_cast<uint16_t>((state.cc_msb[msb_cc] << 7) | value);
+            return param;
+        }
+    }
+
+    param = binder.dispatchCC(channel, cc);
+    if (!param) return nullptr;
+    value_out = param->isHighResolution() ? static_cast<uint16_t>(value << 7) : value;
+    return param;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "components/midi/MidiEvent.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Parameter;
+class ParameterBinder;
+
+/**
+ * @brief Turns parameter values into CC / NRPN message sequences
+ *
+ * - 7-bit CC parameter: one CC.
+ * - 14-bit CC parameter (CC 0-31): MSB on CC n, then LSB on CC n+32.
+ *   A 14-bit parameter on CC 32 or above has no LSB controller and is sent
+ *   as its top 7 bits.
+ * - NRPN parameter: select with CC 99/98, then data entry CC 6 (MSB) and,
+ *   for 14-bit parameters, CC 38 (LSB).
+ * - Neither (CC number above 127, no NRPN): nothing.
+ *
+ * The NRPN last selected on each channel is remembered, and the 99/98 pair
+ * is left out while consecutive changes go to the same NRPN, so turning one
+ * NRPN knob costs 2 or 4 bytes per step (with running status) instead of 6
+ * or 8. Like running status in MidiSerialEncoder, the selection is re-sent
+ * at least every SELECT_REFRESH_NS so a receiver that missed it recovers.
+ *
+ * UI thread only.
+ */
+class ParameterMidiEncoder {
+public:
+    static constexpr size_t MAX_EVENTS = 4;
+    static constexpr uint64_t SELECT_REFRESH_NS = 200000000ULL;  // 200 ms
+
+    // Messages for value on channel (0-15) into out (at least MAX_EVENTS);
+    // returns how many
+    size_t encode(const Parameter& parameter, uint8_t channel, uint16_t value, uint64_t now_ns, MidiEvent* out);
+
+    // Re-send every NRPN selection (e.g. after the port was reopened)
+    void reset();
+
+private:
+    static constexpr uint16_t NO_SELECTION = 0xFFFF;
+
+    struct ChannelState {
+        uint16_t nrpn = NO_SELECTION;
+        uint64_t selected_ns = 0;
+    };
+    std::array<ChannelState, 16> channels_;
+};
+
+/**
+ * @brief Reassembles incoming CC / NRPN sequences into parameter values
+ *
+ * Keeps, per channel, the selected NRPN (CC 99/98, cleared by an RPN select
+ * on 101/100), the last data entry MSB and the last MSB of each of CC 0-31.
+ * An MSB applies straight away with a zero LSB, as the MIDI spec has it; the
+ * LSB that follows completes the value. Parameter values only reach
+ * observers at the next ParameterStore flush, so a pair arriving together
+ * redraws once with its final value.
+ *
+ * UI thread only (fed from UnifiedMidiManager::update()).
+ */
+class ParameterMidiDecoder {
+public:
+    ParameterMidiDecoder();
+
+    // Feed one CC (channel 0-15). Returns the parameter it sets, with its
+    // new value in value_out, or nullptr if it only updated state.
+    Parameter* decode(const ParameterBinder& binder, uint8_t channel, uint8_t cc, uint8_t value, uint16_t& value_out);
+
+    void reset();
+
+private:
+    static constexpr uint16_t NO_SELECTION = 0x3FFF;
+
+    struct ChannelState {
+        uint16_t nrpn = NO_SELECTION;
+        uint8_t data_msb = 0;
+        std::array<uint8_t, 32> cc_msb{};
+    };
+    std::array<ChannelState, 16> channels_;
+};
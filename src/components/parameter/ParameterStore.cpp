@@ -0,0 +1,173 @@
+#include "ParameterStore.h"
+#include "Parameter.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
+#include <algorithm>
+
+ParameterStore& ParameterStore::getInstance() {
+    // Never destroyed: Parameters owned by globals (SynthApp's binder) are
+    // released after function-local statics, and still call destroy()
+    static ParameterStore* instance = new ParameterStore;
+    return *instance;
+}
+
+ParameterStore::ParameterStore() {
+    intern("");   // Id 0
+}
+
+uint32_t ParameterStore::intern(std::string_view text) {
+    auto it = string_ids_.find(text);
+    if (it != string_ids_.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace_back(text);
+    string_ids_.emplace(strings_.back(), id);
+    return id;
+}
+
+ParameterStore::Handle ParameterStore::create(const Definition& definition, Parameter* owner) {
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        if (generations_.size() >= MAX_SLOTS) {
+            LOG_ERROR("ParameterStore", "Out of slots (%u)", MAX_SLOTS);
+            return Handle{};
+        }
+        index = static_cast<uint32_t>(generations_.size());
+        values_.push_back(0);
+        min_values_.push_back(0);
+        max_values_.push_back(0);
+        default_values_.push_back(0);
+        cc_numbers_.push_back(0);
+        midi_channels_.push_back(0);
+        nrpn_numbers_.push_back(0);
+        categories_.push_back(0);
+        flags_.push_back(0);
+        name_ids_.push_back(0);
+        short_name_ids_.push_back(0);
+        description_ids_.push_back(0);
+        owners_.push_back(nullptr);
+        generations_.push_back(1);
+        if (index / 64 >= dirty_.size()) {
+            dirty_.push_back(0);
+        }
+    }
+
+    values_[index] = definition.default_value;
+    min_values_[index] = definition.min_value;
+    max_values_[index] = definition.max_value;
+    default_values_[index] = definition.default_value;
+    cc_numbers_[index] = definition.cc_number;
+    midi_channels_[index] = definition.midi_channel;
+    nrpn_numbers_[index] = definition.nrpn_number;
+    categories_[index] = definition.category;
+    flags_[index] = (definition.bipolar ? FLAG_BIPOLAR : 0) |
+                    (definition.high_resolution ? FLAG_HIGH_RESOLUTION : 0);
+    name_ids_[index] = intern(definition.name);
+    short_name_ids_[index] = intern(definition.short_name);
+    description_ids_[index] = intern(definition.description);
+    owners_[index] = owner;
+
+    return handleAt(index);
+}
+
+void ParameterStore::destroy(Handle handle) {
+    if (!isValid(handle)) return;
+
+    uint32_t index = handle.index();
+    owners_[index] = nullptr;
+    dirty_[index / 64] &= ~(1ULL << (index % 64));
+    // Invalidate outstanding handles; wrap past 0, which means null
+    uint16_t generation = static_cast<uint16_t>((generations_[index] + 1) & GENERATION_MASK);
+    generations_[index] = generation ? generation : 1;
+    free_slots_.push_back(index);
+}
+
+void ParameterStore::setBipolar(Handle h, bool bipolar) {
+    if (bipolar) {
+        flags_[h.index()] |= FLAG_BIPOLAR;
+    } else {
+        flags_[h.index()] &= static_cast<uint8_t>(~FLAG_BIPOLAR);
+    }
+}
+
+void ParameterStore::setHighResolution(Handle h, bool high_resolution) {
+    if (high_resolution) {
+        flags_[h.index()] |= FLAG_HIGH_RESOLUTION;
+    } else {
+        flags_[h.index()] &= static_cast<uint8_t>(~FLAG_HIGH_RESOLUTION);
+    }
+}
+
+void ParameterStore::setRange(Handle h, uint16_t min_value, uint16_t max_value,
+                              uint16_t default_value, uint16_t value) {
+    uint32_t index = h.index();
+    min_values_[index] = min_value;
+    max_values_[index] = max_value;
+    default_values_[index] = default_value;
+    values_[index] = value;
+}
+
+void ParameterStore::markDirty(Handle h) {
+    uint32_t index = h.index();
+    dirty_[index / 64] |= 1ULL << (index % 64);
+    
+    if (!any_dirty_) {
+        // Make sure the loop comes round to flush before it sleeps
+        any_dirty_ = true;
+        LoopScheduler::getInstance().wake(LoopScheduler::Source::OTHER);
+    }
+}
+
+size_t ParameterStore::flushNotifications() {
+    if (!any_dirty_) return 0;
+    any_dirty_ = false;
+
+    size_t notified = 0;
+    for (size_t word = 0; word < dirty_.size(); ++word) {
+        // Take the word first: observers that change values mark them
+        // for the next flush instead of looping here
+        uint64_t bits = dirty_[word];
+        dirty_[word] = 0;
+
+        while (bits) {
+            uint32_t index = static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+
+            if (Parameter* owner = owners_[index]) {
+                owner->notifyObservers();
+                notified++;
+            }
+        }
+    }
+    return notified;
+}
+
+ParameterStore::Snapshot ParameterStore::snapshot() const {
+    Snapshot out;
+    snapshot(out);
+    return out;
+}
+
+void ParameterStore::snapshot(Snapshot& out) const {
+    out.values.assign(values_.begin(), values_.end());
+    out.generations.assign(generations_.begin(), generations_.end());
+}
+
+size_t ParameterStore::recall(const Snapshot& snapshot) {
+    size_t count = std::min({snapshot.values.size(), snapshot.generations.size(), values_.size()});
+    size_t changed = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (values_[i] == snapshot.values[i] || generations_[i] != snapshot.generations[i]) continue;
+
+        if (!owners_[i]) continue;   // Slot freed since, not reused
+
+        values_[i] = snapshot.values[i];
+        markDirty(handleAt(static_cast<uint32_t>(i)));
+        changed++;
+    }
+    return changed;
+}
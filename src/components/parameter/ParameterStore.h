@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class Parameter;
+
+/**
+ * @brief Contiguous storage for every parameter's data
+ *
+ * Each field lives in its own array indexed by slot (structure of arrays), so
+ * scanning or copying all current values touches one dense array instead of
+ * one heap object per parameter. Names, short names and descriptions are
+ * interned: each distinct string is stored once and slots keep 32-bit ids.
+ *
+ * Slots are addressed through 32-bit generational handles (20-bit index,
+ * 12-bit generation). Destroying a slot bumps its generation, so a handle
+ * kept past its parameter's lifetime fails isValid() instead of reaching
+ * whichever parameter reuses the slot.
+ *
+ * Parameter is a thin facade that owns one slot. The accessors below do not
+ * check the handle; use isValid() on handles of unknown age. UI thread only.
+ *
+ * Value changes only mark their slot in a dirty bitset; the loop calls
+ * flushNotifications() once per iteration, which notifies each changed
+ * parameter's observers once, with its final value. A burst of 50 CCs for
+ * one knob within a frame costs one redraw request instead of 50.
+ */
+class ParameterStore {
+public:
+    struct Handle {
+        uint32_t bits = 0;   // 0 = null
+
+        static constexpr uint32_t INDEX_BITS = 20;
+        static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+        uint32_t index() const { return bits & INDEX_MASK; }
+        uint16_t generation() const { return static_cast<uint16_t>(bits >> INDEX_BITS); }
+        explicit operator bool() const { return bits != 0; }
+        bool operator==(const Handle& other) const { return bits == other.bits; }
+        bool operator!=(const Handle& other) const { return bits != other.bits; }
+    };
+
+    static constexpr uint32_t MAX_SLOTS = Handle::INDEX_MASK + 1;
+
+    struct Definition {
+        std::string_view name;
+        std::string_view short_name;
+        std::string_view description;
+        uint8_t cc_number = 0;
+        uint8_t category = 0;       // ParameterCategory
+        uint16_t min_value = 0;
+        uint16_t max_value = 127;
+        uint16_t default_value = 64;
+        uint8_t midi_channel = 0;          // 0 = follow the synth definition
+        uint16_t nrpn_number = 0xFFFF;     // 0xFFFF = no NRPN
+        bool bipolar = false;
+        bool high_resolution = false;      // Range is already 14-bit
+    };
+
+    // Current values of every slot, see snapshot() / recall()
+    struct Snapshot {
+        std::vector<uint16_t> values;
+        std::vector<uint16_t> generations;   // Slots reused since are skipped on recall
+    };
+
+    static ParameterStore& getInstance();
+
+    Handle create(const Definition& definition, Parameter* owner);
+    void destroy(Handle handle);
+    bool isValid(Handle handle) const {
+        return handle && handle.index() < generations_.size() &&
+               generations_[handle.index()] == handle.generation();
+    }
+    size_t size() const { return generations_.size() - free_slots_.size(); }
+
+    // Values (0-127 for 7-bit parameters, 0-16383 for high-resolution ones)
+    uint16_t getValue(Handle h) const { return values_[h.index()]; }
+    void setValue(Handle h, uint16_t value) { values_[h.index()] = value; }
+    uint16_t getMinValue(Handle h) const { return min_values_[h.index()]; }
+    uint16_t getMaxValue(Handle h) const { return max_values_[h.index()]; }
+    uint16_t getDefaultValue(Handle h) const { return default_values_[h.index()]; }
+    // Replaces range, default and current value together (resolution changes)
+    void setRange(Handle h, uint16_t min_value, uint16_t max_value, uint16_t default_value, uint16_t value);
+
+    // MIDI addressing
+    uint8_t getCCNumber(Handle h) const { return cc_numbers_[h.index()]; }
+    uint8_t getMidiChannel(Handle h) const { return midi_channels_[h.index()]; }
+    void setMidiChannel(Handle h, uint8_t channel) { midi_channels_[h.index()] = channel; }
+    uint16_t getNRPNNumber(Handle h) const { return nrpn_numbers_[h.index()]; }
+    void setNRPNNumber(Handle h, uint16_t nrpn) { nrpn_numbers_[h.index()] = nrpn; }
+
+    uint8_t getCategory(Handle h) const { return categories_[h.index()]; }
+    bool isBipolar(Handle h) const { return flags_[h.index()] & FLAG_BIPOLAR; }
+    void setBipolar(Handle h, bool bipolar);
+    bool isHighResolution(Handle h) const { return flags_[h.index()] & FLAG_HIGH_RESOLUTION; }
+    void setHighResolution(Handle h, bool high_resolution);
+
+    const std::string& getName(Handle h) const { return strings_[name_ids_[h.index()]]; }
+    const std::string& getShortName(Handle h) const { return strings_[short_name_ids_[h.index()]]; }
+    const std::string& getDescription(Handle h) const { return strings_[description_ids_[h.index()]]; }
+
+    Parameter* getOwner(Handle h) const { return owners_[h.index()]; }
+
+    // Queue an observer notification for the next flushNotifications()
+    void markDirty(Handle h);
+    // Notify the owners of all dirty slots; returns how many were notified
+    size_t flushNotifications();
+
+    // Copy every value out / back in. recall() marks each parameter whose
+    // value changes dirty; it bypasses the command history.
+    Snapshot snapshot() const;
+    void snapshot(Snapshot& out) const;   // Reuses out's storage
+    size_t recall(const Snapshot& snapshot);
+
+    size_t getInternedStringCount() const { return strings_.size(); }
+
+private:
+    ParameterStore();
+    ParameterStore(const ParameterStore&) = delete;
+    ParameterStore& operator=(const ParameterStore&) = delete;
+
+    static constexpr uint8_t FLAG_BIPOLAR = 0x01;
+    static constexpr uint8_t FLAG_HIGH_RESOLUTION = 0x02;   // 14-bit value
+    static constexpr uint16_t GENERATION_MASK = 0x0FFF;
+
+    uint32_t intern(std::string_view text);
+    Handle handleAt(uint32_t index) const {
+        return Handle{(static_cast<uint32_t>(generations_[index]) << Handle::INDEX_BITS) | index};
+    }
+
+    // One entry per slot
+    std::vector<uint16_t> values_;
+    std::vector<uint16_t> min_values_;
+    std::vector<uint16_t> max_values_;
+    std::vector<uint16_t> default_values_;
+    std::vector<uint8_t> cc_numbers_;
+    std::vector<uint8_t> midi_channels_;
+    std::vector<uint16_t> nrpn_numbers_;
+    std::vector<uint8_t> categories_;
+    std::vector<uint8_t> flags_;
+    std::vector<uint32_t> name_ids_;
+    std::vector<uint32_t> short_name_ids_;
+    std::vector<uint32_t> description_ids_;
+    std::vector<Parameter*> owners_;
+    std::vector<uint16_t> generations_;   // Never 0 for a live slot
+    std::vector<uint32_t> free_slots_;
+
+    std::vector<uint64_t> dirty_;         // One bit per slot
+    bool any_dirty_ = false;
+
+    // Interned strings; a deque so references and the map's views stay valid
+    std::deque<std::string> strings_;
+    std::unordered_map<std::string_view, uint32_t> string_ids_;
+};
@@ -0,0 +1,92 @@
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "ParameterStoreBenchmark.h"
+#include "Parameter.h"
+#include "components/midi/MidiTime.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    double perIterationUs(uint64_t start_ns, size_t iterations) {
+        return (MidiTime::nowNs() - start_ns) / 1000.0 / iterations;
+    }
+}
+
+void runParameterStoreBenchmark(size_t count, size_t iterations) {
+    ParameterStore& store = ParameterStore::getInstance();
+    size_t strings_before = store.getInternedStringCount();
+
+    uint64_t start = MidiTime::nowNs();
+    std::vector<std::shared_ptr<Parameter>> parameters;
+    parameters.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string name = "Param " + std::to_string(i);
+        parameters.push_back(std::make_shared<Parameter>(
+            name, "P" + std::to_string(i % 100), static_cast<uint8_t>(i % 128),
+            static_cast<ParameterCategory>(i % static_cast<size_t>(ParameterCategory::UNKNOWN)),
+            0, 127, static_cast<uint8_t>(i % 128), "Benchmark parameter"));
+    }
+    double create_us = perIterationUs(start, 1);
+
+    // Two states where every value differs
+    ParameterStore::Snapshot state_a = store.snapshot();
+    for (auto& param : parameters) {
+        param->setValueDirect(static_cast<uint16_t>((param->getCurrentValue() + 1) % 128));
+    }
+    store.flushNotifications();
+    ParameterStore::Snapshot state_b = store.snapshot();
+
+    // Snapshot
+    ParameterStore::Snapshot scratch;
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        store.snapshot(scratch);
+    }
+    double store_snapshot_us = perIterationUs(start, iterations);
+
+    std::vector<uint16_t> values(count);
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = parameters[i]->getCurrentValue();
+        }
+    }
+    double object_snapshot_us = perIterationUs(start, iterations);
+
+    // Recall, alternating so every value changes each time
+    size_t changed = 0;
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        changed += store.recall(it % 2 ? state_b : state_a);
+        store.flushNotifications();
+    }
+    double store_recall_us = perIterationUs(start, iterations);
+
+    std::vector<uint16_t> values_a(count);
+    std::vector<uint16_t> values_b(count);
+    for (size_t i = 0; i < count; ++i) {
+        values_a[i] = state_a.values[parameters[i]->getHandle().index()];
+        values_b[i] = state_b.values[parameters[i]->getHandle().index()];
+    }
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        const std::vector<uint16_t>& target = it % 2 ? values_b : values_a;
+        for (size_t i = 0; i < count; ++i) {
+            parameters[i]->setValueDirect(target[i]);
+        }
+        store.flushNotifications();
+    }
+    double object_recall_us = perIterationUs(start, iterations);
+
+    std::printf("=== ParameterStore Benchmark: %zu parameters, %zu iterations ===\n", count, iterations);
+    std::printf("  Create:    %.0f us total (%zu new interned strings)\n",
+                create_us, store.getInternedStringCount() - strings_before);
+    std::printf("  Snapshot:  store %8.1f us   per-object %8.1f us\n", store_snapshot_us, object_snapshot_us);
+    std::printf("  Recall:    store %8.1f us   per-object %8.1f us   (%zu values changed per recall)\n",
+                store_recall_us, object_recall_us, iterations ? changed / iterations : 0);
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,20 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <cstddef>
+
+/**
+ * @brief Times ParameterStore snapshot / recall against walking the
+ * Parameter objects one by one
+ *
+ * Creates `count` parameters (distinct names, shared description), then
+ * reports per-operation times for:
+ * - snapshot: store copy vs getCurrentValue() on each shared_ptr
+ * - recall:   store recall vs setValueDirect() on each parameter
+ *             (every value changes, then one flushNotifications())
+ * and the interned string count. Run with --bench-params.
+ */
+void runParameterStoreBenchmark(size_t count, size_t iterations = 200);
+
+#endif // !ESP32_BUILD
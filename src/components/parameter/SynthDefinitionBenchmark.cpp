@@ -0,0 +1,142 @@
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "SynthDefinitionBenchmark.h"
+#include "ParameterBinder.h"
+#include "SynthDefinitionBlob.h"
+#include "SynthDefinitionReader.h"
+#include "components/midi/MidiTime.h"
+#include "components/profiling/HeapUsage.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr size_t CATEGORY_COUNT = static_cast<size_t>(ParameterCategory::UNKNOWN);
+
+    double perIterationUs(uint64_t start_ns, size_t iterations) {
+        return (MidiTime::nowNs() - start_ns) / 1000.0 / iterations;
+    }
+
+    // Same layout as src/config/hydrasynth.json
+    std::string makeJson(size_t count) {
+        std::string json = "{\n  \"name\": \"Benchmark Synth\",\n  \"manufacturer\": \"Benchmark\",\n"
+                           "  \"description\": \"Generated definition\",\n  \"categories\": {";
+        for (size_t c = 0; c < CATEGORY_COUNT; ++c) {
+            json += c ? ",\n" : "\n";
+            json += "    \"" + ParameterUtils::categoryToString(static_cast<ParameterCategory>(c)) +
+                    "\": {\n      \"description\": \"Generated category\",\n      \"parameters\": {";
+            bool first = true;
+            for (size_t i = c; i < count; i += CATEGORY_COUNT) {
+                std::string index = std::to_string(i);
+                json += first ? "\n" : ",\n";
+                json += "        \"Json_Param_" + index + "\": {\"cc\": " + std::to_string(i % 128) +
+                        ", \"name\": \"Json Param " + index + "\", \"short_name\": \"J" +
+                        std::to_string(i % 100) + "\", \"description\": \"Benchmark parameter\", "
+                        "\"min\": 0, \"max\": 127, \"default\": " + std::to_string(i % 128) + "}";
+                first = false;
+            }
+            json += "\n      }\n    }";
+        }
+        json += "\n  }\n}\n";
+        return json;
+    }
+
+    std::vector<uint8_t> makeBlob(size_t count) {
+        SynthDefinitionBlob::Builder builder;
+        builder.addSynth("benchmark", "Benchmark Synth", "Benchmark", "Generated definition");
+        for (size_t c = 0; c < CATEGORY_COUNT; ++c) {
+            for (size_t i = c; i < count; i += CATEGORY_COUNT) {
+                std::string name = "Blob Param " + std::to_string(i);
+                std::string short_name = "B" + std::to_string(i % 100);
+                ParameterStore::Definition definition;
+                definition.name = name;
+                definition.short_name = short_name;
+                definition.description = "Benchmark parameter";
+                definition.cc_number = static_cast<uint8_t>(i % 128);
+                definition.category = static_cast<uint8_t>(c);
+                definition.default_value = static_cast<uint16_t>(i % 128);
+                builder.addParameter(definition);
+            }
+        }
+        return builder.build();
+    }
+
+    struct LoadResult {
+        double time_us;
+        long long heap_bytes;
+        size_t parameters;
+    };
+
+    template <typename Load>
+    LoadResult measureLoad(Load load) {
+        ParameterBinder binder;
+        size_t heap_before = heapUsedBytes();
+        uint64_t start = MidiTime::nowNs();
+        bool ok = load(binder);
+        LoadResult result;
+        result.time_us = perIterationUs(start, 1);
+        result.heap_bytes = (long long)heapUsedBytes() - (long long)heap_before;
+        result.parameters = ok ? binder.getParameterCount() : 0;
+        return result;   // Parameters released here, freeing their store slots
+    }
+}
+
+void runSynthDefinitionBenchmark(size_t count, size_t iterations) {
+    std::string json = makeJson(count);
+    std::vector<uint8_t> blob_data = makeBlob(count);
+
+    // Grow the store once up front; both loads then reuse the freed slots
+    {
+        std::vector<std::shared_ptr<Parameter>> warmup;
+        warmup.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            warmup.push_back(std::make_shared<Parameter>("Warmup", "Warmup", 0, ParameterCategory::SYSTEM));
+        }
+    }
+
+    // Decode only
+    uint32_t checksum = 0;
+    uint64_t start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        SynthDefinitionReader reader([&checksum](const ParameterStore::Definition& definition) {
+            checksum += definition.cc_number + definition.default_value + definition.name.size();
+        });
+        reader.parse(json);
+    }
+    double json_decode_us = perIterationUs(start, iterations);
+
+    start = MidiTime::nowNs();
+    for (size_t it = 0; it < iterations; ++it) {
+        SynthDefinitionBlob blob;
+        SynthDefinitionBlob::Synth synth;
+        if (!blob.open(blob_data.data(), blob_data.size()) || !blob.findSynth("benchmark", synth)) break;
+        for (uint32_t i = 0; i < synth.parameter_count; ++i) {
+            ParameterStore::Definition definition = blob.getParameter(synth.first_parameter + i);
+            checksum += definition.cc_number + definition.default_value + definition.name.size();
+        }
+    }
+    double blob_decode_us = perIterationUs(start, iterations);
+
+    // Full load, once each: a second run would find its strings already interned
+    LoadResult json_load = measureLoad([&json](ParameterBinder& binder) {
+        return binder.loadSynthDefinitionFromJson(json);
+    });
+    LoadResult blob_load = measureLoad([&blob_data](ParameterBinder& binder) {
+        SynthDefinitionBlob blob;
+        return blob.open(blob_data.data(), blob_data.size()) &&
+               binder.loadSynthDefinitionFromBlob(blob, "benchmark");
+    });
+
+    std::printf("=== Synth Definition Benchmark: %zu parameters ===\n", count);
+    std::printf("  Input:   JSON %8zu bytes   blob %8zu bytes\n", json.size(), blob_data.size());
+    std::printf("  Decode:  JSON %8.1f us      blob %8.1f us   (%zu iterations, checksum %u)\n",
+                json_decode_us, blob_decode_us, iterations, checksum);
+    std::printf("  Load:    JSON %8.1f us      blob %8.1f us   (%zu / %zu parameters)\n",
+                json_load.time_us, blob_load.time_us, json_load.parameters, blob_load.parameters);
+    std::printf("  Heap:    JSON %+8lld bytes   blob %+8lld bytes   (held after load)\n",
+                json_load.heap_bytes, blob_load.heap_bytes);
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,23 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <cstddef>
+
+/**
+ * @brief Compares loading a synth definition from JSON and from the
+ * precompiled blob
+ *
+ * Generates a definition with `count` parameters in both formats (distinct
+ * names per format, so neither reuses the other's interned strings) and
+ * reports, for each:
+ * - decode: reading every parameter definition, nothing created
+ * - load:   ParameterBinder::loadSynthDefinitionFrom{Json,Blob}(), i.e.
+ *           decode plus creating the parameters and lookup maps
+ * - the heap still held after the load, and the input size
+ * The store is warmed up with `count` parameters first so neither path pays
+ * for growing it. Run with --bench-synthdef.
+ */
+void runSynthDefinitionBenchmark(size_t count, size_t iterations = 20);
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,235 @@
+#include "SynthDefinitionBlob.h"
+#include "components/log/Log.h"
+#include <cstring>
+
+#if defined(ESP32_BUILD) && defined(SYNTH_DEFINITIONS_EMBEDDED)
+// board_build.embed_files = data/synthdefs.bin
+extern const uint8_t synthdefs_start[] asm("_binary_data_synthdefs_bin_start");
+extern const uint8_t synthdefs_end[] asm("_binary_data_synthdefs_bin_end");
+#endif
+
+namespace {
+    // Byte-wise reads: no alignment or endianness assumptions about the blob
+    uint16_t readU16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t readU32(const uint8_t* p) {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    void appendU8(std::vector<uint8_t>& out, uint8_t value) {
+        out.push_back(value);
+    }
+
+    void appendU16(std::vector<uint8_t>& out, uint16_t value) {
+        out.push_back(static_cast<uint8_t>(value));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            out.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+}
+
+bool SynthDefinitionBlob::open(const uint8_t* data, size_t size) {
+    data_ = nullptr;
+    size_ = 0;
+
+    if (!data || size < HEADER_SIZE + 1) {
+        LOG_ERROR("SynthDefinitionBlob", "Blob too small (%zu bytes)", size);
+        return false;
+    }
+    if (readU32(data) != MAGIC || readU16(data + 4) != VERSION) {
+        LOG_ERROR("SynthDefinitionBlob", "Not a version %u synth definition blob", VERSION);
+        return false;
+    }
+
+    uint16_t synth_count = readU16(data + 6);
+    uint32_t parameter_count = readU32(data + 8);
+    uint32_t strings_offset = readU32(data + 12);
+
+    // Tables must fit before the strings, which must end in a NUL so every
+    // string read from them is terminated
+    uint64_t tables_end = HEADER_SIZE + uint64_t(synth_count) * SYNTH_RECORD_SIZE +
+                          uint64_t(parameter_count) * PARAMETER_RECORD_SIZE;
+    if (tables_end > strings_offset || strings_offset >= size || data[size - 1] != '\0') {
+        LOG_ERROR("SynthDefinitionBlob", "Corrupt blob: tables end at %llu, strings at %u, size %zu",
+                  (unsigned long long)tables_end, strings_offset, size);
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    synth_count_ = synth_count;
+    parameter_count_ = parameter_count;
+    strings_offset_ = strings_offset;
+    return true;
+}
+
+std::string_view SynthDefinitionBlob::stringAt(uint32_t offset) const {
+    if (offset >= size_ - strings_offset_) return {};
+    return std::string_view(reinterpret_cast<const char*>(data_ + strings_offset_ + offset));
+}
+
+SynthDefinitionBlob::Synth SynthDefinitionBlob::getSynth(size_t index) const {
+    Synth synth;
+    if (index >= synth_count_) return synth;
+
+    const uint8_t* record = data_ + HEADER_SIZE + index * SYNTH_RECORD_SIZE;
+    synth.key = stringAt(readU32(record));
+    synth.name = stringAt(readU32(record + 4));
+    synth.manufacturer = stringAt(readU32(record + 8));
+    synth.description = stringAt(readU32(record + 12));
+    synth.first_parameter = readU32(record + 16);
+    synth.parameter_count = readU32(record + 20);
+    synth.midi_channel = record[24];
+
+    // Never hand out a range past the parameter table
+    if (synth.first_parameter > parameter_count_) {
+        synth.first_parameter = parameter_count_;
+    }
+    if (synth.parameter_count > parameter_count_ - synth.first_parameter) {
+        synth.parameter_count = parameter_count_ - synth.first_parameter;
+    }
+    return synth;
+}
+
+bool SynthDefinitionBlob::findSynth(std::string_view key, Synth& out) const {
+    for (size_t i = 0; i < synth_count_; ++i) {
+        Synth synth = getSynth(i);
+        if (synth.key == key) {
+            out = synth;
+            return true;
+        }
+    }
+    return false;
+}
+
+ParameterStore::Definition SynthDefinitionBlob::getParameter(uint32_t index) const {
+    ParameterStore::Definition definition;
+    if (index >= parameter_count_) return definition;
+
+    const uint8_t* record = data_ + HEADER_SIZE + synth_count_ * SYNTH_RECORD_SIZE +
+                            index * PARAMETER_RECORD_SIZE;
+    definition.name = stringAt(readU32(record));
+    definition.short_name = stringAt(readU32(record + 4));
+    definition.description = stringAt(readU32(record + 8));
+    definition.min_value = readU16(record + 12);
+    definition.max_value = readU16(record + 14);
+    definition.default_value = readU16(record + 16);
+    definition.nrpn_number = readU16(record + 18);
+    definition.cc_number = record[20];
+    definition.category = record[21];
+    definition.midi_channel = record[22];
+    definition.bipolar = record[23] & FLAG_BIPOLAR;
+    definition.high_resolution = record[23] & FLAG_HIGH_RESOLUTION;
+    return definition;
+}
+
+bool SynthDefinitionBlob::openEmbedded(SynthDefinitionBlob& blob) {
+#if defined(ESP32_BUILD) && defined(SYNTH_DEFINITIONS_EMBEDDED)
+    return blob.open(synthdefs_start, static_cast<size_t>(synthdefs_end - synthdefs_start));
+#else
+    (void)blob;
+    return false;
+#endif
+}
+
+// ============================================================================
+// Builder
+// ============================================================================
+
+SynthDefinitionBlob::Builder::Builder() {
+    addString("");   // Reference 0
+}
+
+uint32_t SynthDefinitionBlob::Builder::addString(std::string_view text) {
+    auto it = string_ids_.find(std::string(text));
+    if (it != string_ids_.end()) return it->second;
+
+    uint32_t offset = static_cast<uint32_t>(strings_.size());
+    strings_.append(text.data(), text.size());
+    strings_.push_back('\0');
+    string_ids_.emplace(std::string(text), offset);
+    return offset;
+}
+
+void SynthDefinitionBlob::Builder::addSynth(std::string_view key, std::string_view name,
+                                            std::string_view manufacturer, std::string_view description,
+                                            uint8_t midi_channel) {
+    SynthEntry entry;
+    entry.key = addString(key);
+    entry.name = addString(name);
+    entry.manufacturer = addString(manufacturer);
+    entry.description = addString(description);
+    entry.first_parameter = static_cast<uint32_t>(parameters_.size());
+    entry.parameter_count = 0;
+    entry.midi_channel = midi_channel;
+    synths_.push_back(entry);
+}
+
+void SynthDefinitionBlob::Builder::addParameter(const ParameterStore::Definition& definition) {
+    if (synths_.empty()) return;
+
+    ParameterEntry entry;
+    entry.name = addString(definition.name);
+    entry.short_name = addString(definition.short_name);
+    entry.description = addString(definition.description);
+    entry.min_value = definition.min_value;
+    entry.max_value = definition.max_value;
+    entry.default_value = definition.default_value;
+    entry.nrpn_number = definition.nrpn_number;
+    entry.cc_number = definition.cc_number;
+    entry.category = definition.category;
+    entry.midi_channel = definition.midi_channel;
+    entry.flags = (definition.bipolar ? FLAG_BIPOLAR : 0) |
+                  (definition.high_resolution ? FLAG_HIGH_RESOLUTION : 0);
+    parameters_.push_back(entry);
+    synths_.back().parameter_count++;
+}
+
+std::vector<uint8_t> SynthDefinitionBlob::Builder::build() const {
+    std::vector<uint8_t> out;
+    size_t strings_offset = HEADER_SIZE + synths_.size() * SYNTH_RECORD_SIZE +
+                            parameters_.size() * PARAMETER_RECORD_SIZE;
+    out.reserve(strings_offset + strings_.size());
+
+    appendU32(out, MAGIC);
+    appendU16(out, VERSION);
+    appendU16(out, static_cast<uint16_t>(synths_.size()));
+    appendU32(out, static_cast<uint32_t>(parameters_.size()));
+    appendU32(out, static_cast<uint32_t>(strings_offset));
+
+    for (const SynthEntry& synth : synths_) {
+        appendU32(out, synth.key);
+        appendU32(out, synth.name);
+        appendU32(out, synth.manufacturer);
+        appendU32(out, synth.description);
+        appendU32(out, synth.first_parameter);
+        appendU32(out, synth.parameter_count);
+        appendU8(out, synth.midi_channel);
+        appendU8(out, 0);
+        appendU16(out, 0);
+    }
+
+    for (const ParameterEntry& param : parameters_) {
+        appendU32(out, param.name);
+        appendU32(out, param.short_name);
+        appendU32(out, param.description);
+        appendU16(out, param.min_value);
+        appendU16(out, param.max_value);
+        appendU16(out, param.default_value);
+        appendU16(out, param.nrpn_number);
+        appendU8(out, param.cc_number);
+        appendU8(out, param.category);
+        appendU8(out, param.midi_channel);
+        appendU8(out, param.flags);
+    }
+
+    out.insert(out.end(), strings_.begin(), strings_.end());
+    return out;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ParameterStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Precompiled synth definitions, read in place
+ *
+ * scripts/build_synth_definitions.py compiles the JSON definitions in
+ * src/config into one blob, data/synthdefs.bin, which the ESP32 build
+ * embeds in flash. Flash is memory-mapped, so open() only checks the header
+ * and table bounds; records and strings are read where they lie, with no
+ * parsing and no copy of the blob at boot.
+ *
+ * Layout (little-endian; table offsets are from the start of the blob and
+ * string references from the start of the string section, so it works
+ * wherever it is mapped):
+ *
+ *   Header           16 bytes
+ *   SynthRecord      28 bytes x synth_count
+ *   ParameterRecord  24 bytes x parameter_count (all synths, in order)
+ *   Strings          NUL-terminated, each distinct string once; starts
+ *                    with "" (reference 0) and ends with a NUL
+ *
+ * The Python script and Builder below write the same format; change both
+ * (and VERSION) together.
+ */
+class SynthDefinitionBlob {
+public:
+    static constexpr uint32_t MAGIC = 0x444E5953;   // "SYND"
+    static constexpr uint16_t VERSION = 1;
+
+    static constexpr uint8_t FLAG_BIPOLAR = 0x01;
+    static constexpr uint8_t FLAG_HIGH_RESOLUTION = 0x02;
+
+    struct Synth {
+        std::string_view key;            // Name passed to loadSynthDefinition()
+        std::string_view name;
+        std::string_view manufacturer;
+        std::string_view description;
+        uint8_t midi_channel = 0;        // 0 = app default
+        uint32_t first_parameter = 0;
+        uint32_t parameter_count = 0;
+    };
+
+    // The blob must outlive this object and every view taken from it
+    bool open(const uint8_t* data, size_t size);
+    bool isOpen() const { return data_ != nullptr; }
+    size_t getSize() const { return size_; }
+
+    size_t getSynthCount() const { return synth_count_; }
+    Synth getSynth(size_t index) const;
+    bool findSynth(std::string_view key, Synth& out) const;
+
+    // Views point into the blob; the definition can go straight to Parameter
+    ParameterStore::Definition getParameter(uint32_t index) const;
+
+    // The blob linked into the firmware, if this build embeds one
+    static bool openEmbedded(SynthDefinitionBlob& blob);
+
+    /**
+     * @brief Writes the format (desktop tools and benchmarks; the firmware
+     * blob comes from the Python script)
+     */
+    class Builder {
+    public:
+        Builder();
+        void addSynth(std::string_view key, std::string_view name, std::string_view manufacturer,
+                      std::string_view description, uint8_t midi_channel = 0);
+        // Belongs to the last synth added
+        void addParameter(const ParameterStore::Definition& definition);
+        std::vector<uint8_t> build() const;
+
+    private:
+        uint32_t addString(std::string_view text);
+
+        struct SynthEntry {
+            uint32_t key, name, manufacturer, description;
+            uint32_t first_parameter, parameter_count;
+            uint8_t midi_channel;
+        };
+        struct ParameterEntry {
+            uint32_t name, short_name, description;
+            uint16_t min_value, max_value, default_value, nrpn_number;
+            uint8_t cc_number, category, midi_channel, flags;
+        };
+
+        std::vector<SynthEntry> synths_;
+        std::vector<ParameterEntry> parameters_;
+        std::string strings_;
+        std::unordered_map<std::string, uint32_t> string_ids_;
+    };
+
+private:
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t SYNTH_RECORD_SIZE = 28;
+    static constexpr size_t PARAMETER_RECORD_SIZE = 24;
+
+    std::string_view stringAt(uint32_t offset) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    uint16_t synth_count_ = 0;
+    uint32_t parameter_count_ = 0;
+    uint32_t strings_offset_ = 0;
+};
@@ -0,0 +1,192 @@
+#include "SynthDefinitionReader.h"
+#include "Parameter.h"
+#include "components/log/Log.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    uint16_t toValue(double value, uint16_t max) {
+        if (!(value > 0)) return 0;   // Also NaN
+        return value >= max ? max : static_cast<uint16_t>(value);
+    }
+}
+
+SynthDefinitionReader::SynthDefinitionReader(ParameterCallback on_parameter)
+    : on_parameter_(std::move(on_parameter)),
+      parser_(*this) {
+}
+
+bool SynthDefinitionReader::finish() {
+    if (!parser_.finish()) return false;
+    if (!saw_root_) {
+        error_ = "Not a synth definition (expected an object)";
+        return false;
+    }
+    return true;
+}
+
+void SynthDefinitionReader::onObjectStart() {
+    if (skip_depth_ > 0) {
+        skip_depth_++;
+        return;
+    }
+
+    Context parent = depth_ > 0 ? contexts_[depth_ - 1] : Context::ROOT;
+    Context context;
+    if (depth_ == 0) {
+        context = Context::ROOT;
+        saw_root_ = true;
+    } else if (parent == Context::ROOT && key_ == "categories") {
+        context = Context::CATEGORIES;
+    } else if (parent == Context::CATEGORIES) {
+        context = Context::CATEGORY;
+        category_ = static_cast<uint8_t>(ParameterUtils::stringToCategory(key_));
+    } else if (parent == Context::CATEGORY && key_ == "parameters") {
+        context = Context::PARAMETERS;
+    } else if (parent == Context::PARAMETERS) {
+        context = Context::PARAMETER;
+        beginParameter();
+    } else {
+        skip_depth_ = 1;
+        return;
+    }
+    contexts_[depth_++] = context;
+}
+
+void SynthDefinitionReader::onObjectEnd() {
+    if (skip_depth_ > 0) {
+        skip_depth_--;
+        return;
+    }
+    if (depth_ == 0) return;
+
+    if (contexts_[--depth_] == Context::PARAMETER) {
+        endParameter();
+    }
+}
+
+void SynthDefinitionReader::onArrayStart() {
+    skip_depth_++;   // No arrays in the format
+}
+
+void SynthDefinitionReader::onArrayEnd() {
+    if (skip_depth_ > 0) {
+        skip_depth_--;
+    }
+}
+
+void SynthDefinitionReader::onKey(std::string_view key) {
+    if (skip_depth_ > 0) return;
+    key_.assign(key.data(), key.size());
+}
+
+void SynthDefinitionReader::onString(std::string_view value) {
+    if (skip_depth_ > 0 || depth_ == 0) return;
+
+    switch (contexts_[depth_ - 1]) {
+        case Context::ROOT:
+            if (key_ == "name") {
+                header_.name.assign(value.data(), value.size());
+            } else if (key_ == "manufacturer") {
+                header_.manufacturer.assign(value.data(), value.size());
+            } else if (key_ == "description") {
+                header_.description.assign(value.data(), value.size());
+            }
+            break;
+        case Context::PARAMETER:
+            if (key_ == "name") {
+                name_.assign(value.data(), value.size());
+                has_name_ = true;
+            } else if (key_ == "short_name") {
+                short_name_.assign(value.data(), value.size());
+                has_short_name_ = true;
+            } else if (key_ == "description") {
+                description_.assign(value.data(), value.size());
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void SynthDefinitionReader::onNumber(double value) {
+    if (skip_depth_ > 0 || depth_ == 0) return;
+
+    switch (contexts_[depth_ - 1]) {
+        case Context::ROOT:
+            if (key_ == "midi_channel") {
+                header_.midi_channel = static_cast<uint8_t>(toValue(value, 16));
+            }
+            break;
+        case Context::PARAMETER:
+            if (key_ == "cc") {
+                definition_.cc_number = static_cast<uint8_t>(toValue(value, 127));
+            } else if (key_ == "min") {
+                definition_.min_value = toValue(value, Parameter::MAX_VALUE_14BIT);
+            } else if (key_ == "max") {
+                definition_.max_value = toValue(value, Parameter::MAX_VALUE_14BIT);
+            } else if (key_ == "default") {
+                definition_.default_value = toValue(value, Parameter::MAX_VALUE_14BIT);
+            } else if (key_ == "nrpn") {
+                definition_.nrpn_number = toValue(value, Parameter::MAX_VALUE_14BIT);
+            } else if (key_ == "channel") {
+                definition_.midi_channel = static_cast<uint8_t>(toValue(value, 16));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void SynthDefinitionReader::onBool(bool value) {
+    if (skip_depth_ > 0 || depth_ == 0 || contexts_[depth_ - 1] != Context::PARAMETER) return;
+
+    if (key_ == "bipolar") {
+        definition_.bipolar = value;
+    } else if (key_ == "high_resolution") {
+        definition_.high_resolution = value;
+    }
+}
+
+void SynthDefinitionReader::beginParameter() {
+    param_key_ = key_;
+    name_.clear();
+    short_name_.clear();
+    description_.clear();
+    has_name_ = false;
+    has_short_name_ = false;
+
+    definition_ = ParameterStore::Definition();
+    definition_.cc_number = NO_CC;
+    definition_.category = category_;
+}
+
+void SynthDefinitionReader::endParameter() {
+    if (!has_name_) {
+        name_ = param_key_;
+        std::replace(name_.begin(), name_.end(), '_', ' ');
+    }
+    if (!has_short_name_) {
+        short_name_ = name_;
+    }
+    if (definition_.min_value > definition_.max_value) {
+        std::swap(definition_.min_value, definition_.max_value);
+    }
+    definition_.default_value = std::min(std::max(definition_.default_value, definition_.min_value),
+                                         definition_.max_value);
+
+    if (definition_.cc_number == NO_CC && definition_.nrpn_number == Parameter::NO_NRPN) {
+        // Could never be sent or received
+        LOG_WARN("SynthDefinition", "Skipping '%s': no \"cc\" or \"nrpn\"", param_key_.c_str());
+        skipped_count_++;
+        return;
+    }
+
+    definition_.name = name_;
+    definition_.short_name = short_name_;
+    definition_.description = description_;
+    parameter_count_++;
+    if (on_parameter_) {
+        on_parameter_(definition_);
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ParameterStore.h"
+#include "components/json/JsonSaxParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Reads a synth definition JSON file (src/config/<synth>.json) as a stream
+ *
+ *   {
+ *     "name": "...", "manufacturer": "...", "description": "...",
+ *     "midi_channel": 1,                         // optional, 1-16
+ *     "categories": {
+ *       "Filters": {
+ *         "description": "...",
+ *         "parameters": {
+ *           "Filter_1_Cutoff": {
+ *             "cc": 74, "name": "Filter 1 Cutoff", "description": "...",
+ *             "min": 0, "max": 127, "default": 64,
+ *             // optional:
+ *             "short_name": "F1 Cutoff", "nrpn": 1234, "channel": 2,
+ *             "bipolar": true, "high_resolution": true
+ *           }
+ *         }
+ *       }
+ *     }
+ *   }
+ *
+ * Each parameter is handed to the callback as soon as its object closes;
+ * nothing else is kept, so memory use does not grow with the file. The
+ * definition's views are only valid during the call. A missing "name"
+ * becomes the key with '_' as spaces and a missing "short_name" the name.
+ * "cc" may be left out of NRPN parameters (it becomes NO_CC, which is never
+ * sent or dispatched); a parameter with neither is skipped with a warning.
+ * Unknown keys are skipped.
+ *
+ * Header fields may come after "categories", so read getHeader() once
+ * finish() has returned.
+ */
+class SynthDefinitionReader : private JsonSaxHandler {
+public:
+    struct Header {
+        std::string name;
+        std::string manufacturer;
+        std::string description;
+        uint8_t midi_channel = 0;   // 0 = not given
+    };
+
+    static constexpr uint8_t NO_CC = 0xFF;
+
+    using ParameterCallback = std::function<void(const ParameterStore::Definition&)>;
+
+    explicit SynthDefinitionReader(ParameterCallback on_parameter);
+
+    bool feed(const char* data, size_t size) { return parser_.feed(data, size); }
+    bool finish();
+    bool parse(std::string_view text) { return feed(text.data(), text.size()) && finish(); }
+
+    const Header& getHeader() const { return header_; }
+    size_t getParameterCount() const { return parameter_count_; }
+    size_t getSkippedCount() const { return skipped_count_; }   // No cc or nrpn
+    const char* getError() const { return error_ ? error_ : parser_.getError(); }
+    size_t getLine() const { return parser_.getLine(); }
+
+private:
+    // What the innermost open object is
+    enum class Context : uint8_t { ROOT, CATEGORIES, CATEGORY, PARAMETERS, PARAMETER };
+    static constexpr size_t MAX_CONTEXTS = 5;
+
+    void onObjectStart() override;
+    void onObjectEnd() override;
+    void onArrayStart() override;
+    void onArrayEnd() override;
+    void onKey(std::string_view key) override;
+    void onString(std::string_view value) override;
+    void onNumber(double value) override;
+    void onBool(bool value) override;
+
+    void beginParameter();
+    void endParameter();
+
+    ParameterCallback on_parameter_;
+    JsonSaxParser parser_;
+    Header header_;
+    size_t parameter_count_ = 0;
+    size_t skipped_count_ = 0;
+    const char* error_ = nullptr;
+
+    Context contexts_[MAX_CONTEXTS];
+    size_t depth_ = 0;
+    size_t skip_depth_ = 0;         // > 0 inside a value being ignored
+    bool saw_root_ = false;
+    std::string key_;
+
+    // Parameter being read; strings keep their capacity between parameters
+    uint8_t category_ = 0;
+    std::string param_key_;
+    std::string name_;
+    std::string short_name_;
+    std::string description_;
+    bool has_name_ = false;
+    bool has_short_name_ = false;
+    ParameterStore::Definition definition_;
+};
@@ -0,0 +1,32 @@
+#if !defined(ESP32_BUILD) && defined(MIDI_BENCH_ALLOC_COUNTER)  // Desktop bench builds only
+
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocations{0};
+}
+
+uint64_t allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// Replaces the global allocation functions; the array and nothrow forms
+// call this one
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+#endif // !ESP32_BUILD && MIDI_BENCH_ALLOC_COUNTER
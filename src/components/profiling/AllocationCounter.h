@@ -0,0 +1,24 @@
+#pragma once
+
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include <cstdint>
+
+/**
+ * @brief Number of global operator new calls so far, all threads
+ *
+ * For before/after deltas around one operation, like heapUsedBytes(), but
+ * also sees allocations freed again before the operation returns. Counting
+ * replaces the global allocator and costs every allocation a relaxed
+ * atomic add, so it is only compiled in with -D MIDI_BENCH_ALLOC_COUNTER
+ * (pio run -e desktop_bench); other builds always return 0.
+ */
+#if defined(MIDI_BENCH_ALLOC_COUNTER)
+constexpr bool ALLOCATION_COUNTING = true;
+uint64_t allocationCount();
+#else
+constexpr bool ALLOCATION_COUNTING = false;
+inline uint64_t allocationCount() { return 0; }
+#endif
+
+#endif // !ESP32_BUILD
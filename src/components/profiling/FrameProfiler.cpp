@@ -0,0 +1,298 @@
+#include "FrameProfiler.h"
+#include "components/midi/MidiTime.h"
+#include "components/settings/SettingsManager.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr uint32_t OVERLAY_PERIOD_MS = 500;
+    // Object trees only change on user action; recounting every frame would
+    // cost more than some of the frames being measured
+    constexpr uint32_t RECOUNT_INTERVAL_FRAMES = 32;
+}
+
+FrameProfiler& FrameProfiler::getInstance() {
+    static FrameProfiler instance;
+    return instance;
+}
+
+FrameProfiler::FrameProfiler() {
+    tab_count_ = 1;
+    tabs_[0].name = "-";   // Frames before the first tab is shown
+}
+
+void FrameProfiler::attach(lv_display_t* display) {
+    if (!display || display_) return;
+
+    display_ = display;
+    const lv_event_code_t codes[] = {
+        LV_EVENT_REFR_START, LV_EVENT_REFR_READY,
+        LV_EVENT_FLUSH_START, LV_EVENT_FLUSH_FINISH,
+        LV_EVENT_FLUSH_WAIT_START, LV_EVENT_FLUSH_WAIT_FINISH,
+    };
+    for (lv_event_code_t code : codes) {
+        lv_display_add_event_cb(display_, eventCallback, code, this);
+    }
+
+    // The observer only sees changes, so also apply the current value if the
+    // setting is already registered (registering it later with a non-default
+    // value notifies the observer)
+    SettingsManager& settings = SettingsManager::getInstance();
+    settings.addObserver("FrameProfiler",
+        [this](const std::string& key, const std::any& /* old_value */, const std::any& new_value) {
+            if (key == "system.frame_profiler" && new_value.type() == typeid(bool)) {
+                bool on = std::any_cast<bool>(new_value);
+                setEnabled(on);
+                setOverlayVisible(on);
+            }
+        });
+    if (const auto* setting = settings.getSettingDefinition("system.frame_profiler")) {
+        if (setting->current_value.type() == typeid(bool) && std::any_cast<bool>(setting->current_value)) {
+            setEnabled(true);
+            setOverlayVisible(true);
+        }
+    }
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+    if (enabled == enabled_) return;
+
+    enabled_ = enabled;
+    frame_start_us_ = 0;
+    if (!enabled_) {
+        logSummary();
+    }
+    LOG_INFO("FrameProfiler", "%s", enabled_ ? "Enabled" : "Disabled");
+}
+
+void FrameProfiler::setOverlayVisible(bool visible) {
+    if (visible && !overlay_) {
+        overlay_ = lv_label_create(lv_layer_top());
+        lv_obj_set_style_text_font(overlay_, &lv_font_montserrat_12, 0);
+        lv_obj_set_style_text_color(overlay_, lv_color_hex(0xFFFFFF), 0);
+        lv_obj_set_style_bg_color(overlay_, lv_color_hex(0x000000), 0);
+        lv_obj_set_style_bg_opa(overlay_, LV_OPA_70, 0);
+        lv_obj_set_style_pad_all(overlay_, 2, 0);
+        lv_obj_align(overlay_, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        lv_label_set_text(overlay_, "profiling...");
+
+        overlay_from_ = total_frames_;
+        overlay_time_ms_ = lv_tick_get();
+        overlay_timer_ = lv_timer_create(overlayTimerCallback, OVERLAY_PERIOD_MS, this);
+    } else if (!visible && overlay_) {
+        lv_timer_delete(overlay_timer_);
+        lv_obj_delete(overlay_);
+        overlay_timer_ = nullptr;
+        overlay_ = nullptr;
+    }
+}
+
+void FrameProfiler::setActiveTab(const std::string& name, lv_obj_t* container) {
+    if (enabled_ && tabs_[tab_].frames) {
+        const TabTotals& left = tabs_[tab_];
+        LOG_INFO("FrameProfiler", "%s: %u frames, mean %.0f us, max %u us, %u objects",
+                 left.name.c_str(), left.frames, static_cast<double>(left.frame_us) / left.frames,
+                 left.max_frame_us, left.object_count);
+    }
+
+    tab_ = tabIndex(name);
+    tab_container_ = container;
+    object_count_ = countObjects(container);
+    frames_since_count_ = 0;
+}
+
+uint8_t FrameProfiler::tabIndex(const std::string& name) {
+    for (size_t i = 0; i < tab_count_; ++i) {
+        if (tabs_[i].name == name) return static_cast<uint8_t>(i);
+    }
+    if (tab_count_ == MAX_TABS) return 0;   // Out of slots: lump into "-"
+
+    tabs_[tab_count_].name = name;
+    return static_cast<uint8_t>(tab_count_++);
+}
+
+uint16_t FrameProfiler::countObjects(lv_obj_t* obj) {
+    if (!obj) return 0;
+
+    uint32_t count = 1;
+    uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; ++i) {
+        count += countObjects(lv_obj_get_child(obj, static_cast<int32_t>(i)));
+    }
+    return static_cast<uint16_t>(std::min<uint32_t>(count, UINT16_MAX));
+}
+
+void FrameProfiler::eventCallback(lv_event_t* e) {
+    auto* self = static_cast<FrameProfiler*>(lv_event_get_user_data(e));
+    if (self->enabled_) {
+        self->onEvent(lv_event_get_code(e), lv_event_get_param(e));
+    }
+}
+
+void FrameProfiler::onEvent(lv_event_code_t code, void* param) {
+    uint64_t now = MidiTime::nowUs();
+
+    switch (code) {
+        case LV_EVENT_REFR_START:
+            frame_start_us_ = now;
+            flush_us_ = 0;
+            dirty_px_ = 0;
+            flush_count_ = 0;
+            break;
+        case LV_EVENT_FLUSH_START: {
+            flush_start_us_ = now;
+            flush_count_++;
+            const auto* area = static_cast<const lv_area_t*>(param);
+            if (area) {
+                dirty_px_ += static_cast<uint32_t>(lv_area_get_width(area) * lv_area_get_height(area));
+            }
+            break;
+        }
+        case LV_EVENT_FLUSH_FINISH:
+            if (flush_start_us_) flush_us_ += static_cast<uint32_t>(now - flush_start_us_);
+            flush_start_us_ = 0;
+            break;
+        case LV_EVENT_FLUSH_WAIT_START:
+            wait_start_us_ = now;
+            break;
+        case LV_EVENT_FLUSH_WAIT_FINISH:
+            if (wait_start_us_) flush_us_ += static_cast<uint32_t>(now - wait_start_us_);
+            wait_start_us_ = 0;
+            break;
+        case LV_EVENT_REFR_READY:
+            if (frame_start_us_ && flush_count_) {
+                endFrame();
+            }
+            frame_start_us_ = 0;
+            break;
+        default:
+            break;
+    }
+}
+
+void FrameProfiler::endFrame() {
+    uint32_t frame_us = static_cast<uint32_t>(MidiTime::nowUs() - frame_start_us_);
+
+    if (++frames_since_count_ >= RECOUNT_INTERVAL_FRAMES) {
+        object_count_ = countObjects(tab_container_);
+        frames_since_count_ = 0;
+    }
+
+    FrameSample& sample = ring_[head_];
+    sample.time_ms = lv_tick_get();
+    sample.frame_us = frame_us;
+    sample.flush_us = std::min(flush_us_, frame_us);
+    sample.render_us = frame_us - sample.flush_us;
+    sample.dirty_px = dirty_px_;
+    sample.flush_count = flush_count_;
+    sample.object_count = object_count_;
+    sample.tab = tab_;
+
+    head_ = (head_ + 1) % CAPACITY;
+    count_ = std::min(count_ + 1, CAPACITY);
+    total_frames_++;
+
+    TabTotals& totals = tabs_[tab_];
+    totals.frames++;
+    totals.frame_us += frame_us;
+    totals.max_frame_us = std::max(totals.max_frame_us, frame_us);
+    totals.flush_us += sample.flush_us;
+    totals.dirty_px += dirty_px_;
+    totals.object_count = object_count_;
+}
+
+FrameProfiler::FrameSample FrameProfiler::getSample(size_t index) const {
+    return ring_[(head_ + CAPACITY - count_ + index) % CAPACITY];
+}
+
+std::vector<FrameProfiler::TabSummary> FrameProfiler::summarizeByTab() const {
+    std::vector<TabSummary> result;
+    for (size_t i = 0; i < tab_count_; ++i) {
+        const TabTotals& totals = tabs_[i];
+        if (!totals.frames) continue;
+
+        TabSummary summary;
+        summary.name = totals.name;
+        summary.frames = totals.frames;
+        summary.mean_frame_us = static_cast<float>(totals.frame_us) / totals.frames;
+        summary.max_frame_us = totals.max_frame_us;
+        summary.mean_flush_us = static_cast<float>(totals.flush_us) / totals.frames;
+        summary.mean_dirty_px = static_cast<float>(totals.dirty_px) / totals.frames;
+        summary.object_count = totals.object_count;
+        result.push_back(summary);
+    }
+    return result;
+}
+
+void FrameProfiler::logSummary() const {
+    for (const auto& tab : summarizeByTab()) {
+        LOG_INFO("FrameProfiler", "%-10s %6u frames  frame %6.0f us (max %6u)  flush %6.0f us  dirty %7.0f px  %u objects",
+                 tab.name.c_str(), tab.frames, tab.mean_frame_us, tab.max_frame_us,
+                 tab.mean_flush_us, tab.mean_dirty_px, tab.object_count);
+    }
+}
+
+void FrameProfiler::overlayTimerCallback(lv_timer_t* timer) {
+    static_cast<FrameProfiler*>(lv_timer_get_user_data(timer))->updateOverlay();
+}
+
+void FrameProfiler::updateOverlay() {
+    uint32_t now_ms = lv_tick_get();
+    uint32_t frames = std::min<uint32_t>(total_frames_ - overlay_from_, static_cast<uint32_t>(count_));
+    uint32_t elapsed_ms = now_ms - overlay_time_ms_;
+    overlay_from_ = total_frames_;
+    overlay_time_ms_ = now_ms;
+
+    uint64_t frame_us = 0;
+    uint64_t flush_us = 0;
+    uint64_t dirty_px = 0;
+    uint32_t max_us = 0;
+    for (size_t i = count_ - frames; i < count_; ++i) {
+        FrameSample sample = getSample(i);
+        frame_us += sample.frame_us;
+        flush_us += sample.flush_us;
+        dirty_px += sample.dirty_px;
+        max_us = std::max(max_us, sample.frame_us);
+    }
+
+    uint32_t screen_px = static_cast<uint32_t>(lv_display_get_horizontal_resolution(display_) *
+                                               lv_display_get_vertical_resolution(display_));
+    float loop_idle = LoopScheduler::getInstance().getStats().recent_idle_percent;
+    char text[160];
+    if (frames) {
+        std::snprintf(text, sizeof(text), "%s  %.0f fps  frame %.1f/%.1f ms  flush %.1f ms  dirty %.0f%%  obj %u  loop idle %.0f%%",
+                      tabs_[tab_].name.c_str(),
+                      elapsed_ms ? frames * 1000.0f / elapsed_ms : 0.0f,
+                      frame_us / 1000.0f / frames, max_us / 1000.0f,
+                      flush_us / 1000.0f / frames,
+                      screen_px ? 100.0f * dirty_px / frames / screen_px : 0.0f,
+                      object_count_, loop_idle);
+    } else {
+        std::snprintf(text, sizeof(text), "%s  idle  obj %u  loop idle %.0f%%", tabs_[tab_].name.c_str(),
+                      object_count_, loop_idle);
+    }
+    lv_label_set_text(overlay_, text);
+}
+
+#if !defined(ESP32_BUILD)
+bool FrameProfiler::exportCsv(const std::string& path) const {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        LOG_ERROR("FrameProfiler", "Cannot write %s", path.c_str());
+        return false;
+    }
+
+    std::fprintf(out, "time_ms,tab,frame_us,render_us,flush_us,dirty_px,flush_count,object_count\n");
+    for (size_t i = 0; i < count_; ++i) {
+        FrameSample s = getSample(i);
+        std::fprintf(out, "%u,%s,%u,%u,%u,%u,%u,%u\n", s.time_ms, tabs_[s.tab].name.c_str(),
+                     s.frame_us, s.render_us, s.flush_us, s.dirty_px, s.flush_count, s.object_count);
+    }
+    std::fclose(out);
+
+    LOG_INFO("FrameProfiler", "Wrote %zu frames to %s", count_, path.c_str());
+    return true;
+}
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <lvgl.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Per-frame render cost, attributed to the active tab
+ *
+ * Hooks the display's refresh / flush events and, for every refresh that
+ * actually redrew something, records:
+ * - frame time (REFR_START -> REFR_READY)
+ * - flush time (inside flush_cb plus any wait for flush-ready)
+ * - render time (frame - flush, i.e. LVGL drawing)
+ * - dirty pixels and number of flushed areas
+ * - object count of the active tab's subtree
+ *
+ * The last CAPACITY frames are kept in a ring (CSV export on desktop);
+ * per-tab totals cover the whole session and are logged when the tab
+ * changes. The optional overlay on the top layer shows the running figures
+ * (it redraws itself twice a second, which shows up as a small dirty area).
+ *
+ * Enabled by the "system.frame_profiler" setting or setEnabled(). UI thread only.
+ */
+class FrameProfiler {
+public:
+    static constexpr size_t CAPACITY = 256;
+    static constexpr size_t MAX_TABS = 8;
+
+    struct FrameSample {
+        uint32_t time_ms;       // lv_tick_get() at frame end
+        uint32_t frame_us;
+        uint32_t render_us;
+        uint32_t flush_us;
+        uint32_t dirty_px;
+        uint16_t flush_count;
+        uint16_t object_count;
+        uint8_t tab;            // Index into getTabName()
+    };
+
+    struct TabSummary {
+        std::string name;
+        uint32_t frames = 0;
+        float mean_frame_us = 0.0f;
+        uint32_t max_frame_us = 0;
+        float mean_flush_us = 0.0f;
+        float mean_dirty_px = 0.0f;
+        uint16_t object_count = 0;
+    };
+
+    static FrameProfiler& getInstance();
+
+    // Hook a display's events; call once after it is created
+    void attach(lv_display_t* display);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled_; }
+    void setOverlayVisible(bool visible);
+
+    // Called by SynthApp on tab changes
+    void setActiveTab(const std::string& name, lv_obj_t* container);
+
+    // Ring access, oldest first
+    size_t getSampleCount() const { return count_; }
+    FrameSample getSample(size_t index) const;
+    const std::string& getTabName(uint8_t tab) const { return tabs_[tab].name; }
+
+    std::vector<TabSummary> summarizeByTab() const;
+    void logSummary() const;
+
+#if !defined(ESP32_BUILD)
+    bool exportCsv(const std::string& path) const;
+#endif
+
+private:
+    FrameProfiler();
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    struct TabTotals {
+        std::string name;
+        uint32_t frames = 0;
+        uint64_t frame_us = 0;
+        uint32_t max_frame_us = 0;
+        uint64_t flush_us = 0;
+        uint64_t dirty_px = 0;
+        uint16_t object_count = 0;
+    };
+
+    static void eventCallback(lv_event_t* e);
+    static void overlayTimerCallback(lv_timer_t* timer);
+    static uint16_t countObjects(lv_obj_t* obj);
+
+    void onEvent(lv_event_code_t code, void* param);
+    void endFrame();
+    uint8_t tabIndex(const std::string& name);
+    void updateOverlay();
+
+    lv_display_t* display_ = nullptr;
+    bool enabled_ = false;
+
+    // Current frame
+    uint64_t frame_start_us_ = 0;
+    uint64_t flush_start_us_ = 0;
+    uint64_t wait_start_us_ = 0;
+    uint32_t flush_us_ = 0;
+    uint32_t dirty_px_ = 0;
+    uint16_t flush_count_ = 0;
+
+    // Active tab
+    uint8_t tab_ = 0;
+    lv_obj_t* tab_container_ = nullptr;
+    uint16_t object_count_ = 0;
+    uint32_t frames_since_count_ = 0;
+
+    std::array<FrameSample, CAPACITY> ring_{};
+    size_t head_ = 0;                 // Next slot to write
+    size_t count_ = 0;
+    uint32_t total_frames_ = 0;
+    std::array<TabTotals, MAX_TABS> tabs_{};
+    size_t tab_count_ = 0;
+
+    // Overlay
+    lv_obj_t* overlay_ = nullptr;
+    lv_timer_t* overlay_timer_ = nullptr;
+    uint32_t overlay_from_ = 0;       // total_frames_ at the last overlay refresh
+    uint32_t overlay_time_ms_ = 0;
+};
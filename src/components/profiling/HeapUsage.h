@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(ESP32_BUILD)
+#include <esp_heap_caps.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * @brief Bytes currently allocated from the default heap
+ *
+ * For before/after deltas around one operation (other threads allocating
+ * meanwhile show up too). ESP32: internal RAM plus PSRAM reachable through
+ * malloc(); desktop: glibc's in-use total. Always 0 where neither is
+ * available.
+ */
+inline size_t heapUsedBytes() {
+#if defined(ESP32_BUILD)
+    return heap_caps_get_total_size(MALLOC_CAP_DEFAULT) - heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
@@ -129,6 +129,17 @@ void GlobalSettingsModal::registerGlobalSettings() {
     midi_device.current_value = std::string("LVGL Synth");
     settings.registerSetting(midi_device);
 
+    SettingsManager::SettingDefinition midi_output_budget;
+    midi_output_budget.key = "midi.output_budget";
+    midi_output_budget.display_name = "DIN Output Budget";
+    midi_output_budget.description = "Share of DIN MIDI bandwidth for output (%); excess CCs are merged";
+    midi_output_budget.type = SettingsManager::SettingType::INTEGER;
+    midi_output_budget.min_value = 10;
+    midi_output_budget.max_value = 100;
+    midi_output_budget.default_value = 80;
+    midi_output_budget.current_value = 80;
+    settings.registerSetting(midi_output_budget);
+
     // System Settings
     SettingsManager::SettingDefinition auto_save;
     auto_save.key = "system.auto_save";
@@ -148,6 +159,15 @@ void GlobalSettingsModal::registerGlobalSettings() {
     debug_mode.current_value = false;
     settings.registerSetting(debug_mode);
 
+    SettingsManager::SettingDefinition frame_profiler;
+    frame_profiler.key = "system.frame_profiler";
+    frame_profiler.display_name = "Frame Profiler";
+    frame_profiler.description = "Overlay with per-frame render cost of the active tab";
+    frame_profiler.type = SettingsManager::SettingType::BOOLEAN;
+    frame_profiler.default_value = false;
+    frame_profiler.current_value = false;
+    settings.registerSetting(frame_profiler);
+
     // MIDI Clock Settings
     SettingsManager::SettingDefinition clock_mode;
     clock_mode.key = "midi.clock_mode";
@@ -1,8 +1,20 @@
 #include "SettingsManager.h"
+#include "components/app/UiThread.h"
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
 
+namespace {
+    bool sameValue(const std::any& a, const std::any& b) {
+        if (a.type() != b.type()) return false;
+        if (a.type() == typeid(bool)) return std::any_cast<bool>(a) == std::any_cast<bool>(b);
+        if (a.type() == typeid(int)) return std::any_cast<int>(a) == std::any_cast<int>(b);
+        if (a.type() == typeid(float)) return std::any_cast<float>(a) == std::any_cast<float>(b);
+        if (a.type() == typeid(std::string)) return std::any_cast<std::string>(a) == std::any_cast<std::string>(b);
+        return !a.has_value();
+    }
+}
+
 SettingsManager& SettingsManager::getInstance() {
     static SettingsManager instance;
     return instance;
@@ -25,6 +37,12 @@ void SettingsManager::registerSetting(const SettingDefinition& definition) {
     settings_[definition.key] = definition;
     std::cout << "SettingsManager: Registered setting '" << definition.key 
               << "' (" << definition.display_name << ")" << std::endl;
+    
+    // Observers added before the setting existed assume its default; tell
+    // them about anything else (e.g. a persisted value)
+    if (definition.current_value.has_value() && !sameValue(definition.current_value, definition.default_value)) {
+        notifyObservers(definition.key, definition.default_value, definition.current_value);
+    }
 }
 
 void SettingsManager::setValue(const std::string& key, const std::any& value) {
@@ -197,6 +215,9 @@ void SettingsManager::resetToDefaults() {
 }
 
 void SettingsManager::notifyObservers(const std::string& key, const std::any& old_value, const std::any& new_value) {
+    // Observers reconfigure MIDI and touch LVGL objects
+    ASSERT_UI_THREAD();
+    
     for (const auto& observer : observers_) {
         try {
             observer.second(key, old_value, new_value);
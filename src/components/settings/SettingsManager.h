@@ -49,7 +49,8 @@ public:
     void addObserver(const std::string& observer_id, SettingChangedCallback callback);
     void removeObserver(const std::string& observer_id);
 
-    // Setting management
+    // Setting management. Registering a current_value other than the default
+    // notifies observers, as setValue() would.
     void registerSetting(const SettingDefinition& definition);
     void setValue(const std::string& key, const std::any& value);
     std::any getValue(const std::string& key) const;
@@ -100,7 +100,7 @@ void ControlButtonsRow::bindButtonToParameter(std::shared_ptr<ButtonControl> but
     button->bindParameter(parameter);
     
     // Set up value changed callback
-    button->setValueChangedCallback([this](uint8_t value, const Parameter* param) {
+    button->setValueChangedCallback([this](uint16_t value, const Parameter* param) {
         if (parameter_change_callback_) {
             parameter_change_callback_(value, param);
         }
@@ -18,7 +18,7 @@ struct ButtonDefinition {
 
 class ControlButtonsRow {
 public:
-    using ParameterChangeCallback = std::function<void(uint8_t value, const Parameter* param)>;
+    using ParameterChangeCallback = std::function<void(uint16_t value, const Parameter* param)>;
 
     explicit ControlButtonsRow(ParameterBinder* parameter_binder);
     ~ControlButtonsRow() = default;
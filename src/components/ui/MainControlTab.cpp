@@ -11,6 +11,7 @@
 #include "components/parameter/Command.h"  // For SetParameterCommand
 #include "Constants.h"
 #include "components/ui/ContainerFactory.h"
+#include "components/log/Log.h"
 #include <iostream>
 
 MainControlTab::MainControlTab(ParameterBinder* param_binder, CommandManager* cmd_manager, MidiHandler* midi_handler)
@@ -122,11 +123,11 @@ void MainControlTab::setupComponents() {
     undo_redo_panel_->create(status_container_);
 
     // Set up callbacks
-    dials_grid_->setParameterChangeCallback([this](uint8_t value, const Parameter* param) {
+    dials_grid_->setParameterChangeCallback([this](uint16_t value, const Parameter* param) {
         onParameterChanged(value, param);
     });
 
-    buttons_row_->setParameterChangeCallback([this](uint8_t value, const Parameter* param) {
+    buttons_row_->setParameterChangeCallback([this](uint16_t value, const Parameter* param) {
         onParameterChanged(value, param);
     });
 
@@ -170,34 +171,19 @@ void MainControlTab::setupButtonDefinitions() {
     buttons_row_->setButtonDefinitions(button_defs);
 }
 
-void MainControlTab::onParameterChanged(uint8_t value, const Parameter* param) {
-    std::cout << "MainControlTab::onParameterChanged called with value: " << (int)value << std::endl;
-    
+void MainControlTab::onParameterChanged(uint16_t value, const Parameter* param) {
     // Send MIDI output using UnifiedMidiManager (supports both USB and hardware MIDI)
     if (param) {
-        std::cout << "Parameter is valid, CC: " << (int)param->getCCNumber() << std::endl;
         auto& unified_midi = UnifiedMidiManager::getInstance();
-        std::cout << "Got UnifiedMidiManager instance" << std::endl;
-        
-        // Check overall status
-        auto overall_status = unified_midi.getOverallStatus();
-        std::cout << "UnifiedMidiManager overall status: " << (int)overall_status << std::endl;
         
         if (unified_midi.isConnected()) {
-            std::cout << "UnifiedMidiManager is connected - sending MIDI" << std::endl;
-            unified_midi.sendControlChange(1, param->getCCNumber(), value);
-            std::cout << "MIDI CC sent: CC" << (int)param->getCCNumber() << " = " << (int)value << std::endl;
+            unified_midi.sendParameter(1, *param, value);
+            LOG_TRACE("MainControlTab", "MIDI CC sent: CC%d = %d", (int)param->getCCNumber(), (int)value);
         } else {
-            std::cout << "UnifiedMidiManager is NOT connected!" << std::endl;
-            
-            // Check individual backends
-            auto backends = unified_midi.getAvailableBackends();
-            for (const auto& backend : backends) {
-                std::cout << "Backend: " << backend.name << " - Status: " << (int)backend.status << std::endl;
-            }
+            LOG_DEBUG("MainControlTab", "MIDI not connected, CC%d = %d not sent", (int)param->getCCNumber(), (int)value);
         }
     } else {
-        std::cout << "Parameter is NULL!" << std::endl;
+        LOG_WARN("MainControlTab", "onParameterChanged without a parameter");
     }
     
     // Create command for undo/redo
@@ -36,7 +36,7 @@ private:
     void setupComponents();
     void setupDialDefinitions();
     void setupButtonDefinitions();
-    void onParameterChanged(uint8_t value, const Parameter* param);
+    void onParameterChanged(uint16_t value, const Parameter* param);
     void onUndo();
     void onRedo();
     void updateStatusDisplay();
@@ -96,7 +96,7 @@ void ParameterDialsGrid::bindDialToParameter(std::shared_ptr<DialControl> dial,
     dial->bindParameter(parameter);
     
     // Set up value changed callback
-    dial->setValueChangedCallback([this](uint8_t value, const Parameter* param) {
+    dial->setValueChangedCallback([this](uint16_t value, const Parameter* param) {
         if (parameter_change_callback_) {
             parameter_change_callback_(value, param);
         }
@@ -20,7 +20,7 @@ struct DialDefinition {
 
 class ParameterDialsGrid {
 public:
-    using ParameterChangeCallback = std::function<void(uint8_t value, const Parameter* param)>;
+    using ParameterChangeCallback = std::function<void(uint16_t value, const Parameter* param)>;
 
     explicit ParameterDialsGrid(ParameterBinder* parameter_binder);
     ~ParameterDialsGrid() = default;
@@ -0,0 +1,107 @@
+#include "hardware/AlsaPortMonitor.h"
+
+#if !defined(ESP32_BUILD)
+
+#include <alsa/asoundlib.h>
+#include <poll.h>
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <iostream>
+#include <vector>
+
+AlsaPortMonitor::AlsaPortMonitor(ChangeCallback callback)
+    : callback_(std::move(callback)) {
+}
+
+AlsaPortMonitor::~AlsaPortMonitor() {
+    stop();
+}
+
+bool AlsaPortMonitor::start() {
+    if (running_.load(std::memory_order_acquire)) return true;
+
+    if (snd_seq_open(&seq_, "default", SND_SEQ_OPEN_INPUT, SND_SEQ_NONBLOCK) < 0) {
+        std::cerr << "[AlsaPortMonitor] Cannot open ALSA sequencer" << std::endl;
+        seq_ = nullptr;
+        return false;
+    }
+    snd_seq_set_client_name(seq_, "LVGL Synth Port Monitor");
+
+    int port = snd_seq_create_simple_port(seq_, "announce",
+                                          SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_NO_EXPORT,
+                                          SND_SEQ_PORT_TYPE_APPLICATION);
+    if (port < 0 ||
+        snd_seq_connect_from(seq_, port, SND_SEQ_CLIENT_SYSTEM, SND_SEQ_PORT_SYSTEM_ANNOUNCE) < 0) {
+        std::cerr << "[AlsaPortMonitor] Cannot subscribe to System:Announce" << std::endl;
+        snd_seq_close(seq_);
+        seq_ = nullptr;
+        return false;
+    }
+
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        snd_seq_close(seq_);
+        seq_ = nullptr;
+        return false;
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&AlsaPortMonitor::run, this);
+    std::cout << "[AlsaPortMonitor] Watching for MIDI port changes" << std::endl;
+    return true;
+}
+
+void AlsaPortMonitor::stop() {
+    if (running_.exchange(false, std::memory_order_acq_rel)) {
+        uint64_t one = 1;
+        ssize_t written = write(wake_fd_, &one, sizeof(one));
+        (void)written;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    if (seq_) {
+        snd_seq_close(seq_);
+        seq_ = nullptr;
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+        wake_fd_ = -1;
+    }
+}
+
+void AlsaPortMonitor::run() {
+    int seq_fd_count = snd_seq_poll_descriptors_count(seq_, POLLIN);
+    std::vector<pollfd> fds(seq_fd_count + 1);
+    snd_seq_poll_descriptors(seq_, fds.data(), seq_fd_count, POLLIN);
+    fds[seq_fd_count] = pollfd{wake_fd_, POLLIN, 0};
+
+    while (running_.load(std::memory_order_acquire)) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[seq_fd_count].revents & POLLIN) {
+            break;  // stop()
+        }
+
+        snd_seq_event_t* event = nullptr;
+        while (snd_seq_event_input(seq_, &event) >= 0 && event) {
+            switch (event->type) {
+                case SND_SEQ_EVENT_PORT_START:
+                    callback_(Change::PORT_ADDED, event->data.addr.client, event->data.addr.port);
+                    break;
+                case SND_SEQ_EVENT_PORT_EXIT:
+                    callback_(Change::PORT_REMOVED, event->data.addr.client, event->data.addr.port);
+                    break;
+                default:
+                    break;  // Client start/exit and subscription changes aren't needed
+            }
+            event = nullptr;
+        }
+    }
+}
+
+#endif // !defined(ESP32_BUILD)
@@ -0,0 +1,51 @@
+// src/hardware/AlsaPortMonitor.h - ALSA sequencer hot-plug notifications
+#pragma once
+
+#if !defined(ESP32_BUILD)
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+struct _snd_seq;
+
+/**
+ * @brief Watches the ALSA sequencer for ports coming and going
+ *
+ * Opens its own sequencer client, subscribes to System:Announce and blocks
+ * in poll() on a background thread, so a device being plugged in or power
+ * cycled is seen immediately without rescanning the port list. The callback
+ * runs on that thread and should only record the change (e.g. set a flag);
+ * the owner reacts on its own thread.
+ */
+class AlsaPortMonitor {
+public:
+    enum class Change {
+        PORT_ADDED,
+        PORT_REMOVED
+    };
+
+    using ChangeCallback = std::function<void(Change change, int client, int port)>;
+
+    explicit AlsaPortMonitor(ChangeCallback callback);
+    ~AlsaPortMonitor();
+
+    AlsaPortMonitor(const AlsaPortMonitor&) = delete;
+    AlsaPortMonitor& operator=(const AlsaPortMonitor&) = delete;
+
+    // Returns false if the sequencer or the announce subscription is unavailable
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+
+    ChangeCallback callback_;
+    _snd_seq* seq_ = nullptr;
+    int wake_fd_ = -1;          // eventfd used by stop() to break poll()
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+#endif // !defined(ESP32_BUILD)
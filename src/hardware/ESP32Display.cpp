@@ -3,23 +3,36 @@
 
 
 #include "hardware/ESP32Display.h"
+#include "components/app/LoopScheduler.h"
+#include <Arduino.h>
 #include <iostream>
 #include <algorithm>
 
 // Static instance for callbacks
 ESP32Display* ESP32Display::instance_ = nullptr;
 
+namespace {
+    // T_IRQ goes low when the panel is pressed
+    void IRAM_ATTR touchInterrupt() {
+        LoopScheduler::getInstance().wakeFromIsr(LoopScheduler::Source::TOUCH);
+    }
+}
+
 ESP32Display::ESP32Display() 
     : display_(nullptr)
     , touch_indev_(nullptr) 
-    , display_buffer_(nullptr)
-    , touch_debug_(false) {
+    , display_buffers_{nullptr, nullptr}
+    , async_flush_(false)
+    , touch_debug_(false)
+    , touch_irq_(false) {
     instance_ = this;
 }
 
 ESP32Display::~ESP32Display() {
-    if (display_buffer_) {
-        heap_caps_free(display_buffer_);
+    for (uint8_t* buffer : display_buffers_) {
+        if (buffer) {
+            heap_caps_free(buffer);
+        }
     }
     instance_ = nullptr;
 }
@@ -44,21 +57,60 @@ bool ESP32Display::initialize() {
 }
 
 void ESP32Display::setupDisplay() {
-    // Create display buffer
-    size_t buffer_pixels = tft_.width() * 40;
-    display_buffer_ = (lv_color_t*)heap_caps_malloc(
-        buffer_pixels * sizeof(lv_color_t), MALLOC_CAP_DMA);
+    // Create LVGL display
+    display_ = lv_display_create(tft_.width(), tft_.height());
+    lv_display_set_flush_cb(display_, flushCallback);
     
-    if (!display_buffer_) {
+    lv_color_format_t cf = lv_display_get_color_format(display_);
+    size_t buffer_bytes = lv_draw_buf_width_to_stride(tft_.width(), cf) * BUFFER_LINES;
+    
+    if (!allocateBuffers(buffer_bytes)) {
         std::cerr << "Failed to allocate display buffer!" << std::endl;
         return;
     }
     
-    // Create LVGL display
-    display_ = lv_display_create(tft_.width(), tft_.height());
-    lv_display_set_flush_cb(display_, flushCallback);
-    lv_display_set_buffers(display_, display_buffer_, NULL, 
-        buffer_pixels * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_buffers(display_, display_buffers_[0], display_buffers_[1],
+        buffer_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    
+    if (async_flush_) {
+        // LVGL calls this before reusing a buffer that may still be on the bus
+        lv_display_set_flush_wait_cb(display_, flushWaitCallback);
+    }
+}
+
+bool ESP32Display::allocateBuffers(size_t bytes) {
+    // Preferred: both buffers in internal DMA-capable RAM, sent asynchronously
+    display_buffers_[0] = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    display_buffers_[1] = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    if (display_buffers_[0] && display_buffers_[1]) {
+        async_flush_ = true;
+        std::cout << "Display buffers: 2 x " << bytes << " bytes internal DMA, async flush" << std::endl;
+        return true;
+    }
+    for (uint8_t*& buffer : display_buffers_) {
+        heap_caps_free(buffer);
+        buffer = nullptr;
+    }
+    
+    // PSRAM: still double-buffered, but the SPI DMA can't read PSRAM without
+    // a cache writeback per flush, so transfers stay blocking
+    display_buffers_[0] = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    display_buffers_[1] = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (display_buffers_[0] && display_buffers_[1]) {
+        std::cout << "Display buffers: 2 x " << bytes << " bytes PSRAM, blocking flush" << std::endl;
+        return true;
+    }
+    for (uint8_t*& buffer : display_buffers_) {
+        heap_caps_free(buffer);
+        buffer = nullptr;
+    }
+    
+    // Last resort: the original single internal buffer
+    display_buffers_[0] = (uint8_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    if (display_buffers_[0]) {
+        std::cout << "Display buffer: 1 x " << bytes << " bytes, blocking flush" << std::endl;
+    }
+    return display_buffers_[0] != nullptr;
 }
 
 void ESP32Display::setupTouch() {
@@ -67,6 +119,13 @@ void ESP32Display::setupTouch() {
     lv_indev_set_type(touch_indev_, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(touch_indev_, touchCallback);
     
+    // With the pen IRQ the read timer only runs while the panel is touched,
+    // so an idle screen does not wake the loop every read period
+    LoopScheduler::getInstance();   // Construct it here, not in the ISR
+    pinMode(LGFX_ST7796S::TOUCH_IRQ_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(LGFX_ST7796S::TOUCH_IRQ_PIN), touchInterrupt, FALLING);
+    touch_irq_ = true;
+    
     std::cout << "Touch panel configured with calibration:" << std::endl;
     std::cout << "  X range: " << touch_cal_.min_x << " - " << touch_cal_.max_x << std::endl;
     std::cout << "  Y range: " << touch_cal_.min_y << " - " << touch_cal_.max_y << std::endl;
@@ -78,6 +137,16 @@ void ESP32Display::flushCallback(lv_display_t *disp, const lv_area_t *area, uint
     uint32_t w = area->x2 - area->x1 + 1;
     uint32_t h = area->y2 - area->y1 + 1;
     
+    if (instance_->async_flush_) {
+        // Byte-swap in place so the panel takes the buffer as-is and DMA can
+        // stream it without LovyanGFX converting through its own buffer.
+        // Completion is awaited in flushWaitCallback.
+        lv_draw_sw_rgb565_swap(px_map, w * h);
+        instance_->tft_.startWrite();
+        instance_->tft_.pushImageDMA(area->x1, area->y1, w, h, (const lgfx::swap565_t *)px_map);
+        return;
+    }
+    
     instance_->tft_.startWrite();
     instance_->tft_.setAddrWindow(area->x1, area->y1, w, h);
     instance_->tft_.pushPixels((uint16_t *)px_map, w * h, true);
@@ -86,6 +155,14 @@ void ESP32Display::flushCallback(lv_display_t *disp, const lv_area_t *area, uint
     lv_display_flush_ready(disp);
 }
 
+void ESP32Display::flushWaitCallback(lv_display_t *disp) {
+    if (instance_) {
+        instance_->tft_.waitDMA();
+        instance_->tft_.endWrite();
+    }
+    lv_display_flush_ready(disp);
+}
+
 void ESP32Display::touchCallback(lv_indev_t* indev, lv_indev_data_t* data) {
     if (!instance_) return;
     
@@ -115,6 +192,16 @@ void ESP32Display::touchCallback(lv_indev_t* indev, lv_indev_data_t* data) {
         }
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
+        if (instance_->touch_irq_) {
+            lv_timer_pause(lv_indev_get_read_timer(indev));
+        }
     }
 }
+
+void ESP32Display::onTouchWake() {
+    if (!touch_indev_) return;
+    
+    lv_timer_resume(lv_indev_get_read_timer(touch_indev_));
+    lv_indev_read(touch_indev_);
+}
 #endif // ESP32_BUILD
\ No newline at end of file
@@ -18,6 +18,10 @@ public:
     // Get the touch input device (for LVGL)
     lv_indev_t* getTouchInput() { return touch_indev_; }
     
+    // Called from the loop after the touch IRQ woke it: resumes polling the
+    // panel (paused while nothing touches it) and reads the press right away
+    void onTouchWake();
+    
     // Display info
     int getWidth() const { return tft_.width(); }
     int getHeight() const { return tft_.height(); }
@@ -39,13 +43,21 @@ private:
     LGFX_ST7796S tft_;
     lv_display_t* display_;
     lv_indev_t* touch_indev_;
-    lv_color_t* display_buffer_;
+    
+    // Two partial buffers: LVGL renders into one while DMA sends the other.
+    // Internal DMA RAM when it fits (async flush), else PSRAM (blocking flush).
+    static constexpr int BUFFER_LINES = 40;
+    uint8_t* display_buffers_[2];
+    bool async_flush_;
     TouchCalibration touch_cal_;
     bool touch_debug_;
+    bool touch_irq_;
     
     void setupDisplay();
     void setupTouch();
+    bool allocateBuffers(size_t bytes);
     static void flushCallback(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void flushWaitCallback(lv_display_t *disp);
     static void touchCallback(lv_indev_t* indev, lv_indev_data_t* data);
     
     // Static instance for callbacks
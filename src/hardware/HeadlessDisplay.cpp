@@ -0,0 +1,305 @@
+// src/hardware/HeadlessDisplay.cpp
+#if !defined(ESP32_BUILD)  // Desktop only
+
+#include "hardware/HeadlessDisplay.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+#include <time.h>
+
+namespace {
+    uint64_t monotonicUs() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000ULL + ts.tv_nsec / 1000;
+    }
+
+    // SDL normally provides LVGL's tick; without it we do
+    uint32_t tickMs() {
+        return static_cast<uint32_t>(monotonicUs() / 1000);
+    }
+}
+
+HeadlessDisplay::HeadlessDisplay(int width, int height, const Options& options)
+    : width_(width)
+    , height_(height)
+    , options_(options) {
+}
+
+HeadlessDisplay::~HeadlessDisplay() {
+    // Like the SDL window, the display lives until exit; LVGL is not
+    // deinitialised, so its objects are not deleted here either
+}
+
+bool HeadlessDisplay::initialize() {
+    std::cout << "=== HeadlessDisplay Initialization ===" << std::endl;
+
+    if (!options_.script_path.empty() && !loadScript(options_.script_path)) {
+        return false;
+    }
+
+    lv_tick_set_cb(tickMs);
+
+    framebuffer_.assign(static_cast<size_t>(width_) * height_, 0);
+
+    display_ = lv_display_create(width_, height_);
+    lv_display_set_user_data(display_, this);
+    lv_display_set_flush_cb(display_, flushCallback);
+
+    // One full-screen partial buffer: every invalidated area is rendered and
+    // flushed separately, so the flushed pixels are exactly what was redrawn
+    lv_color_format_t cf = lv_display_get_color_format(display_);
+    uint32_t size = lv_draw_buf_width_to_stride(width_, cf) * height_;
+    render_buffer_.assign(size, 0);
+    lv_display_set_buffers(display_, render_buffer_.data(), nullptr, size, LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_display_add_event_cb(display_, refreshEventCallback, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(display_, refreshEventCallback, LV_EVENT_REFR_READY, this);
+
+    pointer_ = lv_indev_create();
+    lv_indev_set_type(pointer_, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer_, pointerCallback);
+    lv_indev_set_user_data(pointer_, this);
+    lv_indev_set_display(pointer_, display_);
+
+    std::cout << "  Framebuffer: " << width_ << "x" << height_ << std::endl;
+    std::cout << "  Script: " << (options_.script_path.empty() ? "none" : options_.script_path)
+              << " (" << script_.size() << " steps)" << std::endl;
+    if (options_.max_frames) {
+        std::cout << "  Frame limit: " << options_.max_frames << std::endl;
+    }
+    return true;
+}
+
+bool HeadlessDisplay::loadScript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "[Headless] Cannot open script " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream in(line);
+        std::string word;
+        if (!(in >> word)) continue;
+
+        Command cmd;
+        bool ok = true;
+        if (word == "wait") {
+            cmd.op = Op::WAIT;
+            ok = static_cast<bool>(in >> cmd.ms);
+            script_.push_back(cmd);
+        } else if (word == "press" || word == "move") {
+            cmd.op = word == "press" ? Op::PRESS : Op::MOVE;
+            ok = static_cast<bool>(in >> cmd.x >> cmd.y);
+            script_.push_back(cmd);
+        } else if (word == "release") {
+            cmd.op = Op::RELEASE;
+            script_.push_back(cmd);
+        } else if (word == "click") {
+            cmd.op = Op::PRESS;
+            ok = static_cast<bool>(in >> cmd.x >> cmd.y);
+            script_.push_back(cmd);
+            script_.push_back(Command(Op::RELEASE));
+        } else if (word == "drag") {
+            Command glide(Op::GLIDE);
+            cmd.op = Op::PRESS;
+            ok = static_cast<bool>(in >> cmd.x >> cmd.y >> glide.x >> glide.y >> glide.ms);
+            script_.push_back(cmd);
+            script_.push_back(glide);
+            script_.push_back(Command(Op::RELEASE));
+        } else if (word == "screenshot") {
+            cmd.op = Op::SCREENSHOT;
+            ok = static_cast<bool>(in >> cmd.path);
+            script_.push_back(cmd);
+        } else if (word == "quit") {
+            cmd.op = Op::QUIT;
+            script_.push_back(cmd);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "[Headless] " << path << ":" << line_number << ": cannot parse '" << line << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void HeadlessDisplay::advanceScript(uint32_t now_ms) {
+    while (script_pos_ < script_.size()) {
+        const Command& cmd = script_[script_pos_];
+        if (!step_started_) {
+            step_start_ms_ = now_ms;
+            step_started_ = true;
+            glide_from_x_ = point_.x;
+            glide_from_y_ = point_.y;
+        }
+        uint32_t elapsed = now_ms - step_start_ms_;
+
+        bool state_changed = false;
+        switch (cmd.op) {
+            case Op::WAIT:
+                if (elapsed < cmd.ms) return;
+                break;
+            case Op::PRESS:
+            case Op::MOVE:
+                point_.x = cmd.x;
+                point_.y = cmd.y;
+                pressed_ = true;
+                state_changed = true;
+                break;
+            case Op::RELEASE:
+                pressed_ = false;
+                state_changed = true;
+                break;
+            case Op::GLIDE: {
+                float t = cmd.ms ? std::min(1.0f, static_cast<float>(elapsed) / cmd.ms) : 1.0f;
+                point_.x = glide_from_x_ + static_cast<int32_t>((cmd.x - glide_from_x_) * t);
+                point_.y = glide_from_y_ + static_cast<int32_t>((cmd.y - glide_from_y_) * t);
+                if (t < 1.0f) return;
+                state_changed = true;
+                break;
+            }
+            case Op::SCREENSHOT:
+                writeScreenshot(cmd.path);
+                break;
+            case Op::QUIT:
+                finished_ = true;
+                return;
+        }
+
+        script_pos_++;
+        step_started_ = false;
+
+        // Let LVGL see every press/move/release as its own input reading
+        if (state_changed) return;
+    }
+
+    if (!script_.empty()) {
+        finished_ = true;
+    }
+}
+
+void HeadlessDisplay::pointerCallback(lv_indev_t* indev, lv_indev_data_t* data) {
+    auto* self = static_cast<HeadlessDisplay*>(lv_indev_get_user_data(indev));
+    if (!self) return;
+
+    self->advanceScript(lv_tick_get());
+    data->point = self->point_;
+    data->state = self->pressed_ ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void HeadlessDisplay::flushCallback(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+    auto* self = static_cast<HeadlessDisplay*>(lv_display_get_user_data(disp));
+    if (self) {
+        int32_t w = lv_area_get_width(area);
+        int32_t h = lv_area_get_height(area);
+        self->frame_pixels_ += static_cast<uint64_t>(w) * h;
+
+        lv_color_format_t cf = lv_display_get_color_format(disp);
+        if (lv_color_format_get_size(cf) == sizeof(uint32_t)) {
+            uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+            for (int32_t y = 0; y < h; ++y) {
+                const uint8_t* src = px_map + static_cast<size_t>(y) * stride;
+                uint32_t* dst = &self->framebuffer_[static_cast<size_t>(area->y1 + y) * self->width_ + area->x1];
+                std::copy_n(reinterpret_cast<const uint32_t*>(src), w, dst);
+            }
+        }
+    }
+    lv_display_flush_ready(disp);
+}
+
+void HeadlessDisplay::refreshEventCallback(lv_event_t* e) {
+    auto* self = static_cast<HeadlessDisplay*>(lv_event_get_user_data(e));
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        self->onRefreshStart();
+    } else {
+        self->onRefreshReady();
+    }
+}
+
+void HeadlessDisplay::onRefreshStart() {
+    refresh_start_us_ = monotonicUs();
+    frame_pixels_ = 0;
+}
+
+void HeadlessDisplay::onRefreshReady() {
+    if (frame_pixels_ == 0) return;   // Nothing was invalid
+
+    uint32_t render_us = static_cast<uint32_t>(monotonicUs() - refresh_start_us_);
+    frames_++;
+    render_us_total_ += render_us;
+    render_us_max_ = std::max(render_us_max_, render_us);
+    pixels_total_ += frame_pixels_;
+    pixels_max_ = std::max(pixels_max_, frame_pixels_);
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    heap_max_used_ = std::max<uint32_t>(heap_max_used_, static_cast<uint32_t>(mon.max_used));
+#endif
+
+    if (options_.max_frames && frames_ >= options_.max_frames) {
+        finished_ = true;
+    }
+}
+
+bool HeadlessDisplay::writeScreenshot(const std::string& path) const {
+    FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) {
+        std::cerr << "[Headless] Cannot write " << path << std::endl;
+        return false;
+    }
+
+    std::fprintf(out, "P6\n%d %d\n255\n", width_, height_);
+    std::vector<uint8_t> row(static_cast<size_t>(width_) * 3);
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            uint32_t px = framebuffer_[static_cast<size_t>(y) * width_ + x];   // 0xXXRRGGBB
+            row[x * 3 + 0] = static_cast<uint8_t>(px >> 16);
+            row[x * 3 + 1] = static_cast<uint8_t>(px >> 8);
+            row[x * 3 + 2] = static_cast<uint8_t>(px);
+        }
+        std::fwrite(row.data(), 1, row.size(), out);
+    }
+    std::fclose(out);
+
+    std::cout << "[Headless] Screenshot written to " << path << std::endl;
+    return true;
+}
+
+void HeadlessDisplay::printReport() const {
+    uint64_t screen = static_cast<uint64_t>(width_) * height_;
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::cout << "=== Headless Render Report ===" << std::endl;
+    std::cout << "  Frames rendered: " << frames_ << std::endl;
+    if (frames_) {
+        std::printf("  Render time:     mean %.0f us, max %u us\n",
+                    static_cast<double>(render_us_total_) / frames_, render_us_max_);
+        std::printf("  Redrawn area:    mean %.0f px (%.1f%%), max %llu px (%.1f%%)\n",
+                    static_cast<double>(pixels_total_) / frames_,
+                    100.0 * pixels_total_ / frames_ / screen,
+                    static_cast<unsigned long long>(pixels_max_),
+                    100.0 * pixels_max_ / screen);
+    }
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    std::printf("  LVGL heap:       peak %u bytes\n", heap_max_used_);
+#endif
+    std::printf("  Process RSS:     peak %ld KiB\n", usage.ru_maxrss);
+    std::fflush(stdout);
+}
+
+#endif // !ESP32_BUILD
@@ -0,0 +1,104 @@
+// src/hardware/HeadlessDisplay.h - In-memory LVGL display for desktop runs without SDL
+#pragma once
+
+#if !defined(ESP32_BUILD)
+
+#include <lvgl.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief LVGL display that renders into a RAM framebuffer, plus a scripted pointer
+ *
+ * Lets the full SynthApp run on machines without a display or SDL. Each
+ * refresh is measured: render time (REFR_START -> REFR_READY), pixels actually
+ * redrawn (sum of flushed areas) and LVGL heap use; printReport() summarises
+ * them at exit.
+ *
+ * Pointer input comes from a script, one command per line ('#' comments):
+ *
+ *   wait MS                     hold the current state for MS milliseconds
+ *   press X Y / move X Y        pointer down at / drag to (X, Y)
+ *   release                     pointer up
+ *   click X Y                   press + release
+ *   drag X1 Y1 X2 Y2 MS         press, glide to (X2, Y2) over MS, release
+ *   screenshot FILE.ppm         dump the framebuffer
+ *   quit                        finish now
+ *
+ * The run is finished when the script ends (or quits) or after max_frames
+ * rendered frames, whichever comes first; with neither it runs until killed.
+ */
+class HeadlessDisplay {
+public:
+    struct Options {
+        std::string script_path;     // Empty = no input
+        uint32_t max_frames = 0;     // 0 = no limit
+    };
+
+    HeadlessDisplay(int width, int height, const Options& options);
+    ~HeadlessDisplay();
+
+    // Create the LVGL display and pointer; call after lv_init()
+    bool initialize();
+
+    lv_display_t* getDisplay() { return display_; }
+    lv_indev_t* getPointer() { return pointer_; }
+
+    bool isFinished() const { return finished_; }
+    bool writeScreenshot(const std::string& path) const;
+    void printReport() const;
+
+private:
+    enum class Op { WAIT, PRESS, MOVE, RELEASE, GLIDE, SCREENSHOT, QUIT };
+    struct Command {
+        explicit Command(Op op_in = Op::WAIT) : op(op_in) {}
+        Op op;
+        int32_t x = 0;
+        int32_t y = 0;
+        uint32_t ms = 0;
+        std::string path;
+    };
+
+    bool loadScript(const std::string& path);
+    void advanceScript(uint32_t now_ms);
+
+    void onRefreshStart();
+    void onRefreshReady();
+
+    static void flushCallback(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map);
+    static void pointerCallback(lv_indev_t* indev, lv_indev_data_t* data);
+    static void refreshEventCallback(lv_event_t* e);
+
+    int width_;
+    int height_;
+    Options options_;
+    lv_display_t* display_ = nullptr;
+    lv_indev_t* pointer_ = nullptr;
+
+    std::vector<uint32_t> framebuffer_;
+    std::vector<uint8_t> render_buffer_;
+
+    // Script state
+    std::vector<Command> script_;
+    size_t script_pos_ = 0;
+    uint32_t step_start_ms_ = 0;
+    bool step_started_ = false;
+    int32_t glide_from_x_ = 0;
+    int32_t glide_from_y_ = 0;
+    lv_point_t point_ = {0, 0};
+    bool pressed_ = false;
+    bool finished_ = false;
+
+    // Per-frame measurements
+    uint64_t refresh_start_us_ = 0;
+    uint64_t frame_pixels_ = 0;
+    uint32_t frames_ = 0;             // Refreshes that redrew something
+    uint64_t render_us_total_ = 0;
+    uint32_t render_us_max_ = 0;
+    uint64_t pixels_total_ = 0;
+    uint64_t pixels_max_ = 0;
+    uint32_t heap_max_used_ = 0;
+};
+
+#endif // !ESP32_BUILD
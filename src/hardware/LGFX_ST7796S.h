@@ -19,6 +19,8 @@ class LGFX_ST7796S : public lgfx::LGFX_Device {
     lgfx::Touch_XPT2046  _touch_instance;
 
 public:
+    static constexpr int TOUCH_IRQ_PIN = 4;   // XPT2046 T_IRQ, low while touched
+
     LGFX_ST7796S(void) {
         { // SPI bus config
             auto cfg = _bus_instance.config();
@@ -72,7 +74,7 @@ public:
             cfg.x_max = 4095;
             cfg.y_min = 0;
             cfg.y_max = 4095;
-            cfg.pin_int = 4;         // T_IRQ pin
+            cfg.pin_int = TOUCH_IRQ_PIN;
             cfg.bus_shared = false;  // Touch uses separate SPI bus
             cfg.offset_rotation = 0;
             cfg.spi_host = SPI2_HOST;  // or SPI3_HOST
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "components/midi/MidiEvent.h"
+#include "components/midi/SpscRing.h"
+#include "components/midi/MidiTime.h"
+#include "components/log/Log.h"
+#include "components/app/LoopScheduler.h"
+
 #if defined(ESP32_BUILD)
     #include <Arduino.h>
     #include <string>
@@ -8,11 +14,14 @@
 
 #else
     #include "RtMidi.h"
+    #include "hardware/AlsaPortMonitor.h"
     #include <iostream>
     #include <vector>
     #include <cstdint>
     #include <memory>
     #include <string>
+    #include <atomic>
+    #include <cstdio>
 #endif
 
 class MidiHandler {
@@ -26,6 +35,163 @@ private:
         std::unique_ptr<RtMidiOut> midi_out_;
         unsigned int current_port_;
         std::vector<std::string> available_ports_;
+        
+        // Incoming messages: pushed by RtMidi's input thread, popped by pollInput()
+        SpscRing<TimedMidiEvent, 256> input_queue_;
+        std::atomic<uint32_t> input_overflows_{0};
+        // Declared after the queue so it (and its callback thread) is torn down first
+        std::unique_ptr<RtMidiIn> midi_in_;
+        bool input_callback_set_ = false;
+        
+        // Hot-plug. The monitor thread only records that something changed;
+        // servicePortChanges() does the rescan/reopen on the sender thread,
+        // which is the only other user of midi_out_.
+        std::string preferred_port_name_;   // Stable name, see stablePortName()
+        std::string connected_port_name_;   // Full RtMidi name of the open output
+        std::atomic<bool> output_connected_{false};
+        std::atomic<int> connected_client_{-1};
+        std::atomic<int> connected_port_{-1};
+        std::atomic<bool> connected_port_lost_{false};
+        std::atomic<uint64_t> port_change_us_{0};   // First unhandled change, 0 = none
+        std::atomic<uint32_t> reconnect_latency_us_{0};
+        std::atomic<uint32_t> reconnect_count_{0};
+        // Declared last so its thread stops before the state above goes away
+        std::unique_ptr<AlsaPortMonitor> port_monitor_;
+        
+        // RtMidi's ALSA names end in " <client>:<port>", which changes when a
+        // device is re-plugged; the rest ("Client:Port") is stable
+        static std::string stablePortName(const std::string& name) {
+            size_t space = name.rfind(' ');
+            if (space == std::string::npos || name.find(':', space) == std::string::npos) return name;
+            return name.substr(0, space);
+        }
+        
+        static void parsePortAddress(const std::string& name, int& client, int& port) {
+            client = port = -1;
+            size_t space = name.rfind(' ');
+            if (space != std::string::npos) {
+                std::sscanf(name.c_str() + space + 1, "%d:%d", &client, &port);
+            }
+        }
+        
+        // Index of the output port matching a stable name, -1 if absent.
+        // Refreshes available_ports_.
+        int findOutputPort(const std::string& stable_name) {
+            available_ports_.clear();
+            int found = -1;
+            unsigned int port_count = midi_out_->getPortCount();
+            for (unsigned int i = 0; i < port_count; i++) {
+                available_ports_.push_back(midi_out_->getPortName(i));
+                if (found < 0 && !stable_name.empty() && stablePortName(available_ports_.back()) == stable_name) {
+                    found = static_cast<int>(i);
+                }
+            }
+            return found;
+        }
+        
+        void openOutputPort(int index) {
+            midi_out_->openPort(index);
+            current_port_ = index;
+            connected_port_name_ = available_ports_[index];
+            int client, port;
+            parsePortAddress(connected_port_name_, client, port);
+            connected_client_.store(client, std::memory_order_relaxed);
+            connected_port_.store(port, std::memory_order_relaxed);
+            output_connected_.store(true, std::memory_order_release);
+            if (preferred_port_name_.empty()) {
+                preferred_port_name_ = stablePortName(connected_port_name_);
+            }
+        }
+        
+        void closeOutputPort() {
+            if (midi_out_->isPortOpen()) {
+                midi_out_->closePort();
+            }
+            connected_port_name_.clear();
+            connected_client_.store(-1, std::memory_order_relaxed);
+            connected_port_.store(-1, std::memory_order_relaxed);
+        }
+        
+        // Monitor thread
+        void onPortChange(AlsaPortMonitor::Change change, int client, int port) {
+            if (change == AlsaPortMonitor::Change::PORT_REMOVED &&
+                client == connected_client_.load(std::memory_order_relaxed) &&
+                port == connected_port_.load(std::memory_order_relaxed)) {
+                connected_port_lost_.store(true, std::memory_order_release);
+            }
+            uint64_t none = 0;
+            port_change_us_.compare_exchange_strong(none, MidiTime::nowUs(), std::memory_order_acq_rel);
+        }
+        
+        static void onRtMidiInput(double /* timestamp */, std::vector<unsigned char>* message, void* user_data) {
+            auto* self = static_cast<MidiHandler*>(user_data);
+            if (!self || !message || message->empty()) return;
+            
+            const auto& bytes = *message;
+            if (bytes[0] < 0x80 || bytes[0] == 0xF0) return;  // Not a status byte / SysEx
+            
+            TimedMidiEvent event;
+            event.timestamp_us = MidiTime::nowUs();
+            event.event = MidiEvent::make(bytes[0],
+                                          bytes.size() > 1 ? bytes[1] : 0,
+                                          bytes.size() > 2 ? bytes[2] : 0);
+            if (!self->input_queue_.push(event)) {
+                self->input_overflows_.fetch_add(1, std::memory_order_relaxed);
+            }
+            LoopScheduler::getInstance().wake(LoopScheduler::Source::MIDI_INPUT);
+        }
+        
+        // One sendMessage() per batch; 32 three-byte messages
+        static constexpr size_t SEND_BUFFER_BYTES = 96;
+        
+        void sendBytes(const uint8_t* bytes, size_t length) {
+            if (length == 0) return;
+        
+            try {
+                midi_out_->sendMessage(bytes, length);
+            } catch (RtMidiError& error) {
+                LOG_ERROR("Desktop MIDI", "MIDI send error: %s", error.getMessage().c_str());
+            }
+        }
+        
+        void openInputPort() {
+            if (!midi_in_) return;
+            
+            try {
+                // Prefer the device we send to; otherwise skip the ALSA
+                // "Midi Through" port so our own output isn't looped back
+                unsigned int in_count = midi_in_->getPortCount();
+                int chosen = -1;
+                for (unsigned int i = 0; i < in_count; i++) {
+                    std::string port_name = midi_in_->getPortName(i);
+                    if (!preferred_port_name_.empty() && stablePortName(port_name) == preferred_port_name_) {
+                        chosen = static_cast<int>(i);
+                        break;
+                    }
+                    if (chosen < 0 && port_name.find("Through") == std::string::npos) {
+                        chosen = static_cast<int>(i);
+                    }
+                }
+                if (chosen >= 0) {
+                    midi_in_->openPort(chosen);
+                    std::cout << "Desktop MIDI: Listening on input port " << chosen << ": " << midi_in_->getPortName(chosen) << std::endl;
+                }
+                
+                if (!midi_in_->isPortOpen()) {
+                    midi_in_->openVirtualPort("LVGL Synth Controller In");
+                    std::cout << "Desktop MIDI: Created virtual input port 'LVGL Synth Controller In'" << std::endl;
+                }
+                
+                // Keep clock/transport, drop SysEx and active sensing
+                midi_in_->ignoreTypes(true, false, true);
+                if (!input_callback_set_) {
+                    midi_in_->setCallback(&MidiHandler::onRtMidiInput, this);
+                    input_callback_set_ = true;
+                }
+            } catch (RtMidiError& error) {
+                std::cerr << "Desktop MIDI input unavailable: " << error.getMessage() << std::endl;
+            }
+        }
     #endif
     
 public:
@@ -43,6 +209,11 @@ public:
             } catch (RtMidiError& error) {
                 std::cerr << "RtMidi initialization error: " << error.getMessage() << std::endl;
             }
+            try {
+                midi_in_ = std::make_unique<RtMidiIn>();
+            } catch (RtMidiError& error) {
+                std::cerr << "RtMidiIn initialization error: " << error.getMessage() << std::endl;
+            }
         #endif
     }
     
@@ -64,33 +235,41 @@ public:
             
             try {
                 // Scan for available MIDI ports
-                unsigned int port_count = midi_out_->getPortCount();
-                available_ports_.clear();
+                int preferred = findOutputPort(preferred_port_name_);
                 
-                std::cout << "Desktop MIDI: Found " << port_count << " output ports:" << std::endl;
+                std::cout << "Desktop MIDI: Found " << available_ports_.size() << " output ports:" << std::endl;
+                for (size_t i = 0; i < available_ports_.size(); i++) {
+                    std::cout << "  Port " << i << ": " << available_ports_[i] << std::endl;
+                }
                 
-                for (unsigned int i = 0; i < port_count; i++) {
-                    try {
-                        std::string port_name = midi_out_->getPortName(i);
-                        available_ports_.push_back(port_name);
-                        std::cout << "  Port " << i << ": " << port_name << std::endl;
-                    } catch (RtMidiError& error) {
-                        std::cerr << "Error getting port " << i << " name: " << error.getMessage() << std::endl;
+                // The preferred device if present, else the first real port
+                // (not Midi Through), else a virtual port
+                if (preferred < 0) {
+                    for (size_t i = 0; i < available_ports_.size(); i++) {
+                        if (available_ports_[i].find("Through") == std::string::npos) {
+                            preferred = static_cast<int>(i);
+                            break;
+                        }
                     }
                 }
                 
-                // Try to open the first available port, or create a virtual port
-                if (available_ports_.size() > 0) {
-                    // Open existing port
-                    midi_out_->openPort(0);
-                    current_port_ = 0;
-                    std::cout << "Desktop MIDI: Connected to port 0: " << available_ports_[0] << std::endl;
+                if (preferred >= 0) {
+                    openOutputPort(preferred);
+                    std::cout << "Desktop MIDI: Connected to port " << preferred << ": " << connected_port_name_ << std::endl;
                 } else {
                     // Create virtual port
                     midi_out_->openVirtualPort("LVGL Synth Controller");
+                    output_connected_.store(true, std::memory_order_release);
                     std::cout << "Desktop MIDI: Created virtual port 'LVGL Synth Controller'" << std::endl;
                 }
                 
+                openInputPort();
+                
+                // Follow devices coming and going from here on
+                port_monitor_ = std::make_unique<AlsaPortMonitor>(
+                    [this](AlsaPortMonitor::Change change, int client, int port) { onPortChange(change, client, port); });
+                port_monitor_->start();
+                
                 initialized_ = true;
                 return true;
                 
@@ -102,7 +281,11 @@ public:
     }
     
     bool isConnected() {
-        return initialized_;
+        #if defined(ESP32_BUILD)
+            return initialized_;
+        #else
+            return initialized_ && output_connected_.load(std::memory_order_acquire);
+        #endif
     }
     
     std::string getConnectionStatus() {
@@ -121,21 +304,7 @@ public:
             midi_interface_.sendControlChange({cc_number, Channel(channel)}, value);
             // Serial.printf("Control-Surface CC: Ch%d CC%d Val%d\n", channel, cc_number, value);
         #else
-            // Desktop - Use RtMidi
-            if (!midi_out_) return;
-            
-            try {
-                std::vector<unsigned char> message;
-                message.push_back(0xB0 | (channel & 0x0F));  // Control Change + channel
-                message.push_back(cc_number & 0x7F);         // CC number
-                message.push_back(value & 0x7F);             // CC value
-                
-                midi_out_->sendMessage(&message);
-                std::cout << "Desktop MIDI CC: Ch" << (int)channel << " CC" << (int)cc_number << " Val" << (int)value << std::endl;
-                
-            } catch (RtMidiError& error) {
-                std::cerr << "MIDI send error: " << error.getMessage() << std::endl;
-            }
+            sendEvent(MidiEvent::controlChange(channel, cc_number, value));
         #endif
     }
     
@@ -146,19 +315,7 @@ public:
             midi_interface_.sendNoteOn({note, Channel(channel)}, velocity);
             // Serial.printf("Control-Surface Note On: Ch%d Note%d Vel%d\n", channel, note, velocity);
         #else
-            if (!midi_out_) return;
-            
-            try {
-                std::vector<unsigned char> message;
-                message.push_back(0x90 | (channel & 0x0F));  // Note On + channel
-                message.push_back(note & 0x7F);              // Note number
-                message.push_back(velocity & 0x7F);          // Velocity
-                
-                midi_out_->sendMessage(&message);
-                
-            } catch (RtMidiError& error) {
-                std::cerr << "MIDI send error: " << error.getMessage() << std::endl;
-            }
+            sendEvent(MidiEvent::noteOn(channel, note, velocity));
         #endif
     }
     
@@ -169,22 +326,105 @@ public:
             midi_interface_.sendNoteOff({note, Channel(channel)}, velocity);
             // Serial.printf("Control-Surface Note Off: Ch%d Note%d\n", channel, note);
         #else
-            if (!midi_out_) return;
+            sendEvent(MidiEvent::noteOff(channel, note, velocity));
+        #endif
+    }
+    
+    #if !defined(ESP32_BUILD)
+    // Stable port name ("Client:Port", without the client:port numbers) to
+    // connect to and to reconnect to when it reappears. Defaults to the first
+    // real port found by initialize().
+    void setPreferredPort(const std::string& stable_name) { preferred_port_name_ = stable_name; }
+    const std::string& getPreferredPort() const { return preferred_port_name_; }
+    
+    // Apply hot-plug changes reported by the port monitor: reopen the
+    // preferred port when it (re)appears, drop it when it goes away. Call from
+    // the thread that sends (RtMidiBackend::update() on the sender thread).
+    // Returns true if the connection state changed.
+    bool servicePortChanges() {
+        uint64_t changed_at = port_change_us_.exchange(0, std::memory_order_acq_rel);
+        if (changed_at == 0 || !initialized_ || !midi_out_ || preferred_port_name_.empty()) return false;
+        
+        bool lost = connected_port_lost_.exchange(false, std::memory_order_acq_rel);
+        try {
+            int index = findOutputPort(preferred_port_name_);
+            bool on_preferred = !connected_port_name_.empty() && !lost;
             
-            try {
-                std::vector<unsigned char> message;
-                message.push_back(0x80 | (channel & 0x0F));  // Note Off + channel
-                message.push_back(note & 0x7F);              // Note number
-                message.push_back(velocity & 0x7F);          // Velocity
-                
-                midi_out_->sendMessage(&message);
+            if (index >= 0 && !on_preferred) {
+                closeOutputPort();
+                openOutputPort(index);
+                if (midi_in_) {
+                    if (midi_in_->isPortOpen()) midi_in_->closePort();
+                    openInputPort();
+                }
                 
-            } catch (RtMidiError& error) {
-                std::cerr << "MIDI send error: " << error.getMessage() << std::endl;
+                uint64_t latency = MidiTime::nowUs() - changed_at;
+                reconnect_latency_us_.store(static_cast<uint32_t>(latency), std::memory_order_relaxed);
+                reconnect_count_.fetch_add(1, std::memory_order_relaxed);
+                LOG_INFO("Desktop MIDI", "Reconnected to %s in %lu us", connected_port_name_.c_str(),
+                         static_cast<unsigned long>(latency));
+                return true;
             }
-        #endif
+            
+            if (index < 0 && (on_preferred || lost)) {
+                closeOutputPort();
+                output_connected_.store(false, std::memory_order_release);
+                LOG_INFO("Desktop MIDI", "%s went away, waiting for it to return", preferred_port_name_.c_str());
+                return true;
+            }
+        } catch (RtMidiError& error) {
+            LOG_ERROR("Desktop MIDI", "Reconnect failed: %s", error.getMessage().c_str());
+            output_connected_.store(false, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+    
+    // Time from the ALSA announce to the port being usable again, last reconnect
+    uint32_t getReconnectLatencyUs() const { return reconnect_latency_us_.load(std::memory_order_relaxed); }
+    uint32_t getReconnectCount() const { return reconnect_count_.load(std::memory_order_relaxed); }
+    
+    // Pop one incoming message, if any. Single consumer only.
+    bool pollInput(TimedMidiEvent& event) {
+        return input_queue_.pop(event);
     }
     
+    uint32_t getInputOverflowCount() const {
+        return input_overflows_.load(std::memory_order_relaxed);
+    }
+    
+    // Send any pre-built message. The bytes live inside the MidiEvent on the
+    // caller's stack and go straight to RtMidiOut, so this never allocates.
+    void sendEvent(const MidiEvent& event) {
+        if (!initialized_ || !midi_out_ || event.length == 0) return;
+        
+        sendBytes(event.bytes, event.length);
+        LOG_TRACE("Desktop MIDI", "Ch%d 0x%02x 0x%02x 0x%02x",
+                  (int)event.channel(), event.status(), event.data1(), event.data2());
+    }
+    
+    // Send several messages as one byte stream: RtMidi's ALSA backend splits
+    // it back into sequencer events and drains the output once per call
+    // instead of once per message.
+    void sendEvents(const MidiEvent* events, size_t count) {
+        if (!initialized_ || !midi_out_) return;
+        
+        uint8_t buffer[SEND_BUFFER_BYTES];
+        size_t used = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const MidiEvent& event = events[i];
+            if (used + event.length > sizeof(buffer)) {
+                sendBytes(buffer, used);
+                used = 0;
+            }
+            for (uint8_t b = 0; b < event.length; ++b) {
+                buffer[used++] = event.bytes[b];
+            }
+        }
+        sendBytes(buffer, used);
+    }
+    #endif
+    
     void update() {
         if (!initialized_) return;
         
@@ -3,6 +3,21 @@
 #include <iostream>
 #include "components/app/SynthApp.h"
 #include "hardware/MidiHandler.h"
+#include "components/log/Log.h"
+
+#if !defined(ESP32_BUILD)
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "components/midi/UnifiedMidiManager.h"
+#include "components/midi/MidiEventLog.h"
+#include "components/profiling/FrameProfiler.h"
+#include "components/midi/ClockFollowerBenchmark.h"
+#include "components/midi/MidiEventBenchmark.h"
+#include "components/parameter/ParameterDispatchBenchmark.h"
+#include "components/parameter/ParameterStoreBenchmark.h"
+#include "components/parameter/SynthDefinitionBenchmark.h"
+#endif
 
 #if defined(ESP32_BUILD)
 #include "hardware/LGFX_ST7796S.h"
@@ -65,6 +80,7 @@ void midiTestLoop() {
 void setup() {
     Serial.begin(115200);
     delay(5000);  // Short delay for serial
+    Log::start();  // LOG_* output goes through a background task from here on
     
     std::cout << "=== ESP32 SynthApp Starting 2 ===" << std::endl;
     
@@ -91,8 +107,97 @@ void loop() {
     midi_handler.update();
 }
 #else
-int main() {
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --record FILE          Log all MIDI in/out to FILE\n"
+              << "  --replay FILE          Play FILE back as MIDI input\n"
+              << "  --replay-speed X       1 = recorded pace (default), N = N times faster, 0 = unpaced\n"
+              << "  --replay-all           Also replay recorded output messages\n"
+              << "  --export-smf LOG MID   Convert LOG to a Standard MIDI File and exit\n"
+              << "  --loopback             Add an in-process backend that feeds output back as input\n"
+              << "  --loopback-latency US  Loopback delivery latency (default 0)\n"
+              << "  --loopback-jitter US   Extra random delay of 0..US per message (default 0)\n"
+              << "  --null-sink            Add a backend that counts and discards output\n"
+              << "  --headless             Render into memory instead of an SDL window\n"
+              << "  --script FILE          Headless pointer script (see HeadlessDisplay.h)\n"
+              << "  --frames N             Headless: exit after N rendered frames\n"
+              << "  --profile-csv FILE     Profile frames; write the last ones to FILE on exit\n"
+              << "  --bench-midi N         Benchmark building/sending N MIDI messages and exit\n"
+              << "  --bench-clock          Replay synthetic jittered clocks through the clock follower and exit\n"
+              << "  --bench-clock-log LOG  Replay the incoming clock recorded in LOG through the follower and exit\n"
+              << "  --bench-dispatch N     Benchmark incoming CC/NRPN lookups with N parameters and exit\n"
+              << "  --bench-params N       Benchmark parameter snapshot/recall with N parameters and exit\n"
+              << "  --bench-synthdef N     Benchmark loading an N-parameter definition (JSON vs blob) and exit" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string record_path;
+    std::string replay_path;
+    double replay_speed = 1.0;
+    bool replay_all = false;
+    UnifiedMidiManager::TestBackendConfig test_backends;
+    bool headless = false;
+    HeadlessDisplay::Options headless_options;
+    std::string profile_csv_path;
+    
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--record") == 0 && has_value) {
+            record_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay") == 0 && has_value) {
+            replay_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay-speed") == 0 && has_value) {
+            replay_speed = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--replay-all") == 0) {
+            replay_all = true;
+        } else if (std::strcmp(argv[i], "--loopback") == 0) {
+            test_backends.loopback = true;
+        } else if (std::strcmp(argv[i], "--loopback-latency") == 0 && has_value) {
+            test_backends.loopback_latency_us = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--loopback-jitter") == 0 && has_value) {
+            test_backends.loopback_jitter_us = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--null-sink") == 0) {
+            test_backends.null_sink = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--script") == 0 && has_value) {
+            headless_options.script_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            headless_options.max_frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--profile-csv") == 0 && has_value) {
+            profile_csv_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--bench-midi") == 0 && has_value) {
+            runMidiEventBenchmark(std::strtoul(argv[++i], nullptr, 10));
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-clock") == 0) {
+            runClockFollowerBenchmark();
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-clock-log") == 0 && has_value) {
+            runClockFollowerBenchmark(argv[++i]);
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-dispatch") == 0 && has_value) {
+            runParameterDispatchBenchmark(std::strtoul(argv[++i], nullptr, 10));
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-params") == 0 && has_value) {
+            runParameterStoreBenchmark(std::strtoul(argv[++i], nullptr, 10));
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-synthdef") == 0 && has_value) {
+            runSynthDefinitionBenchmark(std::strtoul(argv[++i], nullptr, 10));
+            return 0;
+        } else if (std::strcmp(argv[i], "--export-smf") == 0 && i + 2 < argc) {
+            MidiEventLogReader reader;
+            bool ok = reader.open(argv[i + 1]) && reader.exportSmf(argv[i + 2]);
+            std::cout << (ok ? "✅ Exported " : "❌ Export failed: ") << argv[i + 2] << std::endl;
+            return ok ? 0 : 1;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
     std::cout << "=== Desktop SynthApp Starting ===" << std::endl;
+    Log::start();  // LOG_* output goes through a background thread from here on
+    UnifiedMidiManager::setTestBackends(test_backends);
     
     // Initialize MIDI test with debug info
     std::cout << "🔧 Initializing MIDI handler..." << std::endl;
@@ -106,9 +211,26 @@ int main() {
         std::cout << "   sudo apt-get install libasound2-dev" << std::endl;
     }
     
-    app.setup();
+    if (headless) {
+        app.setHeadless(headless_options);
+    }
+    if (!app.setup()) {
+        std::cout << "❌ SynthApp setup failed" << std::endl;
+        Log::stop();
+        return 1;
+    }
+    
+    if (!record_path.empty()) {
+        UnifiedMidiManager::getInstance().startRecording(record_path);
+    }
+    if (!replay_path.empty()) {
+        UnifiedMidiManager::getInstance().startReplay(replay_path, replay_speed, replay_all);
+    }
+    if (!profile_csv_path.empty()) {
+        FrameProfiler::getInstance().setEnabled(true);
+    }
     
-    while (true) {
+    while (!app.isFinished()) {
         app.loop();
         
         // Run MIDI test
@@ -118,6 +240,12 @@ int main() {
         midi_handler.update();
     }
     
+    app.shutdown();
+    if (!profile_csv_path.empty()) {
+        FrameProfiler::getInstance().logSummary();
+        FrameProfiler::getInstance().exportCsv(profile_csv_path);
+    }
+    Log::stop();  // Flushes the queue; the writer thread must be joined before exit
     return 0;
 }
 #endif
\ No newline at end of file
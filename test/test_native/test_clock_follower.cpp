@@ -0,0 +1,97 @@
+#include <unity.h>
+#include "components/midi/ClockFollower.h"
+
+namespace {
+
+constexpr uint64_t START_US = 1000000;
+
+double periodUs(double bpm) {
+    return 60000000.0 / (bpm * 24);
+}
+
+// Feeds `count` pulses at bpm from *time_us, advancing it; every pulse in
+// drop_every (0 = none) is left out
+void feed(ClockFollower& follower, double& time_us, double bpm, int count, int drop_every = 0) {
+    for (int i = 0; i < count; ++i) {
+        if (!drop_every || i % drop_every != drop_every - 1) {
+            follower.onTick(static_cast<uint64_t>(time_us));
+        }
+        time_us += periodUs(bpm);
+    }
+}
+
+void test_clock_follower_locks_to_steady_clock() {
+    ClockFollower follower;
+    double time_us = START_US;
+    TEST_ASSERT_FALSE(follower.hasEstimate());
+
+    feed(follower, time_us, 120.0, 96);
+    TEST_ASSERT_TRUE(follower.isLocked());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 120.0f, follower.getBPM());
+    // The next pulse is predicted where it will arrive
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, time_us, static_cast<double>(follower.getPredictedNextTickUs()));
+}
+
+void test_clock_follower_absorbs_dropped_pulses() {
+    ClockFollower follower;
+    double time_us = START_US;
+    feed(follower, time_us, 120.0, 96);
+
+    feed(follower, time_us, 120.0, 240, 24);   // One missing pulse per beat
+    TEST_ASSERT_TRUE(follower.isLocked());
+    TEST_ASSERT_EQUAL_UINT32(0, follower.getRelockCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 120.0f, follower.getBPM());
+}
+
+void test_clock_follower_ignores_single_outlier() {
+    ClockFollower follower;
+    double time_us = START_US;
+    feed(follower, time_us, 120.0, 96);
+
+    // One pulse 0.6 of a period late
+    follower.onTick(static_cast<uint64_t>(time_us + periodUs(120.0) * 0.6));
+    time_us += periodUs(120.0);
+    feed(follower, time_us, 120.0, 24);
+
+    // The late pulse is ignored, so the on-time one after it reads as a
+    // dropped pulse; both count as outliers
+    TEST_ASSERT_EQUAL_UINT32(2, follower.getOutlierCount());
+    TEST_ASSERT_EQUAL_UINT32(0, follower.getRelockCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 120.0f, follower.getBPM());
+}
+
+void test_clock_follower_follows_tempo_step_at_narrow_bandwidth() {
+    // A narrow loop slips a cycle every few pulses after a large step
+    // instead of producing outliers in a row; it must still re-acquire
+    ClockFollower follower;
+    follower.setBandwidth(0.1f);
+    double time_us = START_US;
+    feed(follower, time_us, 120.0, 24 * 20);
+    TEST_ASSERT_TRUE(follower.isLocked());
+
+    feed(follower, time_us, 140.0, 24 * 10);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, follower.getRelockCount());
+    TEST_ASSERT_TRUE(follower.isLocked());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 140.0f, follower.getBPM());
+}
+
+void test_clock_follower_reset_forgets_estimate() {
+    ClockFollower follower;
+    double time_us = START_US;
+    feed(follower, time_us, 120.0, 48);
+
+    follower.reset();
+    TEST_ASSERT_FALSE(follower.hasEstimate());
+    TEST_ASSERT_FALSE(follower.isLocked());
+    TEST_ASSERT_EQUAL_UINT32(0, follower.getTickCount());
+}
+
+}  // namespace
+
+void run_clock_follower_tests() {
+    RUN_TEST(test_clock_follower_locks_to_steady_clock);
+    RUN_TEST(test_clock_follower_absorbs_dropped_pulses);
+    RUN_TEST(test_clock_follower_ignores_single_outlier);
+    RUN_TEST(test_clock_follower_follows_tempo_step_at_narrow_bandwidth);
+    RUN_TEST(test_clock_follower_reset_forgets_estimate);
+}
@@ -0,0 +1,100 @@
+#include <unity.h>
+#include "components/json/JsonSaxParser.h"
+#include <string>
+
+namespace {
+
+// Writes every event as one compact token, so a test compares a string
+struct RecordingHandler : JsonSaxHandler {
+    std::string events;
+
+    void onObjectStart() override { events += "{"; }
+    void onObjectEnd() override { events += "}"; }
+    void onArrayStart() override { events += "["; }
+    void onArrayEnd() override { events += "]"; }
+    void onKey(std::string_view key) override { events += "k:" + std::string(key) + " "; }
+    void onString(std::string_view value) override { events += "s:" + std::string(value) + " "; }
+    void onNumber(double value) override { events += "n:" + std::to_string(value) + " "; }
+    void onBool(bool value) override { events += value ? "true " : "false "; }
+    void onNull() override { events += "null "; }
+};
+
+const char* const DOCUMENT =
+    "{\n"
+    "  \"name\": \"Filter \\\"1\\\"\",\n"
+    "  \"cc\": 74,\n"
+    "  \"range\": [-1.5, 2e3, 0],\n"
+    "  \"flags\": {\"bipolar\": true, \"hidden\": false, \"alias\": null}\n"
+    "}\n";
+
+const char* const EXPECTED =
+    "{k:name s:Filter \"1\" k:cc n:74.000000 k:range [n:-1.500000 n:2000.000000 n:0.000000 ]"
+    "k:flags {k:bipolar true k:hidden false k:alias null }}";
+
+void test_parser_reports_events_in_order() {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    TEST_ASSERT_TRUE(parser.parse(DOCUMENT));
+    TEST_ASSERT_EQUAL_STRING(EXPECTED, handler.events.c_str());
+}
+
+void test_parser_handles_tokens_split_across_chunks() {
+    // One byte per feed() splits every string, number and literal
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    for (const char* c = DOCUMENT; *c; ++c) {
+        TEST_ASSERT_TRUE(parser.feed(c, 1));
+    }
+    TEST_ASSERT_TRUE(parser.finish());
+    TEST_ASSERT_EQUAL_STRING(EXPECTED, handler.events.c_str());
+}
+
+void test_parser_decodes_unicode_escapes_as_utf8() {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    // U+00E9 and U+1F3B9 (a surrogate pair)
+    TEST_ASSERT_TRUE(parser.parse("[\"\\u00e9\\ud83c\\udfb9\"]"));
+    TEST_ASSERT_EQUAL_STRING("[s:\xC3\xA9\xF0\x9F\x8E\xB9 ]", handler.events.c_str());
+}
+
+void test_parser_reports_syntax_error_line() {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    TEST_ASSERT_FALSE(parser.parse("{\n  \"a\": 1,\n  \"b\" 2\n}"));
+    TEST_ASSERT_NOT_NULL(parser.getError());
+    TEST_ASSERT_EQUAL_size_t(3, parser.getLine());
+}
+
+void test_parser_rejects_incomplete_and_trailing_input() {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    TEST_ASSERT_TRUE(parser.feed("{\"a\": [1, 2", 11));
+    TEST_ASSERT_FALSE(parser.finish());
+
+    parser.reset();
+    TEST_ASSERT_FALSE(parser.parse("{} {}"));
+    parser.reset();
+    TEST_ASSERT_FALSE(parser.parse("{\"a\": 1,}"));
+}
+
+void test_parser_limits_nesting_depth() {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    std::string deep = std::string(JsonSaxParser::MAX_DEPTH, '[') + std::string(JsonSaxParser::MAX_DEPTH, ']');
+    TEST_ASSERT_TRUE(parser.parse(deep));
+
+    parser.reset();
+    std::string too_deep = "[" + deep + "]";
+    TEST_ASSERT_FALSE(parser.parse(too_deep));
+}
+
+}  // namespace
+
+void run_json_sax_parser_tests() {
+    RUN_TEST(test_parser_reports_events_in_order);
+    RUN_TEST(test_parser_handles_tokens_split_across_chunks);
+    RUN_TEST(test_parser_decodes_unicode_escapes_as_utf8);
+    RUN_TEST(test_parser_reports_syntax_error_line);
+    RUN_TEST(test_parser_rejects_incomplete_and_trailing_input);
+    RUN_TEST(test_parser_limits_nesting_depth);
+}
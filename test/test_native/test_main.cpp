@@ -0,0 +1,36 @@
+// Native unit tests: pio test -e native_test
+//
+// One test_<unit>.cpp per unit, each exposing a run_<unit>_tests() that
+// RUN_TESTs its cases.
+#include <unity.h>
+
+void run_spsc_ring_tests();
+void run_midi_output_limiter_tests();
+void run_midi_serial_encoder_tests();
+void run_clock_follower_tests();
+void run_midi_event_scheduler_tests();
+void run_midi_clock_thread_tests();
+void run_midi_event_log_tests();
+void run_parameter_store_tests();
+void run_parameter_midi_codec_tests();
+void run_json_sax_parser_tests();
+void run_synth_definition_tests();
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    UNITY_BEGIN();
+    run_spsc_ring_tests();
+    run_midi_output_limiter_tests();
+    run_midi_serial_encoder_tests();
+    run_clock_follower_tests();
+    run_midi_event_scheduler_tests();
+    run_midi_clock_thread_tests();
+    run_midi_event_log_tests();
+    run_parameter_store_tests();
+    run_parameter_midi_codec_tests();
+    run_json_sax_parser_tests();
+    run_synth_definition_tests();
+    return UNITY_END();
+}
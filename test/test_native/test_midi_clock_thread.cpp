@@ -0,0 +1,52 @@
+#include <unity.h>
+#include "components/midi/MidiClockThread.h"
+#include "components/midi/MidiEventScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// The clock thread releases asynchronously; give it up to a second
+bool waitForReleased(const MidiEventScheduler& scheduler, uint32_t count) {
+    for (int i = 0; i < 1000 && scheduler.getReleasedCount() < count; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return scheduler.getReleasedCount() >= count;
+}
+
+void test_clock_thread_releases_tick_events_on_external_ticks() {
+    MidiEventScheduler scheduler;
+    std::atomic<uint8_t> last_note{0};
+    scheduler.setOutputCallback([&](const MidiEvent& event) { last_note.store(event.data1()); });
+
+    MidiClockThread clock;
+    clock.setScheduler(&scheduler);
+    clock.start();
+
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 60, 100), 2);
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 62, 100), 3);
+
+    // Never ticks on its own: only the external pulses move the position
+    TEST_ASSERT_TRUE(clock.externalTick(1));
+    TEST_ASSERT_TRUE(clock.externalTick(2));
+    TEST_ASSERT_TRUE(waitForReleased(scheduler, 1));
+    TEST_ASSERT_EQUAL_UINT8(60, last_note.load());
+    TEST_ASSERT_EQUAL_UINT32(2, clock.getTickCount());
+
+    // A new Start begins again at 1
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 64, 100), 1);
+    TEST_ASSERT_TRUE(clock.externalTick(1));
+    TEST_ASSERT_TRUE(waitForReleased(scheduler, 2));
+    TEST_ASSERT_EQUAL_UINT8(64, last_note.load());
+    TEST_ASSERT_EQUAL_UINT32(1, clock.getTickCount());
+
+    clock.stop();
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getReleasedCount());
+}
+
+} // namespace
+
+void run_midi_clock_thread_tests() {
+    RUN_TEST(test_clock_thread_releases_tick_events_on_external_ticks);
+}
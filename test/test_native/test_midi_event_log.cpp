@@ -0,0 +1,85 @@
+#include <unity.h>
+#include "components/midi/MidiEventLog.h"
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::string tempPath() {
+    return "/tmp/midi_event_log_test_" + std::to_string(getpid()) + ".log";
+}
+
+void test_event_log_pack_round_trips() {
+    MidiEvent event = MidiEvent::controlChange(3, 74, 100);
+    uint64_t time_us = (1ULL << 40) - 1;   // Largest time that fits
+
+    MidiEventLog::Record record = MidiEventLog::unpack(MidiEventLog::pack(time_us, MidiEventLog::Direction::OUT, event));
+    TEST_ASSERT_EQUAL_UINT64(time_us, record.time_us);
+    TEST_ASSERT_TRUE(record.direction == MidiEventLog::Direction::OUT);
+    TEST_ASSERT_EQUAL_HEX8(0xB3, record.event.status());
+    TEST_ASSERT_EQUAL_UINT8(74, record.event.data1());
+    TEST_ASSERT_EQUAL_UINT8(100, record.event.data2());
+    TEST_ASSERT_EQUAL_UINT8(3, record.event.length);
+
+    record = MidiEventLog::unpack(MidiEventLog::pack(5, MidiEventLog::Direction::IN, MidiEvent::realTime(0xF8)));
+    TEST_ASSERT_TRUE(record.direction == MidiEventLog::Direction::IN);
+    TEST_ASSERT_EQUAL_HEX8(0xF8, record.event.status());
+    TEST_ASSERT_EQUAL_UINT8(1, record.event.length);
+}
+
+void test_event_log_reads_back_what_was_written() {
+    std::string path = tempPath();
+    MidiEventLog log;
+    TEST_ASSERT_TRUE(log.open(path, 64));
+
+    MidiEventLogReader reader;
+    TEST_ASSERT_TRUE(reader.open(path));   // While still recording
+    uint64_t start_us = reader.getStartUs();
+    reader.close();
+
+    log.append(MidiEventLog::Direction::IN, MidiEvent::noteOn(0, 60, 100), start_us + 10);
+    log.append(MidiEventLog::Direction::OUT, MidiEvent::controlChange(1, 7, 90), start_us + 20);
+    TEST_ASSERT_EQUAL_UINT64(2, log.getRecordCount());
+    log.close();
+
+    TEST_ASSERT_TRUE(reader.open(path));
+    TEST_ASSERT_EQUAL_size_t(2, reader.size());
+    MidiEventLog::Record first = reader.get(0);
+    MidiEventLog::Record second = reader.get(1);
+    TEST_ASSERT_EQUAL_UINT64(10, first.time_us);
+    TEST_ASSERT_TRUE(first.direction == MidiEventLog::Direction::IN);
+    TEST_ASSERT_EQUAL_UINT8(60, first.event.data1());
+    TEST_ASSERT_EQUAL_UINT64(20, second.time_us);
+    TEST_ASSERT_TRUE(second.direction == MidiEventLog::Direction::OUT);
+    TEST_ASSERT_EQUAL_HEX8(0xB1, second.event.status());
+    reader.close();
+
+    std::remove(path.c_str());
+}
+
+void test_event_log_counts_drops_past_capacity() {
+    std::string path = tempPath();
+    MidiEventLog log;
+    TEST_ASSERT_TRUE(log.open(path, 4));
+    for (int i = 0; i < 10; ++i) {
+        log.append(MidiEventLog::Direction::OUT, MidiEvent::realTime(0xF8), 1000 + i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(6, log.getDroppedCount());
+    log.close();
+
+    MidiEventLogReader reader;
+    TEST_ASSERT_TRUE(reader.open(path));
+    TEST_ASSERT_EQUAL_size_t(4, reader.size());
+    reader.close();
+
+    std::remove(path.c_str());
+}
+
+}  // namespace
+
+void run_midi_event_log_tests() {
+    RUN_TEST(test_event_log_pack_round_trips);
+    RUN_TEST(test_event_log_reads_back_what_was_written);
+    RUN_TEST(test_event_log_counts_drops_past_capacity);
+}
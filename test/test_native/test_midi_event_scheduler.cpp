@@ -0,0 +1,117 @@
+#include <unity.h>
+#include "components/midi/MidiEventScheduler.h"
+#include <vector>
+
+namespace {
+
+struct Capture {
+    std::vector<MidiEvent> events;
+
+    void attach(MidiEventScheduler& scheduler) {
+        scheduler.setOutputCallback([this](const MidiEvent& event) { events.push_back(event); });
+    }
+};
+
+void test_scheduler_releases_timed_events_at_deadline() {
+    MidiEventScheduler scheduler;
+    Capture capture;
+    capture.attach(scheduler);
+
+    scheduler.scheduleAtUs(MidiEvent::noteOn(0, 62, 100), 2000);
+    scheduler.scheduleAtUs(MidiEvent::noteOn(0, 60, 100), 1000);
+    scheduler.collect();
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, scheduler.nextTimedDeadlineNs());
+
+    scheduler.releaseDue(999999);
+    TEST_ASSERT_EQUAL_size_t(0, capture.events.size());
+
+    scheduler.releaseDue(1000000);
+    TEST_ASSERT_EQUAL_size_t(1, capture.events.size());
+    TEST_ASSERT_EQUAL_UINT8(60, capture.events[0].data1());
+
+    scheduler.releaseDue(5000000);
+    TEST_ASSERT_EQUAL_size_t(2, capture.events.size());
+    TEST_ASSERT_EQUAL_UINT8(62, capture.events[1].data1());
+    TEST_ASSERT_EQUAL_UINT64(MidiEventScheduler::NO_DEADLINE, scheduler.nextTimedDeadlineNs());
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getReleasedCount());
+}
+
+void test_scheduler_keeps_submission_order_for_equal_deadlines() {
+    MidiEventScheduler scheduler;
+    Capture capture;
+    capture.attach(scheduler);
+
+    for (uint8_t note = 0; note < 50; ++note) {
+        scheduler.scheduleAtUs(MidiEvent::noteOn(0, note, 100), 1000);
+    }
+    scheduler.collect();
+    scheduler.releaseDue(1000000);
+
+    TEST_ASSERT_EQUAL_size_t(50, capture.events.size());
+    for (uint8_t note = 0; note < 50; ++note) {
+        TEST_ASSERT_EQUAL_UINT8(note, capture.events[note].data1());
+    }
+}
+
+void test_scheduler_releases_tick_events_up_to_tick() {
+    MidiEventScheduler scheduler;
+    Capture capture;
+    capture.attach(scheduler);
+
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 64, 100), 48);
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 60, 100), 0);
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 62, 100), 24);
+    scheduler.collect();
+
+    scheduler.releaseTick(0);
+    TEST_ASSERT_EQUAL_size_t(1, capture.events.size());
+    scheduler.releaseTick(30);
+    TEST_ASSERT_EQUAL_size_t(2, capture.events.size());
+    TEST_ASSERT_EQUAL_UINT8(62, capture.events[1].data1());
+    // Timed release leaves tick events alone
+    scheduler.releaseDue(UINT64_MAX - 1);
+    TEST_ASSERT_EQUAL_size_t(2, capture.events.size());
+}
+
+void test_scheduler_clear_requests_apply_on_collect() {
+    MidiEventScheduler scheduler;
+    Capture capture;
+    capture.attach(scheduler);
+
+    scheduler.scheduleAtTick(MidiEvent::noteOn(0, 60, 100), 10);
+    scheduler.scheduleAtUs(MidiEvent::noteOn(0, 61, 100), 10);
+    scheduler.collect();
+
+    scheduler.clearTickEvents();
+    scheduler.collect();
+    scheduler.releaseTick(100);
+    scheduler.releaseDue(100000);
+    TEST_ASSERT_EQUAL_size_t(1, capture.events.size());
+    TEST_ASSERT_EQUAL_UINT8(61, capture.events[0].data1());
+
+    scheduler.scheduleAtUs(MidiEvent::noteOn(0, 62, 100), 10);
+    scheduler.collect();
+    scheduler.clearAll();
+    scheduler.collect();
+    TEST_ASSERT_EQUAL_UINT64(MidiEventScheduler::NO_DEADLINE, scheduler.nextTimedDeadlineNs());
+}
+
+void test_scheduler_counts_submissions_over_capacity() {
+    MidiEventScheduler scheduler;
+    size_t accepted = 0;
+    for (size_t i = 0; i < MidiEventScheduler::SUBMIT_CAPACITY + 10; ++i) {
+        accepted += scheduler.scheduleAtUs(MidiEvent::noteOn(0, 60, 100), 1000);
+    }
+    TEST_ASSERT_EQUAL_size_t(MidiEventScheduler::SUBMIT_CAPACITY, accepted);
+    TEST_ASSERT_EQUAL_UINT32(10, scheduler.getDroppedCount());
+}
+
+}  // namespace
+
+void run_midi_event_scheduler_tests() {
+    RUN_TEST(test_scheduler_releases_timed_events_at_deadline);
+    RUN_TEST(test_scheduler_keeps_submission_order_for_equal_deadlines);
+    RUN_TEST(test_scheduler_releases_tick_events_up_to_tick);
+    RUN_TEST(test_scheduler_clear_requests_apply_on_collect);
+    RUN_TEST(test_scheduler_counts_submissions_over_capacity);
+}
@@ -0,0 +1,171 @@
+#include <unity.h>
+#include "components/midi/MidiOutputLimiter.h"
+
+namespace {
+
+constexpr uint64_t START_NS = 1000000000ULL;
+constexpr uint64_t MS = 1000000ULL;
+
+// 300 bytes/s: the bucket holds a single CC (3 bytes), refilled every 10 ms
+constexpr uint32_t ONE_CC_BUDGET = 300;
+
+void test_limiter_unlimited_admits_everything() {
+    MidiOutputLimiter limiter;
+    for (int i = 0; i < 1000; ++i) {
+        TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 74, i & 0x7F), START_NS));
+    }
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+}
+
+void test_limiter_coalesces_to_latest_value() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(3125);   // DIN: bucket of ~31 bytes
+
+    int admitted = 0;
+    for (uint8_t value = 0; value < 100; ++value) {
+        admitted += limiter.admit(MidiEvent::controlChange(0, 74, value), START_NS);
+    }
+    TEST_ASSERT_GREATER_THAN(0, admitted);
+    TEST_ASSERT_LESS_THAN(100, admitted);
+    TEST_ASSERT_TRUE(limiter.hasDeferred());
+    TEST_ASSERT_EQUAL_UINT32(100 - admitted - 1, limiter.getCoalescedCount());
+
+    // Only the final value comes out, once there is budget again
+    MidiEvent event;
+    TEST_ASSERT_TRUE(limiter.nextDeferred(event, START_NS + 10 * MS));
+    TEST_ASSERT_EQUAL_HEX8(0xB0, event.status());
+    TEST_ASSERT_EQUAL_UINT8(74, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(99, event.data2());
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+}
+
+void test_limiter_never_parks_notes_or_nrpn_sequences() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS));
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 74, 2), START_NS));
+
+    // Over budget, but these only work in order
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 99, 1), START_NS));
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 98, 2), START_NS));
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 6, 64), START_NS));
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::noteOn(0, 60, 100), START_NS));
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::realTime(0xF8), START_NS));
+}
+
+void test_limiter_sends_lsb_right_behind_its_sent_msb() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 1, 10), START_NS));
+    // The bucket is empty now, but the pair stays together
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 33, 20), START_NS));
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+}
+
+void test_limiter_limits_cc_32_to_63_without_their_msb() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS));
+    // CC 44 does not follow CC 12: it is an ordinary CC and waits
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 44, 1), START_NS));
+    // Nor does an LSB with another CC between it and its MSB
+    limiter.clear();
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 1, 1), START_NS + 10 * MS));
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS + 10 * MS));
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 33, 1), START_NS + 10 * MS));
+}
+
+void test_limiter_lsb_follows_parked_msb_out() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+
+    TEST_ASSERT_TRUE(limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS));
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 2, 5), START_NS));
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 34, 6), START_NS));
+
+    MidiEvent event;
+    TEST_ASSERT_TRUE(limiter.nextDeferred(event, START_NS + 10 * MS));
+    TEST_ASSERT_EQUAL_UINT8(2, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(5, event.data2());
+    TEST_ASSERT_TRUE(limiter.nextDeferred(event, START_NS + 20 * MS));
+    TEST_ASSERT_EQUAL_UINT8(34, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(6, event.data2());
+}
+
+void test_limiter_note_takes_parked_ccs_on_its_channel_first() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+    limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS);
+    limiter.admit(MidiEvent::controlChange(0, 74, 2), START_NS);
+    limiter.admit(MidiEvent::controlChange(1, 71, 3), START_NS);
+    limiter.admit(MidiEvent::controlChange(0, 71, 4), START_NS);
+    TEST_ASSERT_EQUAL_UINT16(3, limiter.getDeferredCount());
+
+    // Over budget, but the note must not play with the stale values
+    MidiEvent event;
+    MidiEvent note = MidiEvent::noteOn(0, 60, 100);
+    TEST_ASSERT_TRUE(limiter.takeDeferredBefore(note, event));
+    TEST_ASSERT_EQUAL_UINT8(74, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(2, event.data2());
+    TEST_ASSERT_TRUE(limiter.takeDeferredBefore(note, event));
+    TEST_ASSERT_EQUAL_UINT8(71, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(4, event.data2());
+    TEST_ASSERT_FALSE(limiter.takeDeferredBefore(note, event));
+
+    // Other channels and CCs wait for the budget (now overdrawn) as before
+    TEST_ASSERT_FALSE(limiter.takeDeferredBefore(MidiEvent::controlChange(1, 10, 0), event));
+    TEST_ASSERT_FALSE(limiter.nextDeferred(event, START_NS + 10 * MS));
+    TEST_ASSERT_TRUE(limiter.nextDeferred(event, START_NS + 100 * MS));
+    TEST_ASSERT_EQUAL_UINT8(1, event.channel());
+    TEST_ASSERT_EQUAL_UINT8(71, event.data1());
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+}
+
+void test_limiter_note_takes_parked_msb_before_its_lsb() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+    limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS);
+    limiter.admit(MidiEvent::controlChange(0, 2, 5), START_NS);
+    limiter.admit(MidiEvent::controlChange(0, 34, 6), START_NS);
+    MidiEvent event;
+    limiter.nextDeferred(event, START_NS + 10 * MS);
+    // The MSB is parked again, now behind its LSB
+    TEST_ASSERT_FALSE(limiter.admit(MidiEvent::controlChange(0, 2, 7), START_NS + 10 * MS));
+
+    MidiEvent bend = MidiEvent::pitchBend(0, 8192);
+    TEST_ASSERT_TRUE(limiter.takeDeferredBefore(bend, event));
+    TEST_ASSERT_EQUAL_UINT8(2, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(7, event.data2());
+    TEST_ASSERT_TRUE(limiter.takeDeferredBefore(bend, event));
+    TEST_ASSERT_EQUAL_UINT8(34, event.data1());
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+}
+
+void test_limiter_clear_drops_parked() {
+    MidiOutputLimiter limiter;
+    limiter.setBudget(ONE_CC_BUDGET);
+    limiter.admit(MidiEvent::controlChange(0, 74, 1), START_NS);
+    limiter.admit(MidiEvent::controlChange(0, 74, 2), START_NS);
+    TEST_ASSERT_TRUE(limiter.hasDeferred());
+
+    limiter.clear();
+    MidiEvent event;
+    TEST_ASSERT_FALSE(limiter.hasDeferred());
+    TEST_ASSERT_FALSE(limiter.nextDeferred(event, START_NS + 100 * MS));
+}
+
+}  // namespace
+
+void run_midi_output_limiter_tests() {
+    RUN_TEST(test_limiter_unlimited_admits_everything);
+    RUN_TEST(test_limiter_coalesces_to_latest_value);
+    RUN_TEST(test_limiter_never_parks_notes_or_nrpn_sequences);
+    RUN_TEST(test_limiter_sends_lsb_right_behind_its_sent_msb);
+    RUN_TEST(test_limiter_limits_cc_32_to_63_without_their_msb);
+    RUN_TEST(test_limiter_lsb_follows_parked_msb_out);
+    RUN_TEST(test_limiter_note_takes_parked_ccs_on_its_channel_first);
+    RUN_TEST(test_limiter_note_takes_parked_msb_before_its_lsb);
+    RUN_TEST(test_limiter_clear_drops_parked);
+}
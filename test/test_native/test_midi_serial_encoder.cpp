@@ -0,0 +1,85 @@
+#include <unity.h>
+#include "components/midi/MidiSerialEncoder.h"
+
+namespace {
+
+constexpr uint64_t START_NS = 1000000000ULL;
+constexpr uint64_t MS = 1000000ULL;
+
+void test_serial_encoder_applies_running_status() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(0xB0, 74, 10, START_NS, out));
+    TEST_ASSERT_EQUAL_HEX8(0xB0, out[0]);
+
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0xB0, 74, 11, START_NS + MS, out));
+    TEST_ASSERT_EQUAL_UINT8(74, out[0]);
+    TEST_ASSERT_EQUAL_UINT8(11, out[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, encoder.getStatusBytesSaved());
+
+    // Another channel needs its status byte
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(0xB1, 74, 11, START_NS + 2 * MS, out));
+}
+
+void test_serial_encoder_refreshes_status_periodically() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    encoder.encode(0xB0, 74, 10, START_NS, out);
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0xB0, 74, 11, START_NS + 100 * MS, out));
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(0xB0, 74, 12, START_NS + 250 * MS, out));
+}
+
+void test_serial_encoder_real_time_keeps_running_status() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    encoder.encode(0x90, 60, 100, START_NS, out);
+    TEST_ASSERT_EQUAL_size_t(1, encoder.encode(0xF8, 0, 0, START_NS + MS, out));
+    TEST_ASSERT_EQUAL_HEX8(0xF8, out[0]);
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0x90, 62, 100, START_NS + 2 * MS, out));
+}
+
+void test_serial_encoder_system_common_cancels_running_status() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    encoder.encode(0x90, 60, 100, START_NS, out);
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0xF3, 5, 0, START_NS + MS, out));   // Song Select
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(0x90, 62, 100, START_NS + 2 * MS, out));
+}
+
+void test_serial_encoder_short_messages_and_reset() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0xC2, 5, 0, START_NS, out));   // Program Change
+    TEST_ASSERT_EQUAL_size_t(1, encoder.encode(0xC2, 6, 0, START_NS + MS, out));
+
+    encoder.reset();
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(0xC2, 7, 0, START_NS + 2 * MS, out));
+}
+
+void test_serial_encoder_meters_bytes_per_second() {
+    MidiSerialEncoder encoder;
+    uint8_t out[MidiSerialEncoder::MAX_MESSAGE_BYTES];
+
+    // 100 Note Ons over one second, all on one status: 3 + 99 * 2 bytes
+    for (int i = 0; i < 100; ++i) {
+        encoder.encode(0x90, 60, 100, START_NS + i * 10 * MS, out);
+    }
+    encoder.tick(START_NS + 1000 * MS);
+    TEST_ASSERT_EQUAL_UINT32(3 + 99 * 2 + 4 * 1, encoder.getBytesPerSecond());
+}
+
+}  // namespace
+
+void run_midi_serial_encoder_tests() {
+    RUN_TEST(test_serial_encoder_applies_running_status);
+    RUN_TEST(test_serial_encoder_refreshes_status_periodically);
+    RUN_TEST(test_serial_encoder_real_time_keeps_running_status);
+    RUN_TEST(test_serial_encoder_system_common_cancels_running_status);
+    RUN_TEST(test_serial_encoder_short_messages_and_reset);
+    RUN_TEST(test_serial_encoder_meters_bytes_per_second);
+}
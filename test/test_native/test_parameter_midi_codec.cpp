@@ -0,0 +1,188 @@
+#include <unity.h>
+#include "components/parameter/ParameterBinder.h"
+#include "components/parameter/ParameterMidiCodec.h"
+#include "components/parameter/SynthDefinitionReader.h"
+
+namespace {
+
+constexpr uint64_t START_NS = 1000000000ULL;
+constexpr uint64_t MS = 1000000ULL;
+
+ParameterStore::Definition makeDefinition(uint8_t cc, uint16_t nrpn = Parameter::NO_NRPN,
+                                          bool high_resolution = false) {
+    ParameterStore::Definition definition;
+    definition.name = "Codec Test";
+    definition.short_name = "Codec";
+    definition.cc_number = cc;
+    definition.nrpn_number = nrpn;
+    definition.high_resolution = high_resolution;
+    definition.max_value = high_resolution ? Parameter::MAX_VALUE_14BIT : Parameter::MAX_VALUE_7BIT;
+    return definition;
+}
+
+void assertCC(const MidiEvent& event, uint8_t channel, uint8_t cc, uint8_t value) {
+    TEST_ASSERT_EQUAL_HEX8(0xB0 | channel, event.status());
+    TEST_ASSERT_EQUAL_UINT8(cc, event.data1());
+    TEST_ASSERT_EQUAL_UINT8(value, event.data2());
+}
+
+// Cutoff: CC 74; Fine: 14-bit CC 1/33; Wave: NRPN 300; Mix: 14-bit NRPN 301
+const char* const CODEC_SYNTH = R"({
+  "name": "Codec Synth",
+  "categories": {
+    "Filters": {
+      "parameters": {
+        "Codec_Cutoff": {"cc": 74},
+        "Codec_Fine": {"cc": 1, "max": 16383, "high_resolution": true},
+        "Codec_Wave": {"nrpn": 300},
+        "Codec_Mix": {"nrpn": 301, "max": 16383, "high_resolution": true}
+      }
+    }
+  }
+})";
+
+void test_encoder_sends_7_bit_cc() {
+    Parameter param(makeDefinition(74));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    TEST_ASSERT_EQUAL_size_t(1, encoder.encode(param, 2, 100, START_NS, out));
+    assertCC(out[0], 2, 74, 100);
+}
+
+void test_encoder_sends_14_bit_cc_as_msb_then_lsb() {
+    Parameter param(makeDefinition(1, Parameter::NO_NRPN, true));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    TEST_ASSERT_EQUAL_size_t(2, encoder.encode(param, 0, (64 << 7) | 5, START_NS, out));
+    assertCC(out[0], 0, 1, 64);
+    assertCC(out[1], 0, 33, 5);
+
+    // No LSB controller above CC 31: top 7 bits only
+    Parameter high(makeDefinition(40, Parameter::NO_NRPN, true));
+    TEST_ASSERT_EQUAL_size_t(1, encoder.encode(high, 0, (64 << 7) | 5, START_NS, out));
+    assertCC(out[0], 0, 40, 64);
+}
+
+void test_encoder_selects_nrpn_once_and_refreshes() {
+    Parameter param(makeDefinition(SynthDefinitionReader::NO_CC, 300));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(param, 0, 10, START_NS, out));
+    assertCC(out[0], 0, 99, 300 >> 7);
+    assertCC(out[1], 0, 98, 300 & 0x7F);
+    assertCC(out[2], 0, 6, 10);
+
+    // Same NRPN again: data entry only
+    TEST_ASSERT_EQUAL_size_t(1, encoder.encode(param, 0, 11, START_NS + 10 * MS, out));
+    assertCC(out[0], 0, 6, 11);
+
+    // The selection is re-sent once it is SELECT_REFRESH_NS old, and after reset()
+    uint64_t refresh_ns = START_NS + ParameterMidiEncoder::SELECT_REFRESH_NS;
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(param, 0, 12, refresh_ns, out));
+    encoder.reset();
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(param, 0, 13, refresh_ns + MS, out));
+
+    // Selections are per channel
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(param, 1, 14, refresh_ns + MS, out));
+}
+
+void test_encoder_sends_14_bit_nrpn_with_data_entry_lsb() {
+    Parameter param(makeDefinition(SynthDefinitionReader::NO_CC, 301, true));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    TEST_ASSERT_EQUAL_size_t(4, encoder.encode(param, 0, (100 << 7) | 7, START_NS, out));
+    assertCC(out[2], 0, 6, 100);
+    assertCC(out[3], 0, 38, 7);
+}
+
+void test_encoder_deselects_nrpn_before_plain_data_entry_cc() {
+    Parameter nrpn(makeDefinition(SynthDefinitionReader::NO_CC, 300));
+    Parameter data_entry(makeDefinition(6));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    encoder.encode(nrpn, 0, 10, START_NS, out);
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(data_entry, 0, 20, START_NS, out));
+    assertCC(out[0], 0, 101, 127);
+    assertCC(out[1], 0, 100, 127);
+    assertCC(out[2], 0, 6, 20);
+
+    // And the NRPN has to be selected again
+    TEST_ASSERT_EQUAL_size_t(3, encoder.encode(nrpn, 0, 11, START_NS, out));
+}
+
+void test_encoder_sends_nothing_without_address() {
+    Parameter param(makeDefinition(SynthDefinitionReader::NO_CC));
+    ParameterMidiEncoder encoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    TEST_ASSERT_EQUAL_size_t(0, encoder.encode(param, 0, 64, START_NS, out));
+}
+
+void test_decoder_round_trips_encoder_output() {
+    ParameterBinder binder;
+    TEST_ASSERT_TRUE(binder.loadSynthDefinitionFromJson(CODEC_SYNTH));
+    ParameterMidiEncoder encoder;
+    ParameterMidiDecoder decoder;
+    MidiEvent out[ParameterMidiEncoder::MAX_EVENTS];
+
+    const char* names[] = {"Codec Cutoff", "Codec Fine", "Codec Wave", "Codec Mix"};
+    const uint16_t values[] = {99, 12345, 77, 9876};
+    for (size_t i = 0; i < 4; ++i) {
+        auto param = binder.findParameterByName(names[i]);
+        TEST_ASSERT_NOT_NULL(param.get());
+
+        size_t count = encoder.encode(*param, 0, values[i], START_NS, out);
+        Parameter* decoded = nullptr;
+        uint16_t value = 0;
+        for (size_t e = 0; e < count; ++e) {
+            uint16_t event_value = 0;
+            Parameter* p = decoder.decode(binder, 0, out[e].data1(), out[e].data2(), event_value);
+            if (p) {
+                decoded = p;
+                value = event_value;
+            }
+        }
+        TEST_ASSERT_EQUAL_PTR(param.get(), decoded);
+        TEST_ASSERT_EQUAL_UINT16(values[i], value);
+    }
+}
+
+void test_decoder_applies_msb_before_lsb_arrives() {
+    ParameterBinder binder;
+    TEST_ASSERT_TRUE(binder.loadSynthDefinitionFromJson(CODEC_SYNTH));
+    ParameterMidiDecoder decoder;
+    uint16_t value = 0;
+
+    Parameter* fine = decoder.decode(binder, 0, 1, 64, value);
+    TEST_ASSERT_NOT_NULL(fine);
+    TEST_ASSERT_EQUAL_UINT16(64 << 7, value);
+    TEST_ASSERT_EQUAL_PTR(fine, decoder.decode(binder, 0, 33, 3, value));
+    TEST_ASSERT_EQUAL_UINT16((64 << 7) | 3, value);
+
+    // Data entry without a selected NRPN is a plain CC 6, which nothing uses
+    TEST_ASSERT_NULL(decoder.decode(binder, 0, 6, 10, value));
+    // An RPN select clears the NRPN selection
+    decoder.decode(binder, 0, 99, 300 >> 7, value);
+    decoder.decode(binder, 0, 98, 300 & 0x7F, value);
+    TEST_ASSERT_NOT_NULL(decoder.decode(binder, 0, 6, 10, value));
+    decoder.decode(binder, 0, 101, 0, value);
+    TEST_ASSERT_NULL(decoder.decode(binder, 0, 6, 10, value));
+}
+
+}  // namespace
+
+void run_parameter_midi_codec_tests() {
+    RUN_TEST(test_encoder_sends_7_bit_cc);
+    RUN_TEST(test_encoder_sends_14_bit_cc_as_msb_then_lsb);
+    RUN_TEST(test_encoder_selects_nrpn_once_and_refreshes);
+    RUN_TEST(test_encoder_sends_14_bit_nrpn_with_data_entry_lsb);
+    RUN_TEST(test_encoder_deselects_nrpn_before_plain_data_entry_cc);
+    RUN_TEST(test_encoder_sends_nothing_without_address);
+    RUN_TEST(test_decoder_round_trips_encoder_output);
+    RUN_TEST(test_decoder_applies_msb_before_lsb_arrives);
+}
@@ -0,0 +1,128 @@
+#include <unity.h>
+#include "components/parameter/Parameter.h"
+#include <memory>
+
+namespace {
+
+ParameterStore::Definition makeDefinition(const char* name, uint8_t cc) {
+    ParameterStore::Definition definition;
+    definition.name = name;
+    definition.short_name = name;
+    definition.description = "Store test parameter";
+    definition.cc_number = cc;
+    definition.default_value = 10;
+    return definition;
+}
+
+struct CountingObserver : ParameterObserver {
+    int calls = 0;
+    uint16_t last_value = 0;
+
+    void onParameterChanged(const Parameter& parameter) override {
+        calls++;
+        last_value = parameter.getCurrentValue();
+    }
+};
+
+void test_store_keeps_definition_fields() {
+    ParameterStore& store = ParameterStore::getInstance();
+    ParameterStore::Definition definition = makeDefinition("Store Cutoff", 74);
+    definition.min_value = 5;
+    definition.max_value = 100;
+    definition.nrpn_number = 300;
+    definition.midi_channel = 3;
+    definition.bipolar = true;
+
+    Parameter param(definition);
+    ParameterStore::Handle handle = param.getHandle();
+    TEST_ASSERT_TRUE(store.isValid(handle));
+    TEST_ASSERT_EQUAL_STRING("Store Cutoff", store.getName(handle).c_str());
+    TEST_ASSERT_EQUAL_UINT8(74, store.getCCNumber(handle));
+    TEST_ASSERT_EQUAL_UINT16(5, store.getMinValue(handle));
+    TEST_ASSERT_EQUAL_UINT16(100, store.getMaxValue(handle));
+    TEST_ASSERT_EQUAL_UINT16(10, store.getValue(handle));   // Starts at its default
+    TEST_ASSERT_EQUAL_UINT16(300, store.getNRPNNumber(handle));
+    TEST_ASSERT_EQUAL_UINT8(3, store.getMidiChannel(handle));
+    TEST_ASSERT_TRUE(store.isBipolar(handle));
+    TEST_ASSERT_FALSE(store.isHighResolution(handle));
+    TEST_ASSERT_EQUAL_PTR(&param, store.getOwner(handle));
+}
+
+void test_store_interns_repeated_strings() {
+    ParameterStore& store = ParameterStore::getInstance();
+    auto first = std::make_unique<Parameter>(makeDefinition("Store Intern A", 1));
+    size_t strings = store.getInternedStringCount();
+
+    // Only the new name is added; the description is shared
+    auto second = std::make_unique<Parameter>(makeDefinition("Store Intern B", 2));
+    TEST_ASSERT_EQUAL_size_t(strings + 1, store.getInternedStringCount());
+    auto third = std::make_unique<Parameter>(makeDefinition("Store Intern B", 3));
+    TEST_ASSERT_EQUAL_size_t(strings + 1, store.getInternedStringCount());
+}
+
+void test_store_invalidates_handle_of_destroyed_parameter() {
+    ParameterStore& store = ParameterStore::getInstance();
+    auto param = std::make_unique<Parameter>(makeDefinition("Store Stale", 5));
+    ParameterStore::Handle stale = param->getHandle();
+    param.reset();
+    TEST_ASSERT_FALSE(store.isValid(stale));
+
+    // The slot is reused under a new generation
+    Parameter reused(makeDefinition("Store Reused", 6));
+    TEST_ASSERT_EQUAL_UINT32(stale.index(), reused.getHandle().index());
+    TEST_ASSERT_TRUE(reused.getHandle() != stale);
+    TEST_ASSERT_FALSE(store.isValid(stale));
+}
+
+void test_store_coalesces_notifications_until_flush() {
+    ParameterStore& store = ParameterStore::getInstance();
+    store.flushNotifications();
+    Parameter param(makeDefinition("Store Notify", 7));
+    CountingObserver observer;
+    param.addObserver(&observer);
+
+    for (uint16_t value = 20; value < 70; ++value) {
+        param.setValueDirect(value);
+    }
+    TEST_ASSERT_EQUAL(0, observer.calls);
+
+    TEST_ASSERT_EQUAL_size_t(1, store.flushNotifications());
+    TEST_ASSERT_EQUAL(1, observer.calls);
+    TEST_ASSERT_EQUAL_UINT16(69, observer.last_value);
+    TEST_ASSERT_EQUAL_size_t(0, store.flushNotifications());
+}
+
+void test_store_snapshot_and_recall() {
+    ParameterStore& store = ParameterStore::getInstance();
+    Parameter a(makeDefinition("Store Recall A", 8));
+    auto b = std::make_unique<Parameter>(makeDefinition("Store Recall B", 9));
+    a.setValueDirect(30);
+    b->setValueDirect(40);
+    store.flushNotifications();
+
+    ParameterStore::Snapshot saved = store.snapshot();
+    a.setValueDirect(31);
+    b.reset();   // Its slot is taken by a new parameter before the recall
+    Parameter c(makeDefinition("Store Recall C", 10));
+    c.setValueDirect(50);
+    store.flushNotifications();
+
+    CountingObserver observer;
+    a.addObserver(&observer);
+    TEST_ASSERT_EQUAL_size_t(1, store.recall(saved));
+    TEST_ASSERT_EQUAL_UINT16(30, a.getCurrentValue());
+    TEST_ASSERT_EQUAL_UINT16(50, c.getCurrentValue());   // Not B's old value
+
+    store.flushNotifications();
+    TEST_ASSERT_EQUAL(1, observer.calls);
+}
+
+}  // namespace
+
+void run_parameter_store_tests() {
+    RUN_TEST(test_store_keeps_definition_fields);
+    RUN_TEST(test_store_interns_repeated_strings);
+    RUN_TEST(test_store_invalidates_handle_of_destroyed_parameter);
+    RUN_TEST(test_store_coalesces_notifications_until_flush);
+    RUN_TEST(test_store_snapshot_and_recall);
+}
@@ -0,0 +1,104 @@
+#include <unity.h>
+#include "components/midi/SpscRing.h"
+#include <thread>
+
+namespace {
+
+void test_spsc_ring_pops_in_push_order() {
+    SpscRing<int, 8> ring;
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_EQUAL_size_t(5, ring.size());
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_FALSE(ring.pop(value));
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_spsc_ring_rejects_push_when_full() {
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_FALSE(ring.push(99));
+    TEST_ASSERT_EQUAL_size_t(4, ring.size());
+
+    // The rejected item left the contents alone
+    int value = -1;
+    TEST_ASSERT_TRUE(ring.pop(value));
+    TEST_ASSERT_EQUAL(0, value);
+    TEST_ASSERT_TRUE(ring.push(4));
+}
+
+void test_spsc_ring_front_peeks_without_removing() {
+    SpscRing<int, 4> ring;
+    TEST_ASSERT_NULL(ring.front());
+
+    ring.push(7);
+    ring.push(8);
+    TEST_ASSERT_NOT_NULL(ring.front());
+    TEST_ASSERT_EQUAL(7, *ring.front());
+    TEST_ASSERT_EQUAL_size_t(2, ring.size());
+
+    int value = 0;
+    ring.pop(value);
+    TEST_ASSERT_EQUAL(8, *ring.front());
+}
+
+void test_spsc_ring_wraps_around() {
+    SpscRing<int, 4> ring;
+    int value = 0;
+    for (int i = 0; i < 1000; ++i) {
+        TEST_ASSERT_TRUE(ring.push(i));
+        TEST_ASSERT_TRUE(ring.push(i + 1));
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+        TEST_ASSERT_TRUE(ring.pop(value));
+        TEST_ASSERT_EQUAL(i + 1, value);
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+void test_spsc_ring_keeps_order_across_threads() {
+    constexpr int COUNT = 200000;
+    SpscRing<int, 64> ring;
+
+    std::thread producer([&ring] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!ring.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    while (expected < COUNT) {
+        int value;
+        if (ring.pop(value)) {
+            in_order &= value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(in_order);
+    TEST_ASSERT_TRUE(ring.empty());
+}
+
+}  // namespace
+
+void run_spsc_ring_tests() {
+    RUN_TEST(test_spsc_ring_pops_in_push_order);
+    RUN_TEST(test_spsc_ring_rejects_push_when_full);
+    RUN_TEST(test_spsc_ring_front_peeks_without_removing);
+    RUN_TEST(test_spsc_ring_wraps_around);
+    RUN_TEST(test_spsc_ring_keeps_order_across_threads);
+}
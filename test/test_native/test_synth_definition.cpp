@@ -0,0 +1,190 @@
+#include <unity.h>
+#include "components/parameter/ParameterBinder.h"
+#include "components/parameter/SynthDefinitionBlob.h"
+#include "components/parameter/SynthDefinitionReader.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// What the reader passed on; its views die with the callback
+struct ReadParameter {
+    std::string name;
+    std::string short_name;
+    ParameterStore::Definition definition;
+};
+
+const char* const DEFINITION = R"({
+  "categories": {
+    "Filters": {
+      "description": "Skipped",
+      "parameters": {
+        "Filter_Cutoff": {"cc": 74, "min": 0, "max": 127, "default": 100, "unknown": [1, {"x": 2}]},
+        "Filter_Env": {"cc": 300, "name": "Env Amount", "short_name": "Env", "bipolar": true},
+        "Filter_Mix": {"nrpn": 301, "min": 20000, "max": 5, "default": 1, "high_resolution": true},
+        "Filter_Nothing": {"name": "No Address"}
+      }
+    }
+  },
+  "name": "Reader Synth",
+  "manufacturer": "Tests",
+  "midi_channel": 3
+})";
+
+void test_reader_reads_header_and_parameters() {
+    std::vector<ReadParameter> read;
+    SynthDefinitionReader reader([&read](const ParameterStore::Definition& definition) {
+        read.push_back({std::string(definition.name), std::string(definition.short_name), definition});
+    });
+    TEST_ASSERT_TRUE(reader.parse(DEFINITION));
+
+    // Header fields after "categories" are still read
+    TEST_ASSERT_EQUAL_STRING("Reader Synth", reader.getHeader().name.c_str());
+    TEST_ASSERT_EQUAL_STRING("Tests", reader.getHeader().manufacturer.c_str());
+    TEST_ASSERT_EQUAL_UINT8(3, reader.getHeader().midi_channel);
+    TEST_ASSERT_EQUAL_size_t(3, reader.getParameterCount());
+    TEST_ASSERT_EQUAL_size_t(3, read.size());
+
+    // Name from the key, short name from the name; unknown keys skipped
+    TEST_ASSERT_EQUAL_STRING("Filter Cutoff", read[0].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("Filter Cutoff", read[0].short_name.c_str());
+    TEST_ASSERT_EQUAL_UINT8(74, read[0].definition.cc_number);
+    TEST_ASSERT_EQUAL_UINT16(100, read[0].definition.default_value);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ParameterCategory::FILTERS), read[0].definition.category);
+
+    TEST_ASSERT_EQUAL_STRING("Env Amount", read[1].name.c_str());
+    TEST_ASSERT_EQUAL_STRING("Env", read[1].short_name.c_str());
+    TEST_ASSERT_EQUAL_UINT8(127, read[1].definition.cc_number);   // Clamped
+    TEST_ASSERT_TRUE(read[1].definition.bipolar);
+}
+
+void test_reader_clamps_and_orders_range() {
+    std::vector<ParameterStore::Definition> read;
+    SynthDefinitionReader reader([&read](const ParameterStore::Definition& definition) {
+        read.push_back(definition);
+    });
+    TEST_ASSERT_TRUE(reader.parse(DEFINITION));
+
+    const ParameterStore::Definition& mix = read[2];
+    TEST_ASSERT_EQUAL_UINT8(SynthDefinitionReader::NO_CC, mix.cc_number);
+    TEST_ASSERT_EQUAL_UINT16(301, mix.nrpn_number);
+    TEST_ASSERT_EQUAL_UINT16(5, mix.min_value);        // Swapped
+    TEST_ASSERT_EQUAL_UINT16(16383, mix.max_value);    // Clamped to 14 bits
+    TEST_ASSERT_EQUAL_UINT16(5, mix.default_value);    // Into the range
+    TEST_ASSERT_TRUE(mix.high_resolution);
+}
+
+void test_reader_skips_parameter_without_address() {
+    size_t calls = 0;
+    SynthDefinitionReader reader([&calls](const ParameterStore::Definition&) { calls++; });
+    TEST_ASSERT_TRUE(reader.parse(DEFINITION));
+    TEST_ASSERT_EQUAL_size_t(3, calls);
+    TEST_ASSERT_EQUAL_size_t(1, reader.getSkippedCount());
+}
+
+void test_reader_reports_malformed_definition() {
+    SynthDefinitionReader truncated([](const ParameterStore::Definition&) {});
+    TEST_ASSERT_FALSE(truncated.parse("{\"categories\": {\"Filters\": {\"parameters\": {"));
+    TEST_ASSERT_NOT_NULL(truncated.getError());
+
+    SynthDefinitionReader not_object([](const ParameterStore::Definition&) {});
+    TEST_ASSERT_FALSE(not_object.parse("[1, 2]"));
+    TEST_ASSERT_NOT_NULL(not_object.getError());
+}
+
+std::vector<uint8_t> makeBlob() {
+    SynthDefinitionBlob::Builder builder;
+    builder.addSynth("first", "First Synth", "Tests", "One parameter");
+    ParameterStore::Definition definition;
+    definition.name = "Blob Cutoff";
+    definition.short_name = "Cutoff";
+    definition.cc_number = 74;
+    builder.addParameter(definition);
+
+    builder.addSynth("second", "Second Synth", "Tests", "Two parameters", 2);
+    definition.name = "Blob Mix";
+    definition.short_name = "Mix";
+    definition.cc_number = SynthDefinitionReader::NO_CC;
+    definition.nrpn_number = 301;
+    definition.max_value = 16383;
+    definition.default_value = 8000;
+    definition.high_resolution = true;
+    definition.bipolar = true;
+    builder.addParameter(definition);
+    definition.name = "Blob Cutoff";   // Shared string
+    builder.addParameter(definition);
+    return builder.build();
+}
+
+void test_blob_round_trips_builder_output() {
+    std::vector<uint8_t> data = makeBlob();
+    SynthDefinitionBlob blob;
+    TEST_ASSERT_TRUE(blob.open(data.data(), data.size()));
+    TEST_ASSERT_EQUAL_size_t(2, blob.getSynthCount());
+
+    SynthDefinitionBlob::Synth synth;
+    TEST_ASSERT_FALSE(blob.findSynth("missing", synth));
+    TEST_ASSERT_TRUE(blob.findSynth("second", synth));
+    TEST_ASSERT_TRUE(synth.name == "Second Synth");
+    TEST_ASSERT_EQUAL_UINT8(2, synth.midi_channel);
+    TEST_ASSERT_EQUAL_UINT32(1, synth.first_parameter);
+    TEST_ASSERT_EQUAL_UINT32(2, synth.parameter_count);
+
+    ParameterStore::Definition mix = blob.getParameter(synth.first_parameter);
+    TEST_ASSERT_TRUE(mix.name == "Blob Mix");
+    TEST_ASSERT_TRUE(mix.short_name == "Mix");
+    TEST_ASSERT_EQUAL_UINT8(SynthDefinitionReader::NO_CC, mix.cc_number);
+    TEST_ASSERT_EQUAL_UINT16(301, mix.nrpn_number);
+    TEST_ASSERT_EQUAL_UINT16(16383, mix.max_value);
+    TEST_ASSERT_EQUAL_UINT16(8000, mix.default_value);
+    TEST_ASSERT_TRUE(mix.high_resolution);
+    TEST_ASSERT_TRUE(mix.bipolar);
+}
+
+void test_blob_rejects_bad_data() {
+    std::vector<uint8_t> data = makeBlob();
+    SynthDefinitionBlob blob;
+
+    TEST_ASSERT_FALSE(blob.open(data.data(), 8));
+
+    std::vector<uint8_t> wrong_magic = data;
+    wrong_magic[0] ^= 0xFF;
+    TEST_ASSERT_FALSE(blob.open(wrong_magic.data(), wrong_magic.size()));
+
+    std::vector<uint8_t> unterminated = data;
+    unterminated.back() = 'x';
+    TEST_ASSERT_FALSE(blob.open(unterminated.data(), unterminated.size()));
+    TEST_ASSERT_FALSE(blob.isOpen());
+}
+
+void test_binder_loads_blob_and_json_alike() {
+    std::vector<uint8_t> data = makeBlob();
+    SynthDefinitionBlob blob;
+    TEST_ASSERT_TRUE(blob.open(data.data(), data.size()));
+
+    ParameterBinder binder;
+    TEST_ASSERT_TRUE(binder.loadSynthDefinitionFromBlob(blob, "first"));
+    TEST_ASSERT_EQUAL_size_t(1, binder.getParameterCount());
+    TEST_ASSERT_NOT_NULL(binder.dispatchCC(0, 74));
+    TEST_ASSERT_FALSE(binder.loadSynthDefinitionFromBlob(blob, "missing"));
+
+    TEST_ASSERT_TRUE(binder.loadSynthDefinitionFromJson(DEFINITION));
+    TEST_ASSERT_EQUAL_size_t(3, binder.getParameterCount());
+    TEST_ASSERT_EQUAL_STRING("Reader Synth", binder.getCurrentSynthName().c_str());
+    // Channel 3 from the header: dispatch on channel index 2 only
+    TEST_ASSERT_NOT_NULL(binder.dispatchCC(2, 74));
+    TEST_ASSERT_NULL(binder.dispatchCC(0, 74));
+    TEST_ASSERT_NOT_NULL(binder.dispatchNRPN(2, 301));
+}
+
+}  // namespace
+
+void run_synth_definition_tests() {
+    RUN_TEST(test_reader_reads_header_and_parameters);
+    RUN_TEST(test_reader_clamps_and_orders_range);
+    RUN_TEST(test_reader_skips_parameter_without_address);
+    RUN_TEST(test_reader_reports_malformed_definition);
+    RUN_TEST(test_blob_round_trips_builder_output);
+    RUN_TEST(test_blob_rejects_bad_data);
+    RUN_TEST(test_binder_loads_blob_and_json_alike);
+}